@@ -4,6 +4,7 @@
 
 #include "dbuscontrolcenterservice.h"
 #include "window/mainwindow.h"
+#include "window/tracer.h"
 
 #include "modules/display/displaymodel.h"
 #include "modules/display/displayworker.h"
@@ -166,6 +167,12 @@ bool DBusControlCenterService::isModuleAvailable(const QString &m)
     return parent()->isModuleAvailable(m);
 }
 
+// 导出启动耗时追踪数据(Chrome trace JSON)
+QString DBusControlCenterService::ExportTrace()
+{
+    return QString::fromUtf8(Tracer::instance()->toChromeTrace());
+}
+
 
 DBusControlCenterGrandSearchService::DBusControlCenterGrandSearchService(MainWindow *parent)
     : QDBusAbstractAdaptor(parent)
@@ -187,12 +194,13 @@ DBusControlCenterGrandSearchService::~DBusControlCenterGrandSearchService()
 
 }
 
-//匹配搜索结果
-QString DBusControlCenterGrandSearchService::Search(const QString json)
+//匹配搜索结果，使用延迟应答，结果由后台线程搜索完成后返回
+QString DBusControlCenterGrandSearchService::Search(const QString json, const QDBusMessage &message)
 {
-    QString val = parent()->GrandSearchSearch(json);
+    message.setDelayedReply(true);
+    parent()->GrandSearchSearch(json, message);
     m_autoExitTimer->start();
-    return val;
+    return QString();
 }
 
 //停止搜索
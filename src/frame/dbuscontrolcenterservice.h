@@ -58,6 +58,7 @@ public Q_SLOTS: // METHODS
     void ToggleInLeft();
     bool isNetworkCanShowPassword();
     bool isModuleAvailable(const QString &m);
+    QString ExportTrace();
 
 Q_SIGNALS: // SIGNALS
     void rectChanged(const QRect &rect);
@@ -79,7 +80,7 @@ public:
     inline DCC_NAMESPACE::MainWindow *parent() const;
 
 public Q_SLOTS: // METHODS
-    QString Search(const QString json);
+    QString Search(const QString json, const QDBusMessage &message);
     bool Stop(const QString json);
     bool Action(const QString json);
 
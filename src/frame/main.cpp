@@ -5,6 +5,7 @@
 #include "dbuscontrolcenterservice.h"
 #include "window/mainwindow.h"
 #include "window/accessible.h"
+#include "window/tracer.h"
 
 #include <DApplication>
 #include <DDBusSender>
@@ -18,6 +19,7 @@ DCORE_USE_NAMESPACE
 
 int main(int argc, char *argv[])
 {
+    const qint64 mainBegin = Tracer::now();
     DApplication *app = DApplication::globalApplication(argc, argv);
     app->setOrganizationName("deepin");
     app->setApplicationName("dde-control-center");
@@ -151,5 +153,10 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    Tracer::instance()->addSpan("main", QString(), mainBegin, Tracer::now());
+    QObject::connect(app, &QCoreApplication::aboutToQuit, [] {
+        Tracer::instance()->writeTraceFile();
+    });
+
     return app->exec();
 }
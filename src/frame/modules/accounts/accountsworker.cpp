@@ -5,6 +5,7 @@
 #include "accountsworker.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
+#include "window/dbuspropertybatch.h"
 
 #include <QFileDialog>
 #include <QtConcurrent>
@@ -28,6 +29,11 @@ using namespace DCC_NAMESPACE;
 const QString AccountsService("com.deepin.daemon.Accounts");
 const QString FingerPrintService("com.deepin.daemon.Authenticate");
 const QString DisplayManagerService("org.freedesktop.DisplayManager");
+const QString AccountsUserInterface("com.deepin.daemon.Accounts.User");
+
+const int FirstUserPageSize = 51;   // 第一次打开用户列表加载的用户数
+const int UserPageSize = 20;        // 滚动条每滑动一次加载的用户数
+const int MaxUserInters = 8;        // 同时保留的用户 DBus 代理数
 
 const QString AutoLoginVisable = "auto-login-visable";
 const QString NoPasswordVisable = "nopasswd-login-visable";
@@ -45,6 +51,7 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
 #ifdef DCC_ENABLE_ADDOMAIN
     , m_notifyInter(new Notifications("org.freedesktop.Notifications", "/org/freedesktop/Notifications", QDBusConnection::sessionBus(), this))
 #endif
+    , m_pager(MaxUserInters)
     , m_dmInter(new DisplayManager(DisplayManagerService, "/org/freedesktop/DisplayManager", QDBusConnection::systemBus(), this))
     , m_userModel(userList)
     , m_login1SessionSelf(nullptr)
@@ -63,6 +70,10 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
 
     connect(m_dmInter, &DisplayManager::SessionsChanged, this, &AccountsWorker::updateUserOnlineStatus);
 
+    // 所有用户的属性变化通过一个连接接收，不需要为每个用户创建代理
+    QDBusConnection::systemBus().connect(AccountsService, QString(), "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                         this, SLOT(onUserPropertiesChanged(QDBusMessage)));
+
     m_accountsInter->setSync(false);
     m_dmInter->setSync(false);
 #ifdef DCC_ENABLE_ADDOMAIN
@@ -190,7 +201,7 @@ void AccountsWorker::localBindCheck(dcc::accounts::User *user, const QString &uo
 void AccountsWorker::startResetPasswordExec(User *user)
 {
     qDebug() << "Begin Resetpassword";
-    AccountsUser *userInter = m_userInters.value(user);
+    AccountsUser *userInter = this->userInter(user);
     auto reply = userInter->SetPassword("");
     reply.waitForFinished();
     Q_EMIT user->startResetPasswordReplied(reply.error().message());
@@ -248,7 +259,7 @@ void AccountsWorker::getLogin1SessionSelf()
 
 void AccountsWorker::setPasswordHint(User *user, const QString &passwordHint)
 {
-    AccountsUser *userInter = m_userInters.value(user);
+    AccountsUser *userInter = this->userInter(user);
     Q_ASSERT(userInter);
 
     userInter->SetPasswordHint(passwordHint);
@@ -314,7 +325,7 @@ SecurityLever AccountsWorker::getSecUserLeverbyname(QString userName)
 
 void AccountsWorker::setGroups(User *user, const QStringList &usrGroups)
 {
-    AccountsUser *userInter = m_userInters[user];
+    AccountsUser *userInter = this->userInter(user);
     Q_ASSERT(userInter);
 
     userInter->SetGroups(usrGroups);
@@ -322,16 +333,8 @@ void AccountsWorker::setGroups(User *user, const QStringList &usrGroups)
 
 void AccountsWorker::active()
 {
-    for (auto it(m_userInters.cbegin()); it != m_userInters.cend(); ++it) {
-        it.key()->setName(it.value()->property("UserName").toString());
-        it.key()->setAutoLogin(it.value()->automaticLogin());
-        it.key()->setUserType(it.value()->accountType());
-        it.key()->setAvatars(it.value()->iconList());
-        it.key()->setGroups(it.value()->groups());
-        it.key()->setCurrentAvatar(it.value()->iconFile());
-        it.key()->setCreatedTime(it.value()->createdTime());
-        it.key()->setGid(it.value()->gid());
-    }
+    // 只刷新列表中可见和最近操作过的用户，已加载的用户很多时不会一次发出大量请求
+    fetchUserProperties(m_pager.activePaths());
 }
 
 QString AccountsWorker::getCurrentUserName()
@@ -415,7 +418,7 @@ void AccountsWorker::updateGroupinfo()
 void AccountsWorker::setAvatar(User *user, const QString &iconPath)
 {
     qDebug() << "set account avatar";
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     ui->SetIconFile(iconPath);
@@ -424,7 +427,7 @@ void AccountsWorker::setAvatar(User *user, const QString &iconPath)
 void AccountsWorker::setFullname(User *user, const QString &fullname)
 {
     qDebug() << Q_FUNC_INFO << fullname;
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     Q_EMIT requestFrameAutoHide(false);
@@ -452,12 +455,12 @@ void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
             qDebug() << Q_FUNC_INFO << call->error().message();
             Q_EMIT m_userModel->isCancelChanged();
         } else {
-            if (!m_userInters.contains(user)) {
+            if (!m_userPaths.contains(user)) {
                 call->deleteLater();
                 return;
             }
             Q_EMIT m_userModel->deleteUserSuccess();
-            removeUser(m_userInters.value(user)->path());
+            removeUser(m_userPaths.value(user));
             getAllGroups();
 
             QDBusPendingReply<> listFingersReply = m_fingerPrint->ListFingers(user->name());
@@ -481,7 +484,7 @@ void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
 
 void AccountsWorker::setAutoLogin(User *user, const bool autoLogin)
 {
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     // because this operate need root permission, we must wait for finished and refersh result
@@ -502,13 +505,13 @@ void AccountsWorker::setAutoLogin(User *user, const bool autoLogin)
 //切换账户权限
 void AccountsWorker::setAdministrator(User *user, const bool asAdministrator)
 {
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     // because this operate need root permission, we must wait for finished and refersh result
     Q_EMIT requestMainWindowEnabled(false);
 
-    QStringList lstGroups = ui->groups();
+    QStringList lstGroups = user->groups();
     if(!asAdministrator)
         lstGroups.removeOne("sudo");
     else
@@ -527,25 +530,25 @@ void AccountsWorker::setAdministrator(User *user, const bool asAdministrator)
 
 void AccountsWorker::loadUserList()
 {
-    onUserListChanged(m_accountsInter->userList());
+    loadUserPage(UserPageSize);
 }
 
 void AccountsWorker::onUserListChanged(const QStringList &userList)
 {
-    int count = 0;
-    static bool first = true;
+    QStringList pendingPaths;
     for (const QString &path : userList) {
-        if (!m_userModel->contains(path)) {
-            count++;
-            addUser(path);
-            if (count > 50 && first) {
-                first = false;
-                break; // 第一次打开用户列表只加载51个用户信息
-            } else if (count > 2 && !first) {
-                break; // 滚动条每滑动一次，加载3个用户
-            }
-        }
+        if (!m_userModel->contains(path))
+            pendingPaths << path;
     }
+    m_pager.setPendingPaths(pendingPaths);
+
+    // 第一次打开用户列表只加载一页，其余用户在滚动时加载
+    loadUserPage(FirstUserPageSize - m_userPaths.size());
+}
+
+void AccountsWorker::loadUserPage(int count)
+{
+    loadUsers(m_pager.takePage(count));
 }
 
 void AccountsWorker::setPassword(User *user, const QString &oldpwd, const QString &passwd, const QString &repeatPasswd, const bool needResult)
@@ -576,7 +579,7 @@ void AccountsWorker::setPassword(User *user, const QString &oldpwd, const QStrin
 
 void AccountsWorker::resetPassword(User *user, const QString &password)
 {
-    auto reply = m_userInters.value(user)->SetPassword(cryptUserPassword(password));
+    auto reply = userInter(user)->SetPassword(cryptUserPassword(password));
     reply.waitForFinished();
 
     Q_EMIT user->passwordResetFinished(reply.error().message());
@@ -584,7 +587,7 @@ void AccountsWorker::resetPassword(User *user, const QString &password)
 
 void AccountsWorker::deleteUserIcon(User *user, const QString &iconPath)
 {
-    AccountsUser *userInter = m_userInters[user];
+    AccountsUser *userInter = this->userInter(user);
     Q_ASSERT(userInter);
 
     userInter->DeleteIconFile(iconPath);
@@ -592,14 +595,57 @@ void AccountsWorker::deleteUserIcon(User *user, const QString &iconPath)
 
 void AccountsWorker::addUser(const QString &userPath)
 {
-    if (userPath.contains("User0", Qt::CaseInsensitive) || m_userModel->contains(userPath))
+    m_pager.takePath(userPath);
+    loadUsers({userPath});
+}
+
+void AccountsWorker::loadUsers(const QStringList &userPaths)
+{
+    QStringList paths;
+    for (const QString &userPath : userPaths) {
+        if (userPath.contains("User0", Qt::CaseInsensitive) || m_userModel->contains(userPath))
+            continue;
+
+        // 属性返回后再赋值，变化信号只在数据正常后产生一次，不会干扰管理员数量的计算
+        User *user = new User(this);
+        m_userPaths[user] = userPath;
+        m_userModel->addUser(userPath, user);
+        paths << userPath;
+    }
+
+    fetchUserProperties(paths);
+}
+
+void AccountsWorker::fetchUserProperties(const QStringList &userPaths)
+{
+    if (userPaths.isEmpty())
         return;
-    AccountsUser *userInter = new AccountsUser(AccountsService, userPath, QDBusConnection::systemBus(), this);
-    userInter->setSync(false);
 
-    User *user = new User(this);
+    // 每个用户一次 GetAll，所有请求同时发出，全部返回后一起更新
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    for (const QString &userPath : userPaths)
+        batch->addInterface(userPath, QDBusConnection::systemBus(), AccountsService, userPath, AccountsUserInterface);
+
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        for (const QString &userPath : userPaths) {
+            User *user = m_userModel->getUser(userPath);
+            if (!user)
+                continue;
+
+            if (batch->hasError(userPath))
+                qWarning() << "get user properties failed:" << userPath << batch->error(userPath).message();
+            else
+                updateUserProperties(user, batch->properties(userPath));
+        }
+        batch->deleteLater();
+    });
+    batch->start();
+}
 
-    connect(userInter, &AccountsUser::UserNameChanged, user, [=](const QString &name) {
+void AccountsWorker::updateUserProperties(User *user, const QVariantMap &properties)
+{
+    const QString name = properties.value("UserName", user->name()).toString();
+    if (name != user->name()) {
         user->setName(name);
         user->setSecurityLever(getSecUserLeverbyname(name));
         user->setOnline(m_onlineUsers.contains(name));
@@ -607,59 +653,98 @@ void AccountsWorker::addUser(const QString &userPath)
 #ifdef DCC_ENABLE_ADDOMAIN
         checkADUser();
 #endif
-    });
+    }
 
-    connect(userInter, &AccountsUser::AutomaticLoginChanged, user, &User::setAutoLogin);
-    connect(userInter, &AccountsUser::IconListChanged, user, &User::setAvatars);
-    connect(userInter, &AccountsUser::IconFileChanged, user, &User::setCurrentAvatar);
-    connect(userInter, &AccountsUser::FullNameChanged, user, &User::setFullname);
-    connect(userInter, &AccountsUser::NoPasswdLoginChanged, user, &User::setNopasswdLogin);
-    connect(userInter, &AccountsUser::PasswordStatusChanged, user, &User::setPasswordStatus);
-    connect(userInter, &AccountsUser::CreatedTimeChanged, user, &User::setCreatedTime);
-    connect(userInter, &AccountsUser::GroupsChanged, user, &User::setGroups);
-    connect(userInter, &AccountsUser::AccountTypeChanged, user, &User::setUserType);
-    connect(userInter, &AccountsUser::MaxPasswordAgeChanged, user, &User::setPasswordAge);
-    connect(userInter, &AccountsUser::GidChanged, user, &User::setGid);
-
-    // 这里直接赋值的话, 由于请求是异步的, 所以一开始会被初始化成乱码,
-    // 然后数据正常了以后会额外产生一次变化信号
-    // 对于计算当前有多少个管理员有干扰.
-    userInter->userName();
-    userInter->fullName();
-    userInter->automaticLogin();
-    userInter->iconList();
-    userInter->groups();
-    userInter->iconFile();
-    userInter->noPasswdLogin();
-    userInter->passwordStatus();
-    userInter->createdTime();
-    userInter->accountType();
-    userInter->maxPasswordAge();
-    userInter->IsPasswordExpired();
-    userInter->gid();
-
-    m_userInters[user] = userInter;
-    m_userModel->addUser(userPath, user);
+    if (properties.contains("FullName"))
+        user->setFullname(properties.value("FullName").toString());
+    if (properties.contains("AutomaticLogin"))
+        user->setAutoLogin(properties.value("AutomaticLogin").toBool());
+    if (properties.contains("IconList"))
+        user->setAvatars(DBusPropertyBatch::value<QStringList>(properties, "IconList"));
+    if (properties.contains("Groups"))
+        user->setGroups(DBusPropertyBatch::value<QStringList>(properties, "Groups"));
+    if (properties.contains("IconFile"))
+        user->setCurrentAvatar(properties.value("IconFile").toString());
+    if (properties.contains("NoPasswdLogin"))
+        user->setNopasswdLogin(properties.value("NoPasswdLogin").toBool());
+    if (properties.contains("PasswordStatus"))
+        user->setPasswordStatus(properties.value("PasswordStatus").toString());
+    if (properties.contains("CreatedTime"))
+        user->setCreatedTime(properties.value("CreatedTime").toULongLong());
+    if (properties.contains("AccountType"))
+        user->setUserType(properties.value("AccountType").toInt());
+    if (properties.contains("MaxPasswordAge"))
+        user->setPasswordAge(properties.value("MaxPasswordAge").toInt());
+    if (properties.contains("Gid"))
+        user->setGid(properties.value("Gid").toString());
 }
 
-void AccountsWorker::removeUser(const QString &userPath)
+void AccountsWorker::onUserPropertiesChanged(const QDBusMessage &msg)
 {
-    for (AccountsUser *userInter : m_userInters.values()) {
-        if (userInter->path() == userPath) {
-            User *user = m_userInters.key(userInter);
-            user->deleteLater();
+    const QList<QVariant> arguments = msg.arguments();
+    if (arguments.count() != 3 || arguments.at(0).toString() != AccountsUserInterface)
+        return;
+
+    User *user = m_userModel->getUser(msg.path());
+    if (!user)
+        return;
 
-            m_userInters.remove(user);
-            m_userModel->removeUser(userPath);
+    updateUserProperties(user, qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>()));
+}
 
-            return;
-        }
+void AccountsWorker::setVisibleUsers(const QList<User *> &users)
+{
+    QStringList paths;
+    for (User *user : users) {
+        const QString &path = m_userPaths.value(user);
+        if (!path.isEmpty())
+            paths << path;
+    }
+
+    m_pager.setVisiblePaths(paths);
+}
+
+AccountsUser *AccountsWorker::userInter(User *user)
+{
+    AccountsUser *inter = m_userInters.value(user);
+    if (!inter) {
+        const QString userPath = m_userPaths.value(user);
+        if (userPath.isEmpty())
+            return nullptr;
+
+        inter = new AccountsUser(AccountsService, userPath, QDBusConnection::systemBus(), this);
+        inter->setSync(false);
+        m_userInters[user] = inter;
+    }
+
+    for (const QString &evictedPath : m_pager.touch(m_userPaths.value(user))) {
+        AccountsUser *oldInter = m_userInters.take(m_userModel->getUser(evictedPath));
+        if (oldInter)
+            oldInter->deleteLater();
     }
+
+    return inter;
+}
+
+void AccountsWorker::removeUser(const QString &userPath)
+{
+    m_pager.removePath(userPath);
+
+    User *user = m_userModel->getUser(userPath);
+    if (!user)
+        return;
+
+    m_userModel->removeUser(userPath);
+    m_userPaths.remove(user);
+    AccountsUser *userInter = m_userInters.take(user);
+    if (userInter)
+        userInter->deleteLater();
+    user->deleteLater();
 }
 
 void AccountsWorker::setNopasswdLogin(User *user, const bool nopasswdLogin)
 {
-    AccountsUser *userInter = m_userInters[user];
+    AccountsUser *userInter = this->userInter(user);
     Q_ASSERT(userInter);
 
     Q_EMIT requestFrameAutoHide(false);
@@ -678,7 +763,7 @@ void AccountsWorker::setNopasswdLogin(User *user, const bool nopasswdLogin)
 
 void AccountsWorker::setMaxPasswordAge(User *user, const int maxAge)
 {
-    AccountsUser *userInter = m_userInters[user];
+    AccountsUser *userInter = this->userInter(user);
     Q_ASSERT(userInter);
 
     QDBusPendingCall call = userInter->SetMaxPasswordAge(maxAge);
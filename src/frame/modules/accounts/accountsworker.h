@@ -6,6 +6,7 @@
 #define ACCOUNTSWORKER_H
 
 #include <QObject>
+#include <QHash>
 
 #include <com_deepin_daemon_accounts.h>
 #include <com_deepin_daemon_accounts_user.h>
@@ -19,6 +20,7 @@
 
 #include "usermodel.h"
 #include "creationresult.h"
+#include "userpager.h"
 
 using Accounts = com::deepin::daemon::Accounts;
 using AccountsUser = com::deepin::daemon::accounts::User;
@@ -98,6 +100,7 @@ public Q_SLOTS:
 #endif
     void addUser(const QString &userPath);
     void removeUser(const QString &userPath);
+    void setVisibleUsers(const QList<User *> &users);
     void setGroups(User *user, const QStringList &usrGroups);
     void setPasswordHint(User *user, const QString &passwordHint);
     void setSecurityQuestions(User *user, const QMap<int, QByteArray> &securityQuestions);
@@ -116,12 +119,17 @@ private Q_SLOTS:
     void getAllGroupsResult(QDBusPendingCallWatcher *watch);
     void getPresetGroups();
     void getPresetGroupsResult(QDBusPendingCallWatcher *watch);
+    void onUserPropertiesChanged(const QDBusMessage &msg);
 #ifdef DCC_ENABLE_ADDOMAIN
     void checkADUser();
 #endif
 
 private:
-    AccountsUser *userInter(const QString &userName) const;
+    AccountsUser *userInter(User *user);
+    void loadUserPage(int count);
+    void loadUsers(const QStringList &userPaths);
+    void fetchUserProperties(const QStringList &userPaths);
+    void updateUserProperties(User *user, const QVariantMap &properties);
     CreationResult *createAccountInternal(const User *user);
     BindCheckResult checkLocalBind(const QString &uosid, const QString &uuid);
     QList<int> securityQuestionsCheck();
@@ -135,7 +143,11 @@ private:
 #ifdef DCC_ENABLE_ADDOMAIN
     Notifications *m_notifyInter;
 #endif
+    // 只为正在操作的用户创建 DBus 代理，超过上限时释放最久未使用的
     QMap<User *, AccountsUser *> m_userInters;
+    QHash<User *, QString> m_userPaths;
+    // 还未加载的用户、列表中可见的用户和最近操作过的用户
+    UserPager m_pager;
     QString m_currentUserName;
     DisplayManager *m_dmInter;
     QStringList m_onlineUsers;
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "avatarcache.h"
+
+#include <QApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QUrl>
+#include <QtConcurrent>
+
+using namespace dcc::accounts;
+
+AvatarCache::AvatarCache(QObject *parent)
+    : QObject(parent)
+{
+    m_pixmaps.setMaxCost(256);
+}
+
+AvatarCache *AvatarCache::instance()
+{
+    static AvatarCache *cache = new AvatarCache(qApp);
+    return cache;
+}
+
+QPixmap AvatarCache::avatar(const QString &avatar, const QSize &size, qreal ratio)
+{
+    const QString path = localPath(avatar);
+    if (path.isEmpty() || size.isEmpty())
+        return QPixmap();
+
+    const QSize pixelSize = size * ratio;
+    const QString key = QString("%1:%2:%3x%4@%5").arg(path)
+                                                 .arg(QFileInfo(path).lastModified().toMSecsSinceEpoch())
+                                                 .arg(pixelSize.width())
+                                                 .arg(pixelSize.height())
+                                                 .arg(ratio);
+    if (QPixmap *pixmap = m_pixmaps.object(key))
+        return *pixmap;
+
+    if (m_loading.contains(key))
+        return QPixmap();
+    m_loading.insert(key);
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [ = ] {
+        watcher->deleteLater();
+        m_loading.remove(key);
+
+        // 解码失败的结果也缓存，避免重复解码
+        QPixmap *pixmap = new QPixmap(QPixmap::fromImage(watcher->result()));
+        pixmap->setDevicePixelRatio(ratio);
+        m_pixmaps.insert(key, pixmap);
+
+        Q_EMIT avatarReady(path);
+    });
+    watcher->setFuture(QtConcurrent::run(&AvatarCache::decode, path, pixelSize));
+
+    return QPixmap();
+}
+
+QString AvatarCache::localPath(const QString &avatar)
+{
+    return avatar.startsWith("file://") ? QUrl(avatar).toLocalFile() : avatar;
+}
+
+QImage AvatarCache::decode(const QString &path, const QSize &pixelSize)
+{
+    QImageReader reader(path);
+    const QSize size = reader.size();
+    if (size.isValid())
+        reader.setScaledSize(size.scaled(pixelSize, Qt::KeepAspectRatio));
+
+    return reader.read();
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef AVATARCACHE_H
+#define AVATARCACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+
+namespace dcc {
+namespace accounts {
+
+/**
+ * @brief 头像缩略图缓存
+ * 按图片路径、修改时间、显示大小和设备像素比缓存缩放好的头像，所有头像控件共用。
+ * 缓存中没有的头像在线程池中用 QImageReader 按目标大小解码，界面线程不会解码原图，
+ * 解码完成后发送 avatarReady，控件收到后重新调用 avatar() 获取。
+ */
+class AvatarCache : public QObject
+{
+    Q_OBJECT
+public:
+    static AvatarCache *instance();
+
+    // 缓存中没有时返回空图片并开始解码，avatar 可以是本地路径或 file:// 地址
+    QPixmap avatar(const QString &avatar, const QSize &size, qreal ratio);
+
+    static QString localPath(const QString &avatar);
+    static QImage decode(const QString &path, const QSize &pixelSize);
+
+Q_SIGNALS:
+    void avatarReady(const QString &path) const;
+
+private:
+    explicit AvatarCache(QObject *parent = nullptr);
+
+private:
+    QCache<QString, QPixmap> m_pixmaps;
+    QSet<QString> m_loading;
+};
+
+}   // namespace accounts
+}   // namespace dcc
+
+#endif // AVATARCACHE_H
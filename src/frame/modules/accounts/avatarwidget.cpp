@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "avatarwidget.h"
+#include "avatarcache.h"
 
 #include <QDebug>
 #include <QUrl>
@@ -30,6 +31,11 @@ AvatarWidget::AvatarWidget(QWidget *parent)
     setLayout(mainLayout);
     setFixedSize(PIX_SIZE, PIX_SIZE);
     setObjectName("AvatarWidget");
+
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, [this](const QString &path) {
+        if (path == QUrl(m_avatarPath).toLocalFile())
+            updateAvatar();
+    });
 }
 
 AvatarWidget::AvatarWidget(const QString &avatar, QWidget *parent)
@@ -79,17 +85,24 @@ void AvatarWidget::setAvatarPath(const QString &avatar)
         url = QUrl(avatar);
 
     m_avatarPath = url.toString();
-
-    if (!QPixmap(url.toLocalFile()).isNull()) {
-        m_avatar = QPixmap(url.toLocalFile()).scaled(size() * ratio, Qt::KeepAspectRatio, Qt::FastTransformation);
-        m_avatar.setDevicePixelRatio(ratio);
-    }
+    updateAvatar();
 
     setAccessibleName(m_avatarPath);
 
     update();
 }
 
+void AvatarWidget::updateAvatar()
+{
+    // 新头像解码完成前继续显示原来的头像
+    const QPixmap &avatar = AvatarCache::instance()->avatar(QUrl(m_avatarPath).toLocalFile(), size(), devicePixelRatioF());
+    if (avatar.isNull())
+        return;
+
+    m_avatar = avatar;
+    update();
+}
+
 void AvatarWidget::mouseReleaseEvent(QMouseEvent *e)
 {
     if (rect().contains(e->pos()))
@@ -191,11 +204,5 @@ void AvatarWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
 
-    const auto ratio = devicePixelRatioF();
-
-    QUrl url(m_avatarPath);
-    m_avatar = QPixmap(url.toLocalFile()).scaled(size() * ratio, Qt::KeepAspectRatio, Qt::FastTransformation);
-    m_avatar.setDevicePixelRatio(ratio);
-
-    update();
+    updateAvatar();
 }
@@ -42,6 +42,9 @@ protected:
     void leaveEvent(QEvent *);
     void resizeEvent(QResizeEvent *event);
 
+private:
+    void updateAvatar();
+
 private:
     bool m_hover;
     bool m_deleable;
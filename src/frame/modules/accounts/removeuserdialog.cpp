@@ -10,6 +10,7 @@
 #include <QCheckBox>
 
 #include "avatarwidget.h"
+#include "avatarcache.h"
 
 using namespace dcc::accounts;
 
@@ -36,12 +37,28 @@ RemoveUserDialog::RemoveUserDialog(const User *user, QWidget *parent)
 {
     setTitle(tr("Are you sure you want to delete this account?"));
 
-    const auto ratio = devicePixelRatioF();
     const QString iconFile = QUrl(user->currentAvatar()).toLocalFile();
-    const QPixmap pix = QPixmap(iconFile).scaled(48 * ratio, 48 * ratio, Qt::IgnoreAspectRatio, Qt::FastTransformation);
-    QPixmap p = RoundPixmap(pix);
-    p.setDevicePixelRatio(ratio);
-    setIcon(p);
+    auto updateIcon = [ = ] {
+        const auto ratio = devicePixelRatioF();
+        QPixmap pix = AvatarCache::instance()->avatar(iconFile, QSize(48, 48), ratio);
+        if (pix.isNull())
+            return false;
+
+        // 缓存按比例缩放，非正方形的头像需要拉伸为正方形后再裁剪成圆形
+        pix = pix.scaled(QSize(48, 48) * ratio, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+        pix.setDevicePixelRatio(1);
+        QPixmap p = RoundPixmap(pix);
+        p.setDevicePixelRatio(ratio);
+        setIcon(p);
+        return true;
+    };
+    // 头像不在缓存中时，解码完成后再设置
+    if (!updateIcon()) {
+        connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, [ = ](const QString &path) {
+            if (path == iconFile)
+                updateIcon();
+        });
+    }
 
     QCheckBox *box = new QCheckBox(tr("Delete account directory"));
     box->setChecked(true);
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "useroptionitem.h"
+#include "avatarcache.h"
 
 #include <QLabel>
 #include <QDebug>
@@ -23,14 +24,29 @@ UserOptionItem::UserOptionItem(QFrame *parent)
     QHBoxLayout *mainLayout = static_cast<QHBoxLayout *>(layout());
     mainLayout->insertWidget(0, m_avatarLabel);
     mainLayout->setSpacing(10);
+
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, [this](const QString &path) {
+        if (path == m_avatar)
+            updateAvatar();
+    });
 }
 
 void UserOptionItem::setAvatar(const QString &avatar)
+{
+    m_avatar = QUrl(avatar).toLocalFile();
+    updateAvatar();
+}
+
+void UserOptionItem::updateAvatar()
 {
     const QSize s = m_avatarLabel->size() * devicePixelRatioF();
 
-    const QUrl url(avatar);
-    QPixmap pixmap = QPixmap(url.toLocalFile()).scaled(s, Qt::KeepAspectRatio, Qt::FastTransformation);
+    QPixmap pixmap = AvatarCache::instance()->avatar(m_avatar, m_avatarLabel->size(), devicePixelRatioF());
+    if (pixmap.isNull())
+        return;
+    // 头像标签是正方形，非正方形的头像拉伸到标签大小，圆形才不会被截断
+    pixmap = pixmap.scaled(s, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    pixmap.setDevicePixelRatio(1);
 
     QPixmap pic(s);
     pic.fill(Qt::transparent);
@@ -23,8 +23,12 @@ public:
 public Q_SLOTS:
     void setAvatar(const QString &avatar);
 
+private:
+    void updateAvatar();
+
 private:
     QLabel *m_avatarLabel;
+    QString m_avatar;
 };
 
 }
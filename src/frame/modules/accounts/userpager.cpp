@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "userpager.h"
+
+using namespace dcc::accounts;
+
+UserPager::UserPager(int maxRecent)
+    : m_maxRecent(maxRecent)
+{
+
+}
+
+void UserPager::setPendingPaths(const QStringList &paths)
+{
+    m_pending = paths;
+}
+
+QStringList UserPager::takePage(int count)
+{
+    if (count <= 0 || m_pending.isEmpty())
+        return QStringList();
+
+    const QStringList page = m_pending.mid(0, count);
+    m_pending.erase(m_pending.begin(), m_pending.begin() + page.size());
+    return page;
+}
+
+bool UserPager::takePath(const QString &path)
+{
+    return m_pending.removeOne(path);
+}
+
+void UserPager::setVisiblePaths(const QStringList &paths)
+{
+    m_visible = paths;
+}
+
+QStringList UserPager::touch(const QString &path)
+{
+    m_recent.removeOne(path);
+    m_recent << path;
+
+    QStringList evicted;
+    while (m_recent.size() > m_maxRecent)
+        evicted << m_recent.takeFirst();
+
+    return evicted;
+}
+
+QStringList UserPager::activePaths() const
+{
+    QStringList paths = m_visible;
+    const QSet<QString> visible = m_visible.toSet();
+    for (const QString &path : m_recent) {
+        if (!visible.contains(path))
+            paths << path;
+    }
+
+    return paths;
+}
+
+void UserPager::removePath(const QString &path)
+{
+    m_pending.removeOne(path);
+    m_visible.removeOne(path);
+    m_recent.removeOne(path);
+}
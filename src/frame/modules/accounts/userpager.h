@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef USERPAGER_H
+#define USERPAGER_H
+
+#include <QSet>
+#include <QStringList>
+
+namespace dcc {
+namespace accounts {
+
+/**
+ * @brief 用户列表的分页加载和活动窗口
+ * 记录还未加载的用户路径，滚动用户列表时按页取出；
+ * 记录列表中可见的用户和最近操作过的用户，只有这些用户需要刷新属性，
+ * 最近操作过的用户超过上限时淘汰最久未使用的，调用方释放其 DBus 代理。
+ * 只处理用户的 DBus 路径，不访问 DBus。
+ */
+class UserPager
+{
+public:
+    explicit UserPager(int maxRecent);
+
+    void setPendingPaths(const QStringList &paths);
+    QStringList takePage(int count);
+    bool takePath(const QString &path);
+    int pendingCount() const { return m_pending.size(); }
+
+    void setVisiblePaths(const QStringList &paths);
+    QStringList visiblePaths() const { return m_visible; }
+
+    // 记录一次操作，返回因超出上限被淘汰的用户
+    QStringList touch(const QString &path);
+    QStringList recentPaths() const { return m_recent; }
+
+    // 需要刷新属性的用户，可见的在前
+    QStringList activePaths() const;
+
+    void removePath(const QString &path);
+
+private:
+    int m_maxRecent;
+    QStringList m_pending;
+    QStringList m_visible;
+    QStringList m_recent;   // 最近操作的在后
+};
+
+}   // namespace accounts
+}   // namespace dcc
+
+#endif // USERPAGER_H
@@ -21,6 +21,7 @@ void BluetoothModel::addAdapter(Adapter *adapter)
 {
     if (!adapterById(adapter->id())) {
         m_adapters[adapter->id()] = adapter;
+        indexAdapter(adapter);
         Q_EMIT adapterAdded(adapter);
         Q_EMIT adpaterListChanged();
         return;
@@ -36,6 +37,7 @@ const Adapter *BluetoothModel::removeAdapater(const QString &adapterId)
     adapter = adapterById(adapterId);
     if (adapter) {
         m_adapters.remove(adapterId);
+        unindexAdapter(adapter);
         Q_EMIT adapterRemoved(adapter);
         Q_EMIT adpaterListChanged();
     }
@@ -50,7 +52,44 @@ QMap<QString, const Adapter *> BluetoothModel::adapters() const
 
 const Adapter *BluetoothModel::adapterById(const QString &id)
 {
-    return m_adapters.keys().contains(id) ? m_adapters[id] : nullptr;
+    return m_adapters.value(id, nullptr);
+}
+
+const Device *BluetoothModel::deviceById(const QString &deviceId) const
+{
+    return m_deviceIndex.value(deviceId).second;
+}
+
+const Adapter *BluetoothModel::adapterByDeviceId(const QString &deviceId) const
+{
+    return m_deviceIndex.value(deviceId).first;
+}
+
+void BluetoothModel::indexAdapter(const Adapter *adapter)
+{
+    for (const Device *device : adapter->devices())
+        m_deviceIndex.insert(device->id(), qMakePair(adapter, device));
+
+    connect(adapter, &Adapter::deviceAdded, this, [ = ](const Device *device) {
+        m_deviceIndex.insert(device->id(), qMakePair(adapter, device));
+    });
+    connect(adapter, &Adapter::deviceRemoved, this, [ = ](const QString &deviceId) {
+        if (m_deviceIndex.value(deviceId).first == adapter)
+            m_deviceIndex.remove(deviceId);
+    });
+}
+
+void BluetoothModel::unindexAdapter(const Adapter *adapter)
+{
+    disconnect(adapter, &Adapter::deviceAdded, this, nullptr);
+    disconnect(adapter, &Adapter::deviceRemoved, this, nullptr);
+
+    for (auto it = m_deviceIndex.begin(); it != m_deviceIndex.end();) {
+        if (it.value().first == adapter)
+            it = m_deviceIndex.erase(it);
+        else
+            ++it;
+    }
 }
 
 /**
@@ -6,6 +6,8 @@
 #define DCC_BLUETOOTH_BLUETOOTHMODEL_H
 
 #include <QObject>
+#include <QHash>
+#include <QPair>
 
 #include "adapter.h"
 
@@ -20,6 +22,9 @@ public:
 
     QMap<QString, const Adapter *> adapters() const;
     const Adapter *adapterById(const QString &id);
+    // 按设备 id 直接查找设备及其所属的适配器，不需要遍历所有适配器
+    const Device *deviceById(const QString &deviceId) const;
+    const Adapter *adapterByDeviceId(const QString &deviceId) const;
 
     bool canTransportable() const;
     inline bool canSendFile() const { return m_canSendFile; }
@@ -53,8 +58,14 @@ Q_SIGNALS:
     void notifyMyDeviceVisibleChanged(bool);
     void notifyOtherDeviceVisibleChanged(bool);
 
+private:
+    void indexAdapter(const Adapter *adapter);
+    void unindexAdapter(const Adapter *adapter);
+
 private:
     QMap<QString, const Adapter *> m_adapters;
+    // 设备 id 到 (适配器, 设备) 的索引，随适配器的 deviceAdded/deviceRemoved 更新
+    QHash<QString, QPair<const Adapter *, const Device *>> m_deviceIndex;
     bool m_transPortable;
     bool m_canSendFile;
     bool m_airplaneEnable;
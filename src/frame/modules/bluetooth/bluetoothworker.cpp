@@ -20,10 +20,15 @@ BluetoothWorker::BluetoothWorker(BluetoothModel *model, bool sync)
     , m_connectingAudioDevice(false)
     , m_state(m_bluetoothInter->state())
     , m_powerSwitchTimer(new QTimer(this))
+    , m_devicePropertiesTimer(new QTimer(this))
 {
     m_powerSwitchTimer->setSingleShot(true);
     m_powerSwitchTimer->setInterval(500);
 
+    m_devicePropertiesTimer->setSingleShot(true);
+    m_devicePropertiesTimer->setInterval(16);
+    connect(m_devicePropertiesTimer, &QTimer::timeout, this, &BluetoothWorker::applyDeviceProperties);
+
     connect(m_bluetoothInter, &DBusBluetooth::StateChanged, this, &BluetoothWorker::onStateChanged);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterAdded, this, &BluetoothWorker::addAdapter);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterRemoved, this, &BluetoothWorker::removeAdapter);
@@ -355,23 +360,31 @@ void BluetoothWorker::onAdapterPropertiesChanged(const QString &json)
 
 void BluetoothWorker::onDevicePropertiesChanged(const QString &json)
 {
-    const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-    const QJsonObject obj = doc.object();
-    const QString id = obj["Path"].toString();
-    const QString name = obj["Name"].toString();
-    for (const Adapter *adapter : m_model->adapters()) {
-        Adapter *adapterPointer = const_cast<Adapter*>(adapter);
-        Device *device = const_cast<Device*>(adapter->deviceById(id));
-        if (device) {
-            if (device->name() == name) {
-                inflateDevice(device, obj);
-            } else {
-                if (!adapterPointer)
-                    return;
-                adapterPointer->removeDevice(device->id());
-                inflateDevice(device, obj);
-                adapterPointer->addDevice(device);
-            }
+    const QJsonObject obj = QJsonDocument::fromJson(json.toUtf8()).object();
+    m_pendingDeviceProperties.insert(obj["Path"].toString(), obj);
+
+    if (!m_devicePropertiesTimer->isActive())
+        m_devicePropertiesTimer->start();
+}
+
+void BluetoothWorker::applyDeviceProperties()
+{
+    const QHash<QString, QJsonObject> pending = m_pendingDeviceProperties;
+    m_pendingDeviceProperties.clear();
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        Adapter *adapter = const_cast<Adapter *>(m_model->adapterByDeviceId(it.key()));
+        Device *device = const_cast<Device *>(m_model->deviceById(it.key()));
+        if (!adapter || !device)
+            continue;
+
+        const QJsonObject &obj = it.value();
+        if (device->name() == obj["Name"].toString()) {
+            inflateDevice(device, obj);
+        } else {
+            adapter->removeDevice(device->id());
+            inflateDevice(device, obj);
+            adapter->addDevice(device);
         }
     }
 }
@@ -407,6 +420,9 @@ void BluetoothWorker::addDevice(const QString &json)
     const QString adapterId = obj["AdapterPath"].toString();
     const QString id = obj["Path"].toString();
 
+    // 新增设备的信息是完整的，之前缓存的属性变化已经过期
+    m_pendingDeviceProperties.remove(id);
+
     const Adapter *result = m_model->adapterById(adapterId);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
@@ -425,6 +441,8 @@ void BluetoothWorker::removeDevice(const QString &json)
     const QString adapterId = obj["AdapterPath"].toString();
     const QString id = obj["Path"].toString();
 
+    m_pendingDeviceProperties.remove(id);
+
     const Adapter *result = m_model->adapterById(adapterId);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
@@ -6,6 +6,8 @@
 #define DCC_BLUETOOTH_BLUETOOTHWORKER_H
 
 #include <QObject>
+#include <QHash>
+#include <QJsonObject>
 
 #include <com_deepin_daemon_bluetooth.h>
 #include <com_deepin_daemon_airplanemode.h>
@@ -59,6 +61,7 @@ private:
 private Q_SLOTS:
     void onAdapterPropertiesChanged(const QString &json);
     void onDevicePropertiesChanged(const QString &json);
+    void applyDeviceProperties();
 
     void addAdapter(const QString &json);
     void removeAdapter(const QString &json);
@@ -82,6 +85,9 @@ private:
     bool m_connectingAudioDevice;
     uint m_state;
     QTimer *m_powerSwitchTimer;
+    // 扫描时设备属性变化很频繁，同一设备在一帧内只处理最后一次变化
+    QHash<QString, QJsonObject> m_pendingDeviceProperties;
+    QTimer *m_devicePropertiesTimer;
 };
 
 } // namespace bluetooth
@@ -99,9 +99,33 @@ void DisplayModel::setPrimary(const QString &primary)
     }
 }
 
-void DisplayModel::monitorAdded(Monitor *mon)
+void DisplayModel::setScreenScales(const QMap<QString, double> &scales)
 {
-    m_monitors.append(mon);
+    m_screenScales = scales;
+    for (auto mon : m_monitors)
+        applyScreenScale(mon);
+}
+
+void DisplayModel::applyScreenScale(Monitor *mon)
+{
+    auto it = m_screenScales.constFind(mon->name());
+    if (it == m_screenScales.cend())
+        return;
+
+    mon->setScale(it.value() < 1.0 ? m_uiScale : it.value());
+}
+
+void DisplayModel::monitorsAdded(const QList<Monitor *> &monitors)
+{
+    if (monitors.isEmpty())
+        return;
+
+    m_monitors.append(monitors);
+    m_commonModesDirty = true;
+    for (auto mon : monitors) {
+        connect(mon, &Monitor::modelListChanged, this, [this] { m_commonModesDirty = true; });
+        applyScreenScale(mon);
+    }
     //  按照名称排序，显示的时候VGA在前，HDMI在后
     qSort(m_monitors.begin(), m_monitors.end(), [=](const Monitor *m1, const Monitor *m2){
         return m1->name() > m2->name();
@@ -114,6 +138,8 @@ void DisplayModel::monitorAdded(Monitor *mon)
 void DisplayModel::monitorRemoved(Monitor *mon)
 {
     m_monitors.removeOne(mon);
+    m_commonModesDirty = true;
+    disconnect(mon, &Monitor::modelListChanged, this, nullptr);
     checkAllSupportFillModes();
 
     Q_EMIT monitorListChanged();
@@ -247,3 +273,55 @@ void DisplayModel::checkAllSupportFillModes()
     }
     m_allSupportFillModes = true;
 }
+
+const QList<Resolution> &DisplayModel::commonModes() const
+{
+    updateCommonModes();
+    return m_commonModes;
+}
+
+bool DisplayModel::isCommonResolution(const Resolution &r) const
+{
+    updateCommonModes();
+    return m_commonResolutions.contains(Monitor::resolutionKey(r));
+}
+
+bool DisplayModel::isCommonMode(const Resolution &r) const
+{
+    updateCommonModes();
+    return m_commonModeKeys.contains(Monitor::modeKey(r));
+}
+
+void DisplayModel::updateCommonModes() const
+{
+    if (!m_commonModesDirty)
+        return;
+
+    m_commonModesDirty = false;
+    m_commonModes.clear();
+    m_commonResolutions.clear();
+    m_commonModeKeys.clear();
+    if (m_monitors.isEmpty())
+        return;
+
+    // 共有的模式一定在第一个屏幕的模式列表中，只需要在其他屏幕的索引中查找
+    const QList<Monitor *> others = m_monitors.mid(1);
+    for (const Resolution &mode : m_monitors.first()->modeList()) {
+        bool hasResolution = true;
+        bool hasMode = true;
+        for (auto mon : others) {
+            hasResolution = hasResolution && mon->hasResolution(mode);
+            hasMode = hasMode && mon->hasResolutionAndRate(mode);
+            if (!hasResolution)
+                break;
+        }
+
+        if (hasResolution)
+            m_commonResolutions.insert(Monitor::resolutionKey(mode));
+
+        if (hasMode && !m_commonModeKeys.contains(Monitor::modeKey(mode))) {
+            m_commonModeKeys.insert(Monitor::modeKey(mode));
+            m_commonModes.append(mode);
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #ifndef DISPLAYMODEL_H
 #define DISPLAYMODEL_H
 
+#include <QMap>
 #include <QObject>
 
 #include "monitor.h"
@@ -85,6 +86,11 @@ public:
     inline bool allSupportFillModes() const { return m_allSupportFillModes; }
     void checkAllSupportFillModes();
 
+    // 复制模式下所有屏幕共有的模式，按第一个屏幕的模式顺序排列，屏幕或模式列表变化后重新计算
+    const QList<Resolution> &commonModes() const;
+    bool isCommonResolution(const Resolution &r) const;
+    bool isCommonMode(const Resolution &r) const;
+
 Q_SIGNALS:
     void screenHeightChanged(const int h) const;
     void screenWidthChanged(const int w) const;
@@ -113,11 +119,16 @@ private Q_SLOTS:
     void setMinimumBrightnessScale(const double scale);
     void setPrimary(const QString &primary);
     void setRedshiftIsValid(bool redshiftIsValid);
-    void monitorAdded(Monitor *mon);
+    void setScreenScales(const QMap<QString, double> &scales);
+    void monitorsAdded(const QList<Monitor *> &monitors);
     void monitorRemoved(Monitor *mon);
     void setAutoLightAdjustIsValid(bool);
     void setmaxBacklightBrightness(const uint value);
 
+private:
+    void updateCommonModes() const;
+    void applyScreenScale(Monitor *mon);
+
 private:
     int m_screenHeight;
     int m_screenWidth;
@@ -128,6 +139,7 @@ private:
     double m_minimumBrightnessScale;
     QString m_primary;
     QList<Monitor *> m_monitors;
+    QMap<QString, double> m_screenScales;   // Appearance 中每个显示器的缩放，显示器可能晚于它加入
     bool m_redshiftIsValid;
     bool m_RefreshRateEnable {false};
     bool m_isAutoLightAdjust {false};
@@ -140,6 +152,10 @@ private:
     TouchscreenMap m_touchMap;
     uint m_maxBacklightBrightness {0};
     bool m_allSupportFillModes;
+    mutable bool m_commonModesDirty {true};
+    mutable QList<Resolution> m_commonModes;
+    mutable QSet<quint32> m_commonResolutions;
+    mutable QSet<quint64> m_commonModeKeys;
 };
 
 } // namespace display
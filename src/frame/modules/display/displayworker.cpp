@@ -5,11 +5,12 @@
 #include "displayworker.h"
 #include "displaymodel.h"
 #include "widgets/utils.h"
+#include "window/dbuscallcoalescer.h"
+#include "window/dbuspropertybatch.h"
 
 #include <DApplicationHelper>
 
 #include <QDebug>
-#include <QtConcurrent>
 
 using namespace dcc;
 using namespace dcc::display;
@@ -32,7 +33,11 @@ DisplayWorker::DisplayWorker(DisplayModel *model, QObject *parent, bool isSync)
                                             QDBusConnection::sessionBus(), this))
     , m_updateScale(false)
     , m_timer(new QTimer(this))
+    , m_transactionsInFlight(0)
+    , m_applyPending(false)
+    , m_transactionFailed(false)
     , m_powerInter(new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
+    , m_sliderCalls(new DBusCallCoalescer(this))
 {
     m_displayInter.setSync(isSync);
     m_appearanceInter->setSync(isSync);
@@ -136,13 +141,18 @@ void DisplayWorker::onMonitorListChanged(const QList<QDBusObjectPath> &mons)
 
     qDebug() << mons.size();
     QList<QString> pathList;
+    QStringList addedList;
     for (const auto &op : mons) {
         const QString path = op.path();
         pathList << path;
-        if (!ops.contains(path))
-            monitorAdded(path);
+        if (!ops.contains(path) && !m_loadingMonitors.contains(path))
+            addedList << path;
     }
 
+    m_monitorPaths = pathList;
+    if (!addedList.isEmpty())
+        monitorsAdded(addedList);
+
     for (const auto &op : ops)
         if (!pathList.contains(op))
             monitorRemoved(op);
@@ -170,15 +180,9 @@ void DisplayWorker::onGetScaleFinished(QDBusPendingCallWatcher *w)
 void DisplayWorker::onGetScreenScalesFinished(QDBusPendingCallWatcher *w)
 {
     QDBusPendingReply<QMap<QString, double>> reply = w->reply();
-    QMap<QString, double> rmap = reply;
 
-    for (auto &m : m_model->monitorList()) {
-        if (rmap.find(m->name()) != rmap.end()) {
-            m->setScale(rmap.value(m->name()) < 1.0
-                            ? m_model->uiScale()
-                            : rmap.value(m->name()));
-        }
-    }
+    // 显示器是异步加载的，返回时可能还没有加入 model，由 model 记下后在显示器加入时设置
+    m_model->setScreenScales(reply.value());
 
     w->deleteLater();
 }
@@ -186,14 +190,17 @@ void DisplayWorker::onGetScreenScalesFinished(QDBusPendingCallWatcher *w)
 #ifndef DCC_DISABLE_ROTATE
 void DisplayWorker::setMonitorRotate(Monitor *mon, const quint16 rotate)
 {
+    beginTransaction();
+
     if (m_model->displayMode() == MERGE_MODE) {
-        for (auto *m : m_monitors) {
-            m->SetRotation(rotate).waitForFinished();
+        for (auto *m : m_monitors.keys()) {
+            queueMonitorRotate(m, rotate);
         }
     } else {
-        MonitorInter *inter = m_monitors.value(mon);
-        inter->SetRotation(rotate).waitForFinished();
+        queueMonitorRotate(mon, rotate);
     }
+
+    commitTransaction(false);
 }
 #endif
 
@@ -214,6 +221,12 @@ void DisplayWorker::setMonitorEnable(Monitor *monitor, const bool enable)
 
 void DisplayWorker::applyChanges()
 {
+    // 还有配置调用未返回时，等事务结束后再应用
+    if (m_transactionsInFlight > 0) {
+        m_applyPending = true;
+        return;
+    }
+
     if (!m_timer->isActive()) {
         m_timer->start();
     }
@@ -221,7 +234,9 @@ void DisplayWorker::applyChanges()
 
 void DisplayWorker::setColorTemperature(int value)
 {
-    m_displayInter.SetColorTemperature(value).waitForFinished();
+    m_sliderCalls->post("ColorTemperature", [ = ] {
+        return m_displayInter.SetColorTemperature(value);
+    });
 }
 
 void DisplayWorker::SetMethodAdjustCCT(int mode)
@@ -238,78 +253,33 @@ void DisplayWorker::setCurrentFillMode(Monitor *mon,const QString fillMode)
 
 void DisplayWorker::setMonitorResolution(Monitor *mon, const int mode)
 {
-    MonitorInter *inter = m_monitors.value(mon);
-    Q_ASSERT(inter);
-    inter->SetMode(static_cast<uint>(mode)).waitForFinished();
+    beginTransaction();
+
+    queueMonitorMode(mon, mode);
+
+    commitTransaction(false);
 }
 
 void DisplayWorker::setMonitorBrightness(Monitor *mon, const double brightness)
 {
-    // m_displayInter.SetAndSaveBrightness(mon->name(), std::max(brightness, m_model->minimumBrightnessScale())).waitForFinished();
-    double value = std::max(brightness, m_model->minimumBrightnessScale());
-    qDebug() << "setMonitorBrightness: receive request" << mon->name() << value;
+    const QString name = mon->name();
+    const double value = std::max(brightness, m_model->minimumBrightnessScale());
+    qDebug() << "setMonitorBrightness: receive request" << name << value;
 
     //前面亮度设置未完成，只记录最新请求
-    QMutexLocker loker(&m_brightness.m_brightnessMutex);
-    m_brightness.m_hasWaitingRequest = true;
-    m_brightness.m_brightnessValue = value;
-    m_brightness.m_monitorName = mon->name();
-    if (!m_brightness.m_hasPendingRequest) {
-        QTimer::singleShot(0, this, &DisplayWorker::handleSetBrightnessRequest);
-    }
-}
-
-void DisplayWorker::handleSetBrightnessRequest() {
-    qDebug() << "setMonitorBrightness enter";
-    QMutexLocker loker(&m_brightness.m_brightnessMutex);
-    if (m_brightness.m_hasPendingRequest) {
-        return;
-    }
-    if (!m_brightness.m_hasWaitingRequest) {
-        return;
-    }
-
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<QDBusPendingReply<>>::finished, [this, watcher] {
-        QMutexLocker loker(&m_brightness.m_brightnessMutex);
-        m_brightness.m_hasPendingRequest = false;
-        qDebug() << "setMonitorBrightness: finish";
-        if (m_brightness.m_hasWaitingRequest) {
-            QTimer::singleShot(0, this, &DisplayWorker::handleSetBrightnessRequest);
-        }
-        watcher->deleteLater();
-    });
-
-    QFuture<void> future = QtConcurrent::run([this] {
-        QMutexLocker loker(&m_brightness.m_brightnessMutex);
-        if (m_brightness.m_hasPendingRequest) {
-            return;
-        }
-        if (!m_brightness.m_hasWaitingRequest) {
-            return;
-        }
-        m_brightness.m_hasPendingRequest = true;
-        m_brightness.m_hasWaitingRequest = false;
-        QString name = m_brightness.m_monitorName;
-        double value = m_brightness.m_brightnessValue;
-        m_brightness.m_monitorName = "";
-        m_brightness.m_brightnessValue = 0;
-        loker.unlock();
+    m_sliderCalls->post("Brightness:" + name, [ = ] {
         qDebug() << "setMonitorBrightness: begin, " << name << value;
-        m_displayInter.SetAndSaveBrightness(name, value).waitForFinished();
+        return m_displayInter.SetAndSaveBrightness(name, value);
     });
-
-    watcher->setFuture(future);
 }
 
 void DisplayWorker::setMonitorPosition(QHash<Monitor *, QPair<int, int>> monitorPosition)
 {
+    beginTransaction();
     for (auto it(monitorPosition.cbegin()); it != monitorPosition.cend(); ++it) {
-        MonitorInter *inter = m_monitors.value(it.key());
-        Q_ASSERT(inter);
-        inter->SetPosition(static_cast<short>(it.value().first), static_cast<short>(it.value().second)).waitForFinished();
+        queueMonitorPosition(it.key(), it.value().first, it.value().second);
     }
-    applyChanges();
+    commitTransaction();
 }
 
 void DisplayWorker::setUiScale(const double value)
@@ -333,15 +303,11 @@ void DisplayWorker::setUiScale(const double value)
 
 void DisplayWorker::setIndividualScaling(Monitor *m, const double scaling)
 {
-    if (m && scaling >= 1.0) {
-        m->setScale(scaling);
-    }
+    beginTransaction();
 
-    QMap<QString, double> scalemap;
-    for (Monitor *m : m_model->monitorList()) {
-        scalemap[m->name()] = m_model->monitorScale(m);
-    }
-    m_appearanceInter->SetScreenScaleFactors(scalemap);
+    queueMonitorScale(m, scaling);
+
+    commitTransaction(false);
 }
 
 void DisplayWorker::setNightMode(const bool nightmode)
@@ -366,9 +332,50 @@ void DisplayWorker::setNightMode(const bool nightmode)
     process->start("bash", QStringList() << "-c" << QString("systemctl --user %1 redshift.service && systemctl --user %2 redshift.service").arg(serverCmd).arg(cmd));
 }
 
-void DisplayWorker::monitorAdded(const QString &path)
+void DisplayWorker::monitorsAdded(const QStringList &paths)
+{
+    // 每个显示器只调用一次 GetAll，所有显示器的请求同时发出，全部返回后再一次性加入 model
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    for (const QString &path : paths) {
+        m_loadingMonitors.insert(path);
+        batch->addInterface(path, QDBusConnection::sessionBus(), DisplayInterface, path, MonitorInter::staticInterfaceName());
+    }
+
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        batch->deleteLater();
+
+        QList<QPair<Monitor *, MonitorInter *>> monitors;
+        for (const QString &path : paths) {
+            // 加载过程中显示器已被拔出
+            if (!m_monitorPaths.contains(path)) {
+                m_loadingMonitors.remove(path);
+                continue;
+            }
+
+            const QVariantMap &properties = batch->properties(path);
+            if (batch->hasError(path) || properties.value("Name").toString().isEmpty()) {
+                qWarning() << "get properties of monitor failed:" << path << batch->error(path).message();
+                m_loadingMonitors.remove(path);
+                continue;
+            }
+
+            monitors << monitorCreated(path, properties);
+        }
+
+        if (!monitors.isEmpty())
+            loadMonitorBrightnessAbility(monitors);
+    });
+
+    batch->start();
+    // NOTE: 同步模式下调用方需要在 active 之后立即拿到显示器数据，这里需要等待全部返回
+    if (m_displayInter.sync())
+        batch->waitForFinished();
+}
+
+QPair<Monitor *, MonitorInter *> DisplayWorker::monitorCreated(const QString &path, const QVariantMap &properties)
 {
     MonitorInter *inter = new MonitorInter(DisplayInterface, path, QDBusConnection::sessionBus(), this);
+    inter->setSync(false);
     Monitor *mon = new Monitor(this);
 
     connect(inter, &MonitorInter::XChanged, mon, &Monitor::setX);
@@ -407,27 +414,23 @@ void DisplayWorker::monitorAdded(const QString &path)
         mon->setModeList(inter->modes());
     });
 
-    // NOTE: DO NOT using async dbus call. because we need to have a unique name to distinguish each monitor
-    Q_ASSERT(inter->isValid());
-    mon->setName(inter->name());
-    mon->setManufacturer(inter->manufacturer());
-    mon->setModel(inter->model());
-    QDBusReply<bool> reply = m_displayDBusInter->call("CanSetBrightness", inter->name());
-    mon->setCanBrightness(reply.value());
-    mon->setMonitorEnable(inter->enabled());
-    mon->setCurrentRotateMode(inter->currentRotateMode());
-    mon->setMonitorEnable(inter->enabled());
-    mon->setCurrentFillMode(inter->currentFillMode());
-    mon->setAvailableFillModes(inter->availableFillModes());
+    // 显示器的全部属性来自同一次 GetAll，一次性写入
+    mon->setName(DBusPropertyBatch::value<QString>(properties, "Name"));
+    mon->setManufacturer(DBusPropertyBatch::value<QString>(properties, "Manufacturer"));
+    mon->setModel(DBusPropertyBatch::value<QString>(properties, "Model"));
+    mon->setMonitorEnable(DBusPropertyBatch::value<bool>(properties, "Enabled"));
+    mon->setCurrentRotateMode(DBusPropertyBatch::value<uchar>(properties, "CurrentRotateMode"));
+    mon->setCurrentFillMode(DBusPropertyBatch::value<QString>(properties, "CurrentFillMode"));
+    mon->setAvailableFillModes(DBusPropertyBatch::value<QStringList>(properties, "AvailableFillModes"));
     mon->setPath(path);
-    mon->setX(inter->x());
-    mon->setY(inter->y());
-    mon->setW(inter->width());
-    mon->setH(inter->height());
-    mon->setRotate(inter->rotation());
-    mon->setCurrentMode(inter->currentMode());
-    mon->setBestMode(inter->bestMode());
-    mon->setModeList(inter->modes());
+    mon->setX(DBusPropertyBatch::value<short>(properties, "X"));
+    mon->setY(DBusPropertyBatch::value<short>(properties, "Y"));
+    mon->setW(DBusPropertyBatch::value<ushort>(properties, "Width"));
+    mon->setH(DBusPropertyBatch::value<ushort>(properties, "Height"));
+    mon->setRotate(DBusPropertyBatch::value<ushort>(properties, "Rotation"));
+    mon->setCurrentMode(DBusPropertyBatch::value<Resolution>(properties, "CurrentMode"));
+    mon->setBestMode(DBusPropertyBatch::value<Resolution>(properties, "BestMode"));
+    mon->setModeList(DBusPropertyBatch::value<ResolutionList>(properties, "Modes"));
     if (m_model->isRefreshRateEnable() == false) {
         for (auto resolutionModel : mon->modeList()) {
             if (qFuzzyCompare(resolutionModel.rate(), 0.0) == false) {
@@ -435,19 +438,51 @@ void DisplayWorker::monitorAdded(const QString &path)
             }
         }
     }
-    mon->setRotateList(inter->rotations());
-    mon->setPrimary(m_displayInter.primary());
-    mon->setMmWidth(inter->mmWidth());
-    mon->setMmHeight(inter->mmHeight());
+    mon->setRotateList(DBusPropertyBatch::value<QList<quint16>>(properties, "Rotations"));
+    mon->setPrimary(m_model->primary().isEmpty() ? m_displayInter.primary() : m_model->primary());
+    mon->setMmWidth(DBusPropertyBatch::value<uint>(properties, "MmWidth"));
+    mon->setMmHeight(DBusPropertyBatch::value<uint>(properties, "MmHeight"));
 
     if (!m_model->brightnessMap().isEmpty()) {
         mon->setBrightness(m_model->brightnessMap()[mon->name()]);
     }
 
-    m_model->monitorAdded(mon);
-    m_monitors.insert(mon, inter);
+    return qMakePair(mon, inter);
+}
 
-    inter->setSync(false);
+void DisplayWorker::loadMonitorBrightnessAbility(const QList<QPair<Monitor *, MonitorInter *>> &monitors)
+{
+    // CanSetBrightness 需要显示器名称，所以在属性返回后再并行查询
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    for (const auto &monitor : monitors) {
+        batch->addCall(monitor.first->path(), m_displayDBusInter->asyncCall("CanSetBrightness", monitor.first->name()));
+    }
+
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        batch->deleteLater();
+
+        QList<Monitor *> added;
+        for (const auto &monitor : monitors) {
+            Monitor *mon = monitor.first;
+            m_loadingMonitors.remove(mon->path());
+            if (!m_monitorPaths.contains(mon->path())) {
+                monitor.second->deleteLater();
+                mon->deleteLater();
+                continue;
+            }
+
+            QDBusPendingReply<bool> reply = batch->call(mon->path());
+            mon->setCanBrightness(!batch->hasError(mon->path()) && reply.value());
+            m_monitors.insert(mon, monitor.second);
+            added << mon;
+        }
+
+        m_model->monitorsAdded(added);
+    });
+
+    batch->start();
+    if (m_displayInter.sync())
+        batch->waitForFinished();
 }
 
 void DisplayWorker::monitorRemoved(const QString &path)
@@ -497,16 +532,136 @@ void DisplayWorker::setTouchScreenAssociation(const QString &monitor, const QStr
 
 void DisplayWorker::setMonitorResolutionBySize(Monitor *mon, const int width, const int height)
 {
-    MonitorInter *inter = m_monitors.value(mon);
-    Q_ASSERT(inter);
+    beginTransaction();
 
-    QDBusPendingCall call = inter->SetModeBySize(static_cast<ushort>(width), static_cast<ushort>(height));
-    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
-        if (call.isError()) {
-            qDebug() << call.error().message();
+    queueMonitorModeBySize(mon, width, height);
+
+    commitTransaction(false);
+}
+
+void DisplayWorker::beginTransaction()
+{
+    // 嵌套的事务合并到最外层，由最外层的 commit 统一发出
+    ++m_transaction.depth;
+}
+
+void DisplayWorker::queueMonitorPosition(Monitor *mon, const int x, const int y)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+    m_transaction.calls << qMakePair(mon, PendingCall { mon->name(), "SetPosition", [ = ](MonitorInter *inter) {
+        return QDBusPendingCall(inter->SetPosition(static_cast<short>(x), static_cast<short>(y)));
+    }});
+}
+
+void DisplayWorker::queueMonitorMode(Monitor *mon, const int mode)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+    m_transaction.calls << qMakePair(mon, PendingCall { mon->name(), "SetMode", [ = ](MonitorInter *inter) {
+        return QDBusPendingCall(inter->SetMode(static_cast<uint>(mode)));
+    }});
+}
+
+void DisplayWorker::queueMonitorModeBySize(Monitor *mon, const int width, const int height)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+    m_transaction.calls << qMakePair(mon, PendingCall { mon->name(), "SetModeBySize", [ = ](MonitorInter *inter) {
+        return QDBusPendingCall(inter->SetModeBySize(static_cast<ushort>(width), static_cast<ushort>(height)));
+    }});
+}
+
+void DisplayWorker::queueMonitorRotate(Monitor *mon, const quint16 rotate)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+    m_transaction.calls << qMakePair(mon, PendingCall { mon->name(), "SetRotation", [ = ](MonitorInter *inter) {
+        return QDBusPendingCall(inter->SetRotation(rotate));
+    }});
+}
+
+void DisplayWorker::queueMonitorScale(Monitor *mon, const double scale)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+    // 缩放比例是 Appearance 中所有显示器的一个整体配置，提交时只需要设置一次
+    if (mon && scale >= 1.0) {
+        mon->setScale(scale);
+    }
+    m_transaction.scaleChanged = true;
+}
+
+void DisplayWorker::commitTransaction(bool apply)
+{
+    Q_ASSERT(m_transaction.depth > 0);
+
+    m_transaction.apply |= apply;
+    if (--m_transaction.depth > 0)
+        return;
+
+    // 所有调用不等待返回直接发出，DBus 会按顺序送达
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    QHash<QString, PendingCall> calls;
+    for (int i = 0; i < m_transaction.calls.size(); ++i) {
+        const auto &item = m_transaction.calls.at(i);
+        MonitorInter *inter = m_monitors.value(item.first);
+        if (!inter) {
+            qWarning() << "monitor removed before commit:" << item.second.monitor << item.second.method;
+            continue;
         }
-        watcher->deleteLater();
+
+        const QString &key = QString::number(i);
+        calls.insert(key, item.second);
+        batch->addCall(key, item.second.call(inter));
+    }
+
+    if (m_transaction.scaleChanged) {
+        QMap<QString, double> scalemap;
+        for (Monitor *m : m_model->monitorList()) {
+            scalemap[m->name()] = m_model->monitorScale(m);
+        }
+        calls.insert("scale", PendingCall { QString(), "SetScreenScaleFactors", nullptr });
+        batch->addCall("scale", m_appearanceInter->SetScreenScaleFactors(scalemap));
+    }
+
+    const bool needApply = m_transaction.apply;
+    m_transaction.apply = false;
+    m_transaction.scaleChanged = false;
+    m_transaction.calls.clear();
+
+    ++m_transactionsInFlight;
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        batch->deleteLater();
+
+        QStringList errors;
+        for (auto it = calls.cbegin(); it != calls.cend(); ++it) {
+            if (!batch->hasError(it.key()))
+                continue;
+
+            const QString &error = QString("%1 %2: %3").arg(it.value().monitor, it.value().method, batch->error(it.key()).message());
+            qWarning() << "display config call failed:" << error;
+            errors << error;
+        }
+        if (!errors.isEmpty())
+            m_transactionFailed = true;
+
+        --m_transactionsInFlight;
+        if (m_transactionsInFlight == 0) {
+            if (m_transactionFailed) {
+                // 有调用失败时不应用剩下的修改，撤销已经设置的配置，缩放比例重新从 Appearance 获取
+                m_transactionFailed = false;
+                m_applyPending = false;
+                m_displayInter.ResetChanges();
+
+                QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_appearanceInter->GetScreenScaleFactors());
+                connect(watcher, &QDBusPendingCallWatcher::finished, this, &DisplayWorker::onGetScreenScalesFinished);
+            } else if (needApply || m_applyPending) {
+                m_applyPending = false;
+                applyChanges();
+            }
+        }
+
+        if (!errors.isEmpty())
+            Q_EMIT configurationFailed(errors);
     });
-    watcher->waitForFinished();
+
+    batch->start();
+    if (m_displayInter.sync())
+        batch->waitForFinished();
 }
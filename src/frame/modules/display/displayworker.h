@@ -14,13 +14,16 @@
 #include <com_deepin_daemon_power.h>
 
 #include <QGSettings>
-#include <QMutex>
-#include <QMutexLocker>
+#include <QSet>
+
+#include <functional>
 
 using DisplayInter = com::deepin::daemon::Display;
 using AppearanceInter = com::deepin::daemon::Appearance;
 using PowerInter = com::deepin::daemon::Power;
 
+class DBusCallCoalescer;
+
 namespace dcc {
 
 namespace display {
@@ -36,6 +39,16 @@ public:
 
     void active();
 
+    // 显示配置事务：begin 之后的修改先记录下来，commit 时同时发出，全部返回后只 ApplyChanges 一次
+    // 可以嵌套，只有最外层的 commit 才会真正发出
+    void beginTransaction();
+    void queueMonitorPosition(Monitor *mon, const int x, const int y);
+    void queueMonitorMode(Monitor *mon, const int mode);
+    void queueMonitorModeBySize(Monitor *mon, const int width, const int height);
+    void queueMonitorRotate(Monitor *mon, const quint16 rotate);
+    void queueMonitorScale(Monitor *mon, const double scale);
+    void commitTransaction(bool apply = true);
+
 public Q_SLOTS:
     void saveChanges();
     void switchMode(const int mode, const QString &name);
@@ -66,12 +79,15 @@ private Q_SLOTS:
     void onGetScreenScalesFinished(QDBusPendingCallWatcher *w);
 
 private:
-    void monitorAdded(const QString &path);
+    void monitorsAdded(const QStringList &paths);
+    QPair<Monitor *, MonitorInter *> monitorCreated(const QString &path, const QVariantMap &properties);
+    void loadMonitorBrightnessAbility(const QList<QPair<Monitor *, MonitorInter *>> &monitors);
     void monitorRemoved(const QString &path);
-    void handleSetBrightnessRequest();
 
 Q_SIGNALS:
     void requestUpdateModeList();
+    // 事务中有调用失败，修改已撤销，每一项为 "显示器 方法: 错误信息"
+    void configurationFailed(const QStringList &errors);
 
 private:
     DisplayModel *m_model;
@@ -80,18 +96,29 @@ private:
     QGSettings *m_dccSettings;
     AppearanceInter *m_appearanceInter;
     QMap<Monitor *, MonitorInter *> m_monitors;
+    QStringList m_monitorPaths;         // Display 服务当前的显示器列表
+    QSet<QString> m_loadingMonitors;    // 正在获取属性、还未加入 model 的显示器
     double m_currentScale;
     bool m_updateScale;
     QTimer *m_timer;
 
-    PowerInter *m_powerInter;
+    struct PendingCall {
+        QString monitor;
+        QString method;
+        std::function<QDBusPendingCall(MonitorInter *)> call;
+    };
     struct {
-        QMutex  m_brightnessMutex;
-        bool    m_hasPendingRequest = false;
-        bool    m_hasWaitingRequest = false;
-        double  m_brightnessValue = 0;
-        QString m_monitorName;
-    }m_brightness;
+        int depth = 0;
+        bool apply = false;     // 任一层 commit 要求 ApplyChanges
+        bool scaleChanged = false;
+        QList<QPair<Monitor *, PendingCall>> calls;
+    } m_transaction;
+    int m_transactionsInFlight;
+    bool m_applyPending;
+    bool m_transactionFailed;   // 正在进行的事务中有调用失败
+
+    PowerInter *m_powerInter;
+    DBusCallCoalescer *m_sliderCalls;   // 亮度、色温等滑动条设置，拖动时只发送最新的值
 };
 
 } // namespace display
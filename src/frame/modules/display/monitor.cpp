@@ -164,31 +164,43 @@ bool compareResolution(const Resolution &first, const Resolution &second)
     return false;
 }
 
-void Monitor::setModeList(const ResolutionList &modeList)
+/**
+ * @brief 分辨率下限由 gsettings 的 resolutionConfig 配置，只在第一次使用时读取
+ */
+static QSize MinimumMode()
 {
-    m_modeList.clear();
-    // NOTE: limit resolution by gsettings config
-    QGSettings *settings = new QGSettings("com.deepin.dde.control-center", QByteArray(), this);
-    QStringList value = settings->get("resolutionConfig").toString().split("*");
-    settings->deleteLater();
-
-    QList<int> miniMode;
-    for (auto str : value) {
-        bool ok;
-        int res = str.toInt(&ok);
-        if (ok) {
-            miniMode << res;
+    static const QSize miniMode = [] {
+        QGSettings settings("com.deepin.dde.control-center", QByteArray());
+        const QStringList &value = settings.get("resolutionConfig").toString().split("*");
+
+        QList<int> mode;
+        for (auto str : value) {
+            bool ok;
+            int res = str.toInt(&ok);
+            if (ok) {
+                mode << res;
+            }
         }
-    }
 
-    if (miniMode.size() != 2) {
-        miniMode.clear();
-        miniMode << 1024 << 768;
-    }
+        return mode.size() == 2 ? QSize(mode.at(0), mode.at(1)) : QSize(1024, 768);
+    }();
+
+    return miniMode;
+}
 
+void Monitor::setModeList(const ResolutionList &modeList)
+{
+    m_modeList.clear();
+    m_resolutionIndex.clear();
+    m_modeIndex.clear();
+
+    // NOTE: limit resolution by gsettings config
+    const QSize &miniMode = MinimumMode();
     for (auto m : modeList) {
-        if (m.width() >= miniMode.at(0) && m.height() >= miniMode.at(1)) {
+        if (m.width() >= miniMode.width() && m.height() >= miniMode.height()) {
             m_modeList.append(m);
+            m_resolutionIndex.insert(resolutionKey(m));
+            m_modeIndex.insert(modeKey(m));
         }
     }
     qSort(m_modeList.begin(), m_modeList.end(), compareResolution);
@@ -196,7 +208,6 @@ void Monitor::setModeList(const ResolutionList &modeList)
     Q_EMIT modelListChanged(m_modeList);
 }
 
-
 void Monitor::setAvailableFillModes(const QStringList &fillModeList)
 {
     if (m_fillModeList == fillModeList)
@@ -251,30 +262,32 @@ bool Monitor::isSameResolution(const Resolution &r1, const Resolution &r2)
 
 bool Monitor::isSameRatefresh(const Resolution &r1, const Resolution &r2)
 {
-    return QString::number(r1.rate(), 'g', 4) == QString::number(r2.rate(), 'g', 4);
+    return rateKey(r1.rate()) == rateKey(r2.rate());
 }
 
-bool Monitor::hasResolution(const Resolution &r)
+int Monitor::rateKey(const double rate)
 {
-    for (auto m : m_modeList) {
-        if (isSameResolution(m, r)) {
-            return true;
-        }
-    }
+    return qRound(QString::number(rate, 'g', 4).toDouble() * 1000);
+}
 
-    return false;
+quint32 Monitor::resolutionKey(const Resolution &r)
+{
+    return (quint32(r.width()) << 16) | (quint32(r.height()) & 0xffff);
 }
 
-bool Monitor::hasResolutionAndRate(const Resolution &r)
+quint64 Monitor::modeKey(const Resolution &r)
 {
-    for (auto m : m_modeList) {
-        if (QString::number(m.rate(), 'g', 4) == QString::number(r.rate(), 'g', 4)  && m.width() == r.width() && m.height() == r.height()) {
-            return true;
-        }
-    }
+    return (quint64(resolutionKey(r)) << 32) | quint32(rateKey(r.rate()));
+}
 
+bool Monitor::hasResolution(const Resolution &r) const
+{
+    return m_resolutionIndex.contains(resolutionKey(r));
+}
 
-    return false;
+bool Monitor::hasResolutionAndRate(const Resolution &r) const
+{
+    return m_modeIndex.contains(modeKey(r));
 }
 
 bool Monitor::hasRatefresh(const double r)
@@ -7,6 +7,7 @@
 
 #include <QObject>
 #include <QScreen>
+#include <QSet>
 
 #include <com_deepin_daemon_display_monitor.h>
 
@@ -17,11 +18,13 @@ namespace dcc {
 namespace display {
 
 class DisplayWorker;
+class DisplayModel;
 class TouchscreenWorker;
 class Monitor : public QObject
 {
     Q_OBJECT
     friend class DisplayWorker;
+    friend class DisplayModel;
     friend class TouchscreenWorker;
 
 public:
@@ -92,8 +95,13 @@ Q_SIGNALS:
 public:
     static bool isSameResolution(const Resolution &r1, const Resolution &r2);
     static bool isSameRatefresh(const Resolution &r1, const Resolution &r2);
-    bool hasResolution(const Resolution &r);
-    bool hasResolutionAndRate(const Resolution &r);
+    // 模式索引的键，分辨率由宽高组成，刷新率以毫赫兹为单位
+    // 刷新率先按界面显示的 4 位有效数字取整，界面上显示相同的刷新率视为同一个
+    static int rateKey(const double rate);
+    static quint32 resolutionKey(const Resolution &r);
+    static quint64 modeKey(const Resolution &r);
+    bool hasResolution(const Resolution &r) const;
+    bool hasResolutionAndRate(const Resolution &r) const;
     bool hasRatefresh(const double r);
     QScreen *getQScreen();
     void setPrimary(const QString &primaryName);
@@ -140,6 +148,8 @@ private:
     Resolution m_currentMode;
     QList<quint16> m_rotateList;
     QList<Resolution> m_modeList;
+    QSet<quint32> m_resolutionIndex;
+    QSet<quint64> m_modeIndex;
     bool m_enable;
     bool m_canBrightness;
     Resolution m_bestMode;
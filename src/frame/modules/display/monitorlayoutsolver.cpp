@@ -0,0 +1,552 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "monitorlayoutsolver.h"
+
+#include <QLineF>
+
+#include <algorithm>
+#include <math.h>
+
+using namespace dcc::display;
+
+constexpr qreal MonitorLayoutSolver::AdsorptionSpace;
+
+namespace {
+
+// 与 MonitorProxyWidget::justIntersectRect 一致，内缩一个像素用于判断重叠
+inline QRectF justIntersectRect(const QRectF &rect)
+{
+    return rect.adjusted(1, 1, -1, -1);
+}
+
+// 与 MonitorProxyWidget::boundingRectEx 一致，外扩一点用于判断相接
+inline QRectF boundingRectEx(const QRectF &rect)
+{
+    return rect.adjusted(-0.05, -0.05, 0.05, 0.05);
+}
+
+}
+
+MonitorLayoutSolver::MonitorLayoutSolver()
+    : m_overlap(false)
+    , m_maxWidth(0)
+    , m_indexDirty(true)
+{
+
+}
+
+void MonitorLayoutSolver::setRects(const QVector<QRectF> &rects)
+{
+    m_rects = rects;
+    m_indexDirty = true;
+}
+
+void MonitorLayoutSolver::setRect(int index, const QRectF &rect)
+{
+    Q_ASSERT(index >= 0 && index < m_rects.size());
+
+    m_rects[index] = rect;
+    if (m_indexDirty)
+        return;
+
+    // 拖动时只有一个块的位置变化，在有序的索引中移动这一项即可，不需要重新排序
+    auto it = std::find_if(m_leftIndex.begin(), m_leftIndex.end(), [index](const QPair<qreal, int> &item) {
+        return item.second == index;
+    });
+    Q_ASSERT(it != m_leftIndex.end());
+    it->first = rect.left();
+    while (it != m_leftIndex.begin() && *(it - 1) > *it) {
+        std::iter_swap(it - 1, it);
+        --it;
+    }
+    while (it + 1 != m_leftIndex.end() && *(it + 1) < *it) {
+        std::iter_swap(it + 1, it);
+        ++it;
+    }
+    m_maxWidth = std::max(m_maxWidth, rect.width());
+}
+
+void MonitorLayoutSolver::moveBy(int index, const QPointF &offset)
+{
+    setRect(index, m_rects.at(index).translated(offset));
+}
+
+QRectF MonitorLayoutSolver::boundingRect() const
+{
+    QRectF rect;
+    for (const QRectF &r : m_rects)
+        rect |= r;
+
+    return rect;
+}
+
+void MonitorLayoutSolver::buildIndex() const
+{
+    if (!m_indexDirty)
+        return;
+
+    m_leftIndex.clear();
+    m_leftIndex.reserve(m_rects.size());
+    m_maxWidth = 0;
+    for (int i = 0; i < m_rects.size(); ++i) {
+        m_leftIndex.append(qMakePair(m_rects.at(i).left(), i));
+        m_maxWidth = std::max(m_maxWidth, m_rects.at(i).width());
+    }
+    std::sort(m_leftIndex.begin(), m_leftIndex.end());
+    m_indexDirty = false;
+}
+
+/**
+ * @brief 查找 x 方向与 (left, right) 有交集的块，结果按序号排列，保证和逐个比较时的遍历顺序一致
+ */
+QVector<int> MonitorLayoutSolver::candidates(qreal left, qreal right, int except) const
+{
+    buildIndex();
+
+    QVector<int> result;
+    auto it = std::lower_bound(m_leftIndex.cbegin(), m_leftIndex.cend(), right, [](const QPair<qreal, int> &item, qreal value) {
+        return item.first < value;
+    });
+
+    // 左边界不小于 left - m_maxWidth 的块才可能和区间相交
+    while (it != m_leftIndex.cbegin()) {
+        --it;
+        if (it->first <= left - m_maxWidth)
+            break;
+        if (it->second != except && m_rects.at(it->second).right() > left)
+            result.append(it->second);
+    }
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+//自动吸附
+//保证 bufferboundingRect 相交且 boundingRect 不相交，保证移动的块始终在其他块的外边缘移动
+QPointF MonitorLayoutSolver::adsorption(int moving) const
+{
+    const QRectF &pw = m_rects.at(moving);
+
+    qreal top = 0.0;
+    qreal bottom = 0.0;
+    qreal right = 0.0;
+    qreal left = 0.0;
+
+    qreal topLeft = 0.0;
+    qreal topRight = 0.0;
+    qreal bottomLeft = 0.0;
+    qreal bottomRight = 0.0;
+    qreal rightTop = 0.0;
+    qreal rightBottom = 0.0;
+    qreal leftTop = 0.0;
+    qreal leftBottom = 0.0;
+
+    auto minMoveLen = [](qreal temp, qreal &len) {
+        if (fabs(len) > 0.0) {
+            if (fabs(temp) < fabs(len)) len = temp;
+        } else {
+            len = temp;
+        }
+    };
+
+    // 四周吸附区域之外的块不会参与计算
+    for (int i : candidates(pw.left() - AdsorptionSpace, pw.right() + AdsorptionSpace, moving)) {
+        const QRectF &item = m_rects.at(i);
+        // 只有边相接不算重叠，继续参与边对齐(原来 QPolygonF::intersects 先比较外接矩形，结果相同)
+        if (pw.intersects(item))
+            return QPointF(0.0, 0.0);
+
+        const QRectF &buffer = item.adjusted(-AdsorptionSpace, -AdsorptionSpace, AdsorptionSpace, AdsorptionSpace);
+        if (pw.intersects(QRectF(QPointF(item.left(), buffer.top()), QPointF(item.right(), item.top())))) {
+            //上相交
+            minMoveLen(item.top() - pw.bottom(), top);
+
+            //判断边对齐
+            minMoveLen(item.right() - pw.right(), topLeft);
+            minMoveLen(item.left() - pw.left(), topRight);
+        } else if (pw.intersects(QRectF(QPointF(item.left(), item.bottom()), QPointF(item.right(), buffer.bottom())))) {
+            //下相交
+            minMoveLen(item.bottom() - pw.top(), bottom);
+
+            //判断边对齐的可能
+            minMoveLen(item.right() - pw.right(), bottomLeft);
+            minMoveLen(item.left() - pw.left(), bottomRight);
+        } else if (pw.intersects(QRectF(QPointF(buffer.left(), item.top()), QPointF(item.left(), item.bottom())))) {
+            //左相交
+            minMoveLen(item.left() - pw.right(), left);
+
+            //判断边对齐的可能
+            minMoveLen(item.top() - pw.top(), leftTop);
+            minMoveLen(item.bottom() - pw.bottom(), leftBottom);
+        } else if (pw.intersects(QRectF(QPointF(item.right(), item.top()), QPointF(buffer.right(), item.bottom())))) {
+            //右相交
+            minMoveLen(item.right() - pw.left(), right);
+
+            //判断边对齐的可能
+            minMoveLen(item.top() - pw.top(), rightTop);
+            minMoveLen(item.bottom() - pw.bottom(), rightBottom);
+        }
+    }
+
+    auto edgeAlignment = [](qreal x1, qreal x2) -> qreal {
+        if (fabs(x1) > fabs(x2))
+            return fabs(x2) < AdsorptionSpace ? x2 : 0;
+        else
+            return fabs(x1) < AdsorptionSpace ? x1 : 0;
+    };
+
+    QPointF autoAdsorptionPos(0.0, 0.0), edgeAlignmentPos(0.0, 0.0);
+
+    if (qFuzzyIsNull(top)) {
+        edgeAlignmentPos.setX(edgeAlignment(bottomRight, bottomLeft));
+        autoAdsorptionPos.setY(bottom);
+    } else if (qFuzzyIsNull(bottom)) {
+        edgeAlignmentPos.setX(edgeAlignment(topRight, topLeft));
+        autoAdsorptionPos.setY(top);
+    } else {
+        autoAdsorptionPos.setY((fabs(top) < fabs(bottom)) ? top : bottom);
+        edgeAlignmentPos.setX((fabs(top) < fabs(bottom)) ? edgeAlignment(topRight, topLeft) : edgeAlignment(bottomRight, bottomLeft));
+    }
+
+    if (qFuzzyIsNull(left)) {
+        autoAdsorptionPos.setX(right);
+        edgeAlignmentPos.setY(edgeAlignment(rightTop, rightBottom));
+    } else if (qFuzzyIsNull(right)) {
+        autoAdsorptionPos.setX(left);
+        edgeAlignmentPos.setY(edgeAlignment(leftTop, leftBottom));
+    } else {
+        autoAdsorptionPos.setX((fabs(left) < fabs(right)) ? left : right);
+        edgeAlignmentPos.setY((fabs(left) < fabs(right)) ? edgeAlignment(leftTop, leftBottom) : edgeAlignment(rightTop, rightBottom));
+    }
+
+    if (!qFuzzyIsNull(autoAdsorptionPos.x()))
+        edgeAlignmentPos.setX(0.0);
+
+    if (!qFuzzyIsNull(autoAdsorptionPos.y()))
+        edgeAlignmentPos.setY(0.0);
+
+    return edgeAlignmentPos + autoAdsorptionPos;
+}
+
+//多屏排序算法
+//1、判断被移动块和其他块之间的位置关系来进行图形拼接移动
+//2、出现覆盖时返回 shelter，由调用方决定回弹还是重新拼接
+MonitorLayoutSolver::SortResult MonitorLayoutSolver::sortAlgo(int moving, const QVector<int> &sortItems) const
+{
+    SortResult result;
+
+    QVector<int> items = sortItems;
+    if (items.isEmpty()) {
+        for (int i = 0; i < m_rects.size(); ++i)
+            items.append(i);
+    }
+
+    const QRectF moveRect = m_rects.at(moving);
+    const QRectF moveItemIntersect = justIntersectRect(moveRect);
+
+    QVector<int> others;
+    bool isAutoAdsorption = false;
+    bool isIntersect = false;
+    qreal intersectedArea = 0.0; //相交的面积
+
+    for (int i : items) {
+        if (i == moving)
+            continue;
+
+        const QRectF &item = m_rects.at(i);
+        const QRectF &rect = moveItemIntersect.intersected(item);
+        intersectedArea += rect.width() * rect.height();
+
+        //1、移动块完全覆盖一个块 2、移动块与另外一个块十字相交时 执行自动回弹操作
+        if (moveRect.contains(item)
+                || (rect.top() < moveItemIntersect.top() && rect.bottom() > moveItemIntersect.bottom() && qFuzzyCompare(rect.left(), moveItemIntersect.left()) && qFuzzyCompare(rect.right(), moveItemIntersect.right()))
+                || (rect.right() < moveItemIntersect.right() && rect.left() > moveItemIntersect.left() && qFuzzyCompare(rect.top(), moveItemIntersect.top()) && qFuzzyCompare(rect.bottom(), moveItemIntersect.bottom()))) {
+            result.shelter = true;
+        }
+
+        //要么不相交,要相交就是要点线相交的
+        if (!moveItemIntersect.intersects(item) && moveRect.intersects(item))
+            isAutoAdsorption = true;
+
+        //出现相交的情况
+        if (moveItemIntersect.intersects(item) && moveRect.intersects(item))
+            isIntersect = true;
+
+        others.append(i);
+    }
+
+    //移动块被完全包含在其他的块
+    if (qFuzzyCompare(moveItemIntersect.width() * moveItemIntersect.height(), intersectedArea))
+        result.shelter = true;
+
+    if (result.shelter || others.isEmpty())
+        return result;
+
+    auto sortedBy = [this](QVector<int> list, qreal (QRectF::*edge)() const) {
+        std::stable_sort(list.begin(), list.end(), [this, edge](int i1, int i2) {
+            return (m_rects.at(i1).*edge)() < (m_rects.at(i2).*edge)();
+        });
+        return list;
+    };
+
+    // 预移动之后与其他块重叠的块
+    auto intersectedItems = [this, &others](const QRectF &rect) {
+        QVector<int> list;
+        for (int i : others) {
+            if (rect.intersects(m_rects.at(i)))
+                list.append(i);
+        }
+        return list;
+    };
+
+    //移动块到其他块中心点的距离排序
+    QVector<QPair<int, qreal>> centerPosLen;
+    for (int i : others)
+        centerPosLen.append(qMakePair(i, QLineF(m_rects.at(i).center(), moveRect.center()).length()));
+    std::stable_sort(centerPosLen.begin(), centerPosLen.end(), [](const QPair<int, qreal> &item1, const QPair<int, qreal> &item2) {
+        return item1.second < item2.second;
+    });
+
+    //移动块在左排、右排、上排、下排中的位置，判定覆盖几个块
+    const int nItemSize = others.size();
+    int nBIndexLeft = 0, nBIndexRight = 0, nBIndexTop = 0, nBIndexBottom = 0;
+    for (int i : others) {
+        const QRectF &item = m_rects.at(i);
+        if (item.left() < moveRect.right())
+            ++nBIndexLeft;
+        if (item.right() <= moveRect.left())
+            ++nBIndexRight;
+        if (item.top() < moveRect.bottom())
+            ++nBIndexTop;
+        if (item.bottom() <= moveRect.top())
+            ++nBIndexBottom;
+    }
+
+    qreal g_dx = 0.0;
+    qreal g_dy = 0.0;
+    bool g_bXYTogetherMoved = false; //标志XY方向是否一起移动，其余情况按哪个方向离得近向哪个方向移动
+
+    //说明移动块在其他块X坐标有重合
+    if (nBIndexLeft != 0 && nBIndexRight != nItemSize) {
+        QVector<int> lstActivedItemsX;
+        for (const auto &pair : centerPosLen) {
+            const QRectF &item = m_rects.at(pair.first);
+            if (item.left() < moveRect.right() && item.right() > moveRect.left())
+                lstActivedItemsX.append(pair.first);
+        }
+        lstActivedItemsX.append(moving);
+
+        const int nIndexTop = sortedBy(lstActivedItemsX, &QRectF::top).indexOf(moving);
+        lstActivedItemsX = sortedBy(lstActivedItemsX, &QRectF::bottom);
+        const int nIndexBottom = lstActivedItemsX.indexOf(moving);
+
+        //先做预移动，如果有重合，把重合块加入激活块重新排序
+        if (nIndexTop == nIndexBottom) {
+            const bool isTop = nIndexTop == 0;
+            const qreal dy = isTop ? m_rects.at(lstActivedItemsX.first()).top() - moveRect.bottom()
+                                   : m_rects.at(lstActivedItemsX.last()).bottom() - moveRect.top();
+
+            for (int i : intersectedItems(moveRect.translated(0, dy))) {
+                if (!lstActivedItemsX.contains(i))
+                    lstActivedItemsX.append(i);
+            }
+            lstActivedItemsX = sortedBy(lstActivedItemsX, &QRectF::top);
+            const int nIndexTopTemp = lstActivedItemsX.indexOf(moving);
+            if (!isTop)
+                lstActivedItemsX = sortedBy(lstActivedItemsX, &QRectF::bottom);
+            lstActivedItemsX.removeOne(moving);
+
+            if (!lstActivedItemsX.isEmpty()) {
+                if (nIndexTopTemp == 0)
+                    g_dy = m_rects.at(lstActivedItemsX.first()).top() - moveRect.bottom();
+                else
+                    g_dy = m_rects.at(lstActivedItemsX.last()).bottom() - moveRect.top();
+            }
+        }
+    }
+
+    //说明移动块在其他块Y坐标有重合
+    if (nBIndexTop != 0 && nBIndexBottom != nItemSize) {
+        QVector<int> lstActivedItemsY;
+        for (const auto &pair : centerPosLen) {
+            const QRectF &item = m_rects.at(pair.first);
+            if (item.top() < moveRect.bottom() && item.bottom() > moveRect.top())
+                lstActivedItemsY.append(pair.first);
+        }
+        lstActivedItemsY.append(moving);
+
+        const int nIndexLeft = sortedBy(lstActivedItemsY, &QRectF::left).indexOf(moving);
+        lstActivedItemsY = sortedBy(lstActivedItemsY, &QRectF::right);
+        const int nIndexRight = lstActivedItemsY.indexOf(moving);
+
+        if (nIndexLeft == nIndexRight) {
+            const bool isLeft = nIndexLeft == 0;
+            const qreal dx = isLeft ? m_rects.at(lstActivedItemsY.first()).left() - moveRect.right()
+                                    : m_rects.at(lstActivedItemsY.last()).right() - moveRect.left();
+
+            for (int i : intersectedItems(moveRect.translated(dx, 0))) {
+                if (!lstActivedItemsY.contains(i))
+                    lstActivedItemsY.append(i);
+            }
+            lstActivedItemsY = sortedBy(lstActivedItemsY, &QRectF::left);
+            const int nIndexLeftTemp = lstActivedItemsY.indexOf(moving);
+            if (!isLeft)
+                lstActivedItemsY = sortedBy(lstActivedItemsY, &QRectF::right);
+            lstActivedItemsY.removeOne(moving);
+
+            if (!lstActivedItemsY.isEmpty()) {
+                if (nIndexLeftTemp == 0)
+                    g_dx = m_rects.at(lstActivedItemsY.first()).left() - moveRect.right();
+                else
+                    g_dx = m_rects.at(lstActivedItemsY.last()).right() - moveRect.left();
+            }
+        }
+    }
+
+    //说明移动块在其他块的四周，找距离最近的顶点
+    auto nearestVertex = [this, &others](QPointF (QRectF::*vertex)() const, const QPointF &movePos) {
+        int nearest = others.first();
+        qreal minLen = QLineF((m_rects.at(nearest).*vertex)(), movePos).length();
+        for (int i : others) {
+            const qreal len = QLineF((m_rects.at(i).*vertex)(), movePos).length();
+            if (len < minLen) {
+                minLen = len;
+                nearest = i;
+            }
+        }
+        return (m_rects.at(nearest).*vertex)() - movePos;
+    };
+
+    QPointF dPos;
+    //LT 左上
+    if (nBIndexLeft == 0 && nBIndexTop == 0) {
+        dPos = nearestVertex(&QRectF::topLeft, moveRect.bottomRight());
+        g_bXYTogetherMoved = true;
+    }
+    //LB 左下
+    if (nBIndexLeft == 0 && nBIndexBottom == nItemSize) {
+        dPos = nearestVertex(&QRectF::bottomLeft, moveRect.topRight());
+        g_bXYTogetherMoved = true;
+    }
+    //RT 右上
+    if (nBIndexRight == nItemSize && nBIndexTop == 0) {
+        dPos = nearestVertex(&QRectF::topRight, moveRect.bottomLeft());
+        g_bXYTogetherMoved = true;
+    }
+    //RB 右下
+    if (nBIndexRight == nItemSize && nBIndexBottom == nItemSize) {
+        dPos = nearestVertex(&QRectF::bottomRight, moveRect.topLeft());
+        g_bXYTogetherMoved = true;
+    }
+    if (g_bXYTogetherMoved) {
+        g_dx = dPos.x();
+        g_dy = dPos.y();
+    }
+
+    //是自动吸附并且没有相交的情况，不需要要移动
+    if (isAutoAdsorption && !isIntersect) {
+        result.offset = QPointF(0.0, 0.0);
+    } else if (g_bXYTogetherMoved || qFuzzyIsNull(g_dx) || qFuzzyIsNull(g_dy)) {
+        result.offset = QPointF(g_dx, g_dy);
+    } else {
+        //X和Y都不为0的情况下，哪个移动的绝对值小移动哪一个
+        result.offset = fabs(g_dx) < fabs(g_dy) ? QPointF(g_dx, 0) : QPointF(0, g_dy);
+    }
+
+    return result;
+}
+
+//多屏自动调整
+//移动之后没有完全连通时，其他屏幕集群依次向移动块所在的集群拼接
+bool MonitorLayoutSolver::autoAdjust(int moving)
+{
+    updateConnectedState();
+    if (isFullyConnected())
+        return true;
+
+    //获取屏幕集群
+    QVector<QVector<int>> clusters;
+    QVector<bool> visited(m_rects.size(), false);
+    QVector<int> sortItems;
+    for (int i = 0; i < m_rects.size(); ++i) {
+        if (visited.at(i))
+            continue;
+
+        const QVector<int> &domain = connectedDomain(i);
+        for (int k : domain)
+            visited[k] = true;
+
+        //中心屏幕集群(包含移动块)
+        if (domain.contains(moving))
+            sortItems = domain;
+        else
+            clusters.append(domain);
+    }
+
+    bool isRestore = false;
+    for (const QVector<int> &cluster : clusters) {
+        for (int item : cluster) {
+            const SortResult &result = sortAlgo(item, sortItems);
+            if (result.shelter)
+                isRestore = true;
+            else
+                moveBy(item, result.offset);
+
+            sortItems.append(item);
+        }
+    }
+
+    //自动调整完毕后,更新连通域
+    updateConnectedState();
+    return !isRestore;
+}
+
+//更新连通状态，相接(外扩后相交且内缩后不相交)的块视为连通
+bool MonitorLayoutSolver::updateConnectedState()
+{
+    bool isIntersect = false;
+    m_connected = QVector<QVector<int>>(m_rects.size());
+    for (int i = 0; i < m_rects.size(); ++i) {
+        const QRectF &rectEx = boundingRectEx(m_rects.at(i));
+        const QRectF &rectIntersect = justIntersectRect(m_rects.at(i));
+
+        for (int j : candidates(rectEx.left(), rectEx.right(), i)) {
+            const QRectF &item = m_rects.at(j);
+            if (rectIntersect.intersects(item))
+                isIntersect = true;
+            else if (rectEx.intersects(item))
+                m_connected[i].append(j);
+        }
+    }
+    m_overlap = isIntersect;
+
+    return isIntersect;
+}
+
+//获取连通域，需要先调用 updateConnectedState
+QVector<int> MonitorLayoutSolver::connectedDomain(int index) const
+{
+    QVector<int> domain { index };
+    if (index < 0 || index >= m_connected.size())
+        return domain;
+
+    QVector<bool> visited(m_connected.size(), false);
+    visited[index] = true;
+    for (int k = 0; k < domain.size(); ++k) {
+        for (int i : m_connected.at(domain.at(k))) {
+            if (!visited.at(i)) {
+                visited[i] = true;
+                domain.append(i);
+            }
+        }
+    }
+
+    return domain;
+}
+
+bool MonitorLayoutSolver::isFullyConnected() const
+{
+    return m_rects.isEmpty() || connectedDomain(0).size() == m_rects.size();
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MONITORLAYOUTSOLVER_H
+#define MONITORLAYOUTSOLVER_H
+
+#include <QPair>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+namespace dcc {
+
+namespace display {
+
+/**
+ * @brief 多屏拼接的几何计算
+ * 只处理场景坐标下的矩形数组，不依赖 QGraphicsItem，屏幕示意图(MonitorsGround)把每个屏幕块的位置
+ * 同步进来，调用计算接口得到需要移动的距离后再移动对应的块。
+ * 按左边界排序的区间索引用于查找边缘附近的候选块，拖动时不需要和所有块两两比较。
+ */
+class MonitorLayoutSolver
+{
+public:
+    // 自动吸附和边对齐的距离，与 MonitorProxyWidget::bufferboundingRect 一致
+    static constexpr qreal AdsorptionSpace = 200;
+
+    struct SortResult {
+        QPointF offset;         // 移动块需要移动的距离
+        bool shelter = false;   // 移动块与其他块出现覆盖，需要回弹或重新拼接
+    };
+
+    MonitorLayoutSolver();
+
+    void setRects(const QVector<QRectF> &rects);
+    void setRect(int index, const QRectF &rect);
+    void moveBy(int index, const QPointF &offset);
+    inline const QVector<QRectF> &rects() const { return m_rects; }
+    inline int size() const { return m_rects.size(); }
+    QRectF boundingRect() const;
+
+    // 拖动时的自动吸附，返回移动块需要移动的距离，与其他块重叠时不吸附
+    QPointF adsorption(int moving) const;
+    // 松开后的拼接，只和 sortItems 中的块计算，sortItems 为空时和所有块计算
+    SortResult sortAlgo(int moving, const QVector<int> &sortItems = QVector<int>()) const;
+    // 拼接后没有完全连通时，把其他屏幕集群依次拼接到移动块所在的集群，返回 false 表示出现覆盖需要回弹
+    bool autoAdjust(int moving);
+
+    // 更新连通状态，返回是否有块重叠
+    bool updateConnectedState();
+    inline const QVector<QVector<int>> &connectedState() const { return m_connected; }
+    QVector<int> connectedDomain(int index) const;
+    bool isFullyConnected() const;
+    inline bool hasOverlap() const { return m_overlap; }
+
+private:
+    void buildIndex() const;
+    QVector<int> candidates(qreal left, qreal right, int except) const;
+
+private:
+    QVector<QRectF> m_rects;
+    QVector<QVector<int>> m_connected;   // 每个块相接的块
+    bool m_overlap;
+
+    // 区间索引 <左边界, 序号>，按左边界排序，配合最大宽度可以二分查找 x 方向有交集的块
+    mutable QVector<QPair<qreal, int>> m_leftIndex;
+    mutable qreal m_maxWidth;
+    mutable bool m_indexDirty;
+};
+
+} // namespace display
+
+} // namespace dcc
+
+#endif // MONITORLAYOUTSOLVER_H
@@ -7,9 +7,6 @@
 #include "displaymodel.h"
 #include "window/dconfigwatcher.h"
 
-#include <math.h>
-#include <float.h>
-
 #include <QScroller>
 #include <QScrollArea>
 
@@ -142,6 +139,7 @@ void MonitorsGround::initMonitorProxyWidget(Monitor *mon)
         }
         m_movingItem = pw;
         m_movingItem->setZValue(1);
+        updateLayoutRects();
     });
     connect(pw, &MonitorProxyWidget::requestMonitorRelease, this, &MonitorsGround::onRequestMonitorRelease);
     connect(pw, &MonitorProxyWidget::requestMouseMove, this, &MonitorsGround::onRequestMouseMove);
@@ -432,681 +430,61 @@ QPointF MonitorsGround::multiScreenSortAlgo(bool &isRestore, const bool isReboun
     //排列算法
     //1、寻找位置变化的屏幕块，确定为被移动的块
     //2、判断被移动块和其他块之间的位置关系来进行图形拼接移动
-    //*根据中心点判定
-
-    QList<MonitorProxyWidget *> lstActivedItemsX;
-    QList<MonitorProxyWidget *> lstActivedItemsY;
-    QList<MonitorProxyWidget *> lstNoMovedItems;
-    QList<MonitorProxyWidget *> lstShelterItems;
-
-    m_lstMoveingItemToCenterPosLen.clear();
-
-    bool isMove = true;
     isRestore = false;
-    bool isAutoAdsorption = false;
-    bool isIntersect = false;
-    qreal g_dx = 0.0;
-    qreal g_dy = 0.0;
-
-    qreal intersectedArea = 0.0; //相交的面积
-
-    QRectF moveItemIntersect, moveItemRect;
-
-    bool g_bXYTogetherMoved = false; //标志XY方向是否一起移动，其余情况按哪个方向离得近向哪个方向移动
-
+    updateLayoutRects();
 
-    moveItemIntersect = m_movingItem->mapRectToScene(m_movingItem->justIntersectRect());
-    moveItemRect = m_movingItem->mapRectToScene(m_movingItem->boundingRect());
+    QVector<int> sortItems;
+    for (auto item : m_lstSortItems)
+        sortItems.append(m_lstItems.indexOf(item));
 
-    auto mapToSceneIntersectRect = [=](MonitorProxyWidget *item) {
-        return item->mapToScene(item->justIntersectRect());
-    };
-
-    auto mapToSceneBoundingRect = [=](MonitorProxyWidget *item) {
-        return item->mapToScene(item->boundingRect());
-    };
-
-
-    for (int i = 0; i < m_lstSortItems.size(); i++) {
-
-        if (m_movingItem != m_lstSortItems[i]) {
-            QRectF rect = moveItemIntersect.intersected(m_lstSortItems[i]->mapRectToScene(m_lstSortItems[i]->boundingRect()));
-            intersectedArea += rect.width()*rect.height();
-
-            qInfo() << "rect" << rect << "moveItemRect" << moveItemRect << "moveItemIntersect" << moveItemIntersect;
-
-            //1、移动块完全覆盖一个块 2、移动块与另外一个块十字相交时 执行自动回弹操作
-            if (moveItemRect.contains(m_lstSortItems[i]->mapRectToScene(m_lstSortItems[i]->boundingRect()))
-                    || (rect.top() < moveItemIntersect.top() && rect.bottom() > moveItemIntersect.bottom() && qFuzzyCompare(rect.left(), moveItemIntersect.left()) && qFuzzyCompare(rect.right(), moveItemIntersect.right()))
-                    || (rect.right() < moveItemIntersect.right() && rect.left() > moveItemIntersect.left() && qFuzzyCompare(rect.top(), moveItemIntersect.top()) && qFuzzyCompare(rect.bottom(), moveItemIntersect.bottom()))) {
-                lstShelterItems.append(m_lstSortItems[i]);
-            }
-
-            //要么不相交,要相交就是要点线相交的
-            if (!mapToSceneIntersectRect(m_movingItem).intersects(mapToSceneBoundingRect(m_lstSortItems[i]))
-               && mapToSceneBoundingRect(m_movingItem).intersects(mapToSceneBoundingRect(m_lstSortItems[i]))) {
-                isAutoAdsorption = true;
-            }
-            //出现相交的情况
-            if (mapToSceneIntersectRect(m_movingItem).intersects(mapToSceneBoundingRect(m_lstSortItems[i]))
-                    && mapToSceneBoundingRect(m_movingItem).intersects(mapToSceneBoundingRect(m_lstSortItems[i]))) {
-                isIntersect = true;
-            }
-
-            lstNoMovedItems.append(m_lstSortItems[i]);
-        }
-    }
-
-    //移动块被完全包含在其他的块
-    if (qFuzzyCompare(moveItemIntersect.width() * moveItemIntersect.height(), intersectedArea)) {
-        qDebug() << "存在包含关系";
-        lstShelterItems.append(m_movingItem);
-    }
-
-    //移动块到其他块中心点的距离排序
-    QPointF movedPos = m_movingItem->mapToScene(m_movingItem->boundingRect().center());
-    for (auto item : lstNoMovedItems) {
-        QPointF tempPos = item->mapToScene(item->boundingRect().center());
-        qreal len = sqrt(pow(tempPos.x()-movedPos.x(),2)+pow(tempPos.y()-movedPos.y(),2));
-        m_lstMoveingItemToCenterPosLen.append(qMakePair(item,len));
-    }
-
-    //获取距离最近的块
-    std::sort(m_lstMoveingItemToCenterPosLen.begin(),m_lstMoveingItemToCenterPosLen.end(),[=](const QPair<MonitorProxyWidget *, qreal> &item1, const QPair<MonitorProxyWidget *, qreal> &item2) {
-       return item1.second < item2.second;
-    });
+    const MonitorLayoutSolver::SortResult &result = m_layout.sortAlgo(m_lstItems.indexOf(m_movingItem), sortItems);
 
     //自动回弹的触发条件: 1. 一个屏幕完全包含另一个屏的时候 2. 一个屏幕剩下的屏幕集合所包围
-    if (lstShelterItems.size() > 0) {
-        if (isMove) {
-
-            if (isRebound) {
-                autoRebound();
-                qDebug() << "自动回弹流程触发! == " << lstShelterItems.size();
-                isRestore = true;
-                return QPointF(0.0,0.0);
-            }
-            else {
-                //当改变方向时出现覆盖多个块的情况，会触发自动会弹流程，但是改变方向的上一个操作状态不存在或者说回弹到上一个状态没有意义，会导致屏幕重叠现象
-                //如果是由于方向改变导致的重叠，那就将此块移动到items外接矩形的左下角再重新执行拼接算法。
-                m_movingItem->moveBy(scene()->itemsBoundingRect().right() - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).x(),
-                                     scene()->itemsBoundingRect().bottom() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y());
-                m_movingItem->setReSplicing(true);
-                return QPointF(0.0,0.0);
-            }
+    if (result.shelter) {
+        if (isRebound) {
+            autoRebound();
+            qDebug() << "自动回弹流程触发!";
+            isRestore = true;
+        } else {
+            //当改变方向时出现覆盖多个块的情况，会触发自动会弹流程，但是改变方向的上一个操作状态不存在或者说回弹到上一个状态没有意义，会导致屏幕重叠现象
+            //如果是由于方向改变导致的重叠，那就将此块移动到items外接矩形的左下角再重新执行拼接算法。
+            m_movingItem->moveBy(scene()->itemsBoundingRect().right() - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).x(),
+                                 scene()->itemsBoundingRect().bottom() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y());
+            m_movingItem->setReSplicing(true);
         }
+        return QPointF(0.0, 0.0);
     }
-    else { //没有完全重合的情况处理逻辑
-
-        std::sort(lstNoMovedItems.begin(),lstNoMovedItems.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                  return item1->mapToScene(item1->boundingRect().bottomLeft()).x() < item2->mapToScene(item2->boundingRect().bottomLeft()).x();
-               });
-
-       //将MovedItem放入链表中排序，左排 右排，判定覆盖几个块
-       lstNoMovedItems.append(m_movingItem);
-       //左排序
-       std::sort(lstNoMovedItems.begin(),lstNoMovedItems.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-
-           if (item1 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomRight()).x() < item2->mapToScene(item2->boundingRect().bottomLeft()).x();
-           }
-           else if (item2 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomLeft()).x() < item2->mapToScene(item2->boundingRect().bottomRight()).x();
-           }
-           return item1->mapToScene(item1->boundingRect().bottomLeft()).x() < item2->mapToScene(item2->boundingRect().bottomLeft()).x();
-       });
-       int nBIndexLeft = lstNoMovedItems.indexOf(m_movingItem);
-
-       //右排序
-       std::sort(lstNoMovedItems.begin(),lstNoMovedItems.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-
-           if (item1 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomLeft()).x() < item2->mapToScene(item2->boundingRect().bottomRight()).x();
-           }
-           else if (item2 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomRight()).x() < item2->mapToScene(item2->boundingRect().bottomLeft()).x();
-           }
-           return item1->mapToScene(item1->boundingRect().bottomRight()).x() < item2->mapToScene(item2->boundingRect().bottomRight()).x();
-       });
-       int nBIndexRight = lstNoMovedItems.indexOf(m_movingItem);
-
-       //上排序
-       std::sort(lstNoMovedItems.begin(),lstNoMovedItems.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-
-           if (item1 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-           }
-           else if (item2 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-           }
-           return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-       });
-       int nBIndexTop = lstNoMovedItems.indexOf(m_movingItem);
-
-       //下排序
-       std::sort(lstNoMovedItems.begin(),lstNoMovedItems.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-
-           if (item1 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-           }
-           else if (item2 == m_movingItem) {
-               return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-           }
-           return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-       });
-       int nBIndexBottom = lstNoMovedItems.indexOf(m_movingItem);
-
-       int nItemSize = lstNoMovedItems.size() - 1;
-
-       //说明移动块在其他块X坐标有重合
-       if (nBIndexLeft != 0 && nBIndexRight != nItemSize) {
-
-           //移动X
-           //将MovedItem放入链表中排序，上排 下排，判定在Y轴移动的方向和距离
-           //处理
-           qreal movex1 = m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).x();
-           qreal movex2 = m_movingItem->mapToScene(m_movingItem->boundingRect().topRight()).x();
-
-           for (auto pair : m_lstMoveingItemToCenterPosLen) {
-               qreal x1 = pair.first->mapToScene(pair.first->boundingRect().topLeft()).x();
-               qreal x2 = pair.first->mapToScene(pair.first->boundingRect().topRight()).x();
-
-               if (!((x1 >= movex1 && x1 >= movex2) || (x2 <= movex1 && x2 <= movex2))) {
-                   lstActivedItemsX.append(pair.first);
-                }
-           }
-
-           lstActivedItemsX.append(m_movingItem);
-           //上排序
-           std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-              return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-           });
-           int nIndexTop = lstActivedItemsX.indexOf(m_movingItem);
-
-           //下排序
-           std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-              return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-           });
-           int nIndexBottom = lstActivedItemsX.indexOf(m_movingItem);
-
-           //先做预移动，如果有重合，把重合块加入激活块重新排序
-           if (nIndexTop == nIndexBottom) {
-               //移动块在最上面
-               if (nIndexTop == 0) {
-                   qreal dy = lstActivedItemsX.first()->mapToScene(lstActivedItemsX.first()->boundingRect().topLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).y();
-                   m_movingItem->moveBy(0, dy);
-                   m_graphicsScene.update();
-
-                   QList<MonitorProxyWidget *> lstShelterItemsTemp;
-                   lstNoMovedItems.removeOne(m_movingItem);
-                   for (int i = 0; i < lstNoMovedItems.size(); i++) {
-                       if (m_movingItem->mapToScene(m_movingItem->boundingRect()).intersects(lstNoMovedItems[i]->mapToScene(lstNoMovedItems[i]->boundingRect()))) {
-                           lstShelterItemsTemp.append(lstNoMovedItems[i]);
-                       }
-                   }
-
-                   if (lstShelterItemsTemp.size() >= 0) {
-                        m_movingItem->moveBy(0, -dy);//先移回去
-                        m_graphicsScene.update();
-
-                        //下排序
-                        std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-                        });
-                        //int nIndexBottomTemp = lstActivedItemsX.indexOf(m_movingItem);
-
-                        //上排序
-                        for (auto t : lstShelterItemsTemp) {
-                            if (!lstActivedItemsX.contains(t))
-                                lstActivedItemsX.append(t);
-                        }
-                        std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-                        });
-                        int nIndexTopTemp = lstActivedItemsX.indexOf(m_movingItem);
-
-                        lstActivedItemsX.removeOne(m_movingItem);
-
-                        if(!lstActivedItemsX.isEmpty()) {
-                            if (nIndexTopTemp == 0) {
-                                g_dy = lstActivedItemsX.first()->mapToScene(lstActivedItemsX.first()->boundingRect().topLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).y();
-                                qDebug() << "g_dy" << g_dy;
-                            }
-                            else {
-                                g_dy = lstActivedItemsX.last()->mapToScene(lstActivedItemsX.last()->boundingRect().bottomLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y();
-                                qDebug() << "g_dy" << g_dy;
-
-                            }
-                        }
-                   }
-               }
-                   //移动块在最下面
-               else {
-                   if(!lstActivedItemsX.contains(m_movingItem))
-                       lstActivedItemsX.append(m_movingItem);
-                   //下排序
-                   std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                      return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-                   });
-
-                   qreal dy = lstActivedItemsX.last()->mapToScene(lstActivedItemsX.last()->boundingRect().bottomLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y();
-                   m_movingItem->moveBy(0, dy);
-                   m_graphicsScene.update();
-
-                   lstNoMovedItems.removeOne(m_movingItem);
-                   QList<MonitorProxyWidget *> lstShelterItemsTemp;
-                   for (int i = 0; i < lstNoMovedItems.size(); i++) {
-                       if (m_movingItem->mapToScene(m_movingItem->boundingRect()).intersects(lstNoMovedItems[i]->mapToScene(lstNoMovedItems[i]->boundingRect()))) {
-                           lstShelterItemsTemp.append(lstNoMovedItems[i]);
-                       }
-                   }
-
-
-                   if (lstShelterItemsTemp.size() >= 0) {
-                        m_movingItem->moveBy(0, -dy);//先移回去
-                        m_graphicsScene.update();
-
-                        //上排序
-                        for (auto t : lstShelterItemsTemp) {
-                            if (!lstActivedItemsX.contains(t))
-                                lstActivedItemsX.append(t);
-                        }
-
-                        std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topLeft()).y() < item2->mapToScene(item2->boundingRect().topLeft()).y();
-                        });
-                        int nIndexTopTemp = lstActivedItemsX.indexOf(m_movingItem);
-
-                        //下排序
-                        std::sort(lstActivedItemsX.begin(),lstActivedItemsX.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().bottomLeft()).y() < item2->mapToScene(item2->boundingRect().bottomLeft()).y();
-                        });
-                        //int nIndexBottomTemp = lstActivedItemsX.indexOf(m_movingItem);
-
-                        lstActivedItemsX.removeOne(m_movingItem);
-
-                        if(!lstActivedItemsX.isEmpty()) {
-                            if (nIndexTopTemp == 0) {
-                                g_dy = lstActivedItemsX.first()->mapToScene(lstActivedItemsX.first()->boundingRect().topLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).y();
-                                qDebug() << "g_dy" << g_dy;
-                            }
-                            else {
-                                g_dy = lstActivedItemsX.last()->mapToScene(lstActivedItemsX.last()->boundingRect().bottomLeft()).y() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y();
-                                qDebug() << "g_dy" << g_dy;
-                            }
-                        }
-                   }
-               }
-           }
-       }
-
-       //说明移动块在其他块Y坐标有重合
-       if (nBIndexTop != 0 && nBIndexBottom != nItemSize) {
-
-           //移动Y
-           //处理
-           qreal movey1 = m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).y();
-           qreal movey2 = m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft()).y();
-
-           for (auto pair : m_lstMoveingItemToCenterPosLen) {
-               qreal y1 = pair.first->mapToScene(pair.first->boundingRect().topLeft()).y();
-               qreal y2 = pair.first->mapToScene(pair.first->boundingRect().bottomLeft()).y();
-
-               if (!((y1 >= movey1 && y1 >= movey2) || (y2 <= movey1 && y2 <= movey2))) {
-                    lstActivedItemsY.append(pair.first);
-                }
-           }
-
-           lstActivedItemsY.append(m_movingItem);
-           //左排序
-           std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-              return item1->mapToScene(item1->boundingRect().topLeft()).x() < item2->mapToScene(item2->boundingRect().topLeft()).x();
-           });
-           int nIndexLeft = lstActivedItemsY.indexOf(m_movingItem);
-
-           //右排序
-           std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-              return item1->mapToScene(item1->boundingRect().topRight()).x() < item2->mapToScene(item2->boundingRect().topRight()).x();
-           });
-           int nIndexRight = lstActivedItemsY.indexOf(m_movingItem);
-
-           if (nIndexLeft == nIndexRight) {
-               //移动块在最右侧
-               if (nIndexLeft == 0) {
-                   qreal dx = lstActivedItemsY.first()->mapToScene(lstActivedItemsY.first()->boundingRect().topLeft()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topRight()).x();
-                   m_movingItem->moveBy(dx, 0);
-                   m_graphicsScene.update();
-
-                   QList<MonitorProxyWidget *> lstShelterItemsTemp;
-                   lstNoMovedItems.removeOne(m_movingItem);
-                   for (int i = 0; i < lstNoMovedItems.size(); i++) {
-                       if (m_movingItem->mapToScene(m_movingItem->boundingRect()).intersects(lstNoMovedItems[i]->mapToScene(lstNoMovedItems[i]->boundingRect()))) {
-                           lstShelterItemsTemp.append(lstNoMovedItems[i]);
-                       }
-                   }
-
-
-                   if (lstShelterItemsTemp.size() >= 0) {
-                        m_movingItem->moveBy(-dx, 0);
-                        m_graphicsScene.update();
-
-                        //下排序
-                        std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topRight()).x() < item2->mapToScene(item2->boundingRect().topRight()).x();
-                        });
-                        //int nIndexRightTemp = lstActivedItemsY.indexOf(m_movingItem);
-
-                        //上排序
-                        for (auto t : lstShelterItemsTemp) {
-                            if (!lstActivedItemsY.contains(t))
-                                lstActivedItemsY.append(t);
-                        }
-                        std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topLeft()).x() < item2->mapToScene(item2->boundingRect().topLeft()).x();
-                        });
-                        int nIndexLeftTemp = lstActivedItemsY.indexOf(m_movingItem);
-
-                        lstActivedItemsY.removeOne(m_movingItem);
-
-                        if(!lstActivedItemsY.isEmpty()) {
-                            if (nIndexLeftTemp == 0) {
-                                g_dx = lstActivedItemsY.first()->mapToScene(lstActivedItemsY.first()->boundingRect().topLeft()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topRight()).x();
-                                qDebug() << "g_dx" << g_dx;
-                            }
-                            else {
-                                g_dx = lstActivedItemsY.last()->mapToScene(lstActivedItemsY.last()->boundingRect().topRight()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).x();
-                                qDebug() << "g_dx" << g_dx;
-                            }
-                        }
-                   }
-               }
-                   //移动块在最左侧
-               else {
-                   if(!lstActivedItemsY.contains(m_movingItem))
-                       lstActivedItemsY.append(m_movingItem);
-                   //右排序
-                   std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                      return item1->mapToScene(item1->boundingRect().topRight()).x() < item2->mapToScene(item2->boundingRect().topRight()).x();
-                   });
-
-                   qreal dx = lstActivedItemsY.last()->mapToScene(lstActivedItemsY.last()->boundingRect().topRight()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).x();
-                   m_movingItem->moveBy(dx, 0);
-                   m_graphicsScene.update();
-
-                   lstNoMovedItems.removeOne(m_movingItem);
-                   QList<MonitorProxyWidget *> lstShelterItemsTemp;
-                   for (int i = 0; i < lstNoMovedItems.size(); i++) {
-                       if (m_movingItem->mapToScene(m_movingItem->boundingRect()).intersects(lstNoMovedItems[i]->mapToScene(lstNoMovedItems[i]->boundingRect()))) {
-                           lstShelterItemsTemp.append(lstNoMovedItems[i]);
-                       }
-                   }
-
-                   if (lstShelterItemsTemp.size() >= 0) {
-                        m_movingItem->moveBy(-dx, 0);
-                        m_graphicsScene.update();
-
-                        //上排序
-                        for (auto t : lstShelterItemsTemp) {
-                            if (!lstActivedItemsY.contains(t))
-                                lstActivedItemsY.append(t);
-                        }
-                        std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topLeft()).x() < item2->mapToScene(item2->boundingRect().topLeft()).x();
-                        });
-                        int nIndexLeftTemp = lstActivedItemsY.indexOf(m_movingItem);
-
-                        //下排序
-                        std::sort(lstActivedItemsY.begin(),lstActivedItemsY.end(),[=](const MonitorProxyWidget *item1, const MonitorProxyWidget *item2) {
-                           return item1->mapToScene(item1->boundingRect().topRight()).x() < item2->mapToScene(item2->boundingRect().topRight()).x();
-                        });
-                        //int nIndexRightTemp = lstActivedItemsY.indexOf(m_movingItem);
-
-                        lstActivedItemsY.removeOne(m_movingItem);
-
-                        if(!lstActivedItemsY.isEmpty()) {
-                            if (nIndexLeftTemp == 0) {
-                                g_dx = lstActivedItemsY.first()->mapToScene(lstActivedItemsY.first()->boundingRect().topLeft()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topRight()).x();
-                                qDebug() << "g_dx" << g_dx;
-                            }
-                            else {
-                                g_dx = lstActivedItemsY.last()->mapToScene(lstActivedItemsY.last()->boundingRect().topRight()).x() - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft()).x();
-                                qDebug() << "g_dx" << g_dx;
-                            }
-                        }
-                   }
-               }
-           }
-       }
-
-       //说明移动块在其他块的四周
-       if ((nBIndexLeft == 0 || nBIndexRight == nItemSize) || (nBIndexTop == 0 || nBIndexBottom == nItemSize)) {
-          //表示X方向没有重叠的
-          //TODO：
-          //找距离他最近的顶点
-          //LT 左上
-          lstNoMovedItems.removeOne(m_movingItem);
-          QRectF movedRectF = m_movingItem->mapRectToScene(m_movingItem->boundingRect());
-          QList<QPair<MonitorProxyWidget *, qreal>> lstTempLen;
-          if (nBIndexLeft == 0 && nBIndexTop == 0) {
-              for (auto item : lstNoMovedItems) {
-                  QPointF tempPos = item->mapToScene(item->boundingRect().topLeft());
-                  qreal len = sqrt(pow(tempPos.x()-movedRectF.bottomRight().x(),2)+pow(tempPos.y()-movedRectF.bottomRight().y(),2));
-                  lstTempLen.append(qMakePair(item,len));
-              }
-              //获取距离最近的块
-              std::sort(lstTempLen.begin(),lstTempLen.end(),[=](const QPair<MonitorProxyWidget *, qreal> &item1, const QPair<MonitorProxyWidget *, qreal> &item2) {
-                 return item1.second < item2.second;
-              });
-
-              QPointF dPos = lstTempLen.first().first->mapToScene(lstTempLen.first().first->boundingRect().topLeft()) - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomRight());
-              g_dx = dPos.x();
-              g_dy = dPos.y();
-              qDebug() << "g_dx" << g_dx;
-              qDebug() << "g_dy" << g_dy;
-              g_bXYTogetherMoved = true;
-          }
-
-          //LB 左下
-          if (nBIndexLeft == 0 && nBIndexBottom == nItemSize) {
-              for (auto item : lstNoMovedItems) {
-                  QPointF tempPos = item->mapToScene(item->boundingRect().bottomLeft());
-                  qreal len = sqrt(pow(tempPos.x()-movedRectF.topRight().x(),2)+pow(tempPos.y()-movedRectF.topRight().y(),2));
-                  lstTempLen.append(qMakePair(item,len));
-              }
-              //获取距离最近的块
-              std::sort(lstTempLen.begin(),lstTempLen.end(),[=](const QPair<MonitorProxyWidget *, qreal> &item1, const QPair<MonitorProxyWidget *, qreal> &item2) {
-                 return item1.second < item2.second;
-              });
-
-              QPointF dPos = lstTempLen.first().first->mapToScene(lstTempLen.first().first->boundingRect().bottomLeft()) - m_movingItem->mapToScene(m_movingItem->boundingRect().topRight());
-              g_dx = dPos.x();
-              g_dy = dPos.y();
-              g_bXYTogetherMoved = true;
-              qDebug() << "g_dx" << g_dx;
-              qDebug() << "g_dy" << g_dy;
-          }
-
-          //RT 右上
-          if (nBIndexRight == nItemSize && nBIndexTop == 0) {
-              for (auto item : lstNoMovedItems) {
-                  QPointF tempPos = item->mapToScene(item->boundingRect().topRight());
-                  qreal len = sqrt(pow(tempPos.x()-movedRectF.bottomLeft().x(),2)+pow(tempPos.y()-movedRectF.bottomLeft().y(),2));
-                  lstTempLen.append(qMakePair(item,len));
-              }
-              //获取距离最近的块
-              std::sort(lstTempLen.begin(),lstTempLen.end(),[=](const QPair<MonitorProxyWidget *, qreal> &item1, const QPair<MonitorProxyWidget *, qreal> &item2) {
-                 return item1.second < item2.second;
-              });
-
-              QPointF dPos = lstTempLen.first().first->mapToScene(lstTempLen.first().first->boundingRect().topRight()) - m_movingItem->mapToScene(m_movingItem->boundingRect().bottomLeft());
-              g_dx = dPos.x();
-              g_dy = dPos.y();
-              g_bXYTogetherMoved = true;
-              qDebug() << "g_dx" << g_dx;
-              qDebug() << "g_dy" << g_dy;
-          }
-
-          //RB 右下
-
-           if (nBIndexRight == nItemSize && nBIndexBottom == nItemSize) {
-               for (auto item : lstNoMovedItems) {
-                   QPointF tempPos = item->mapToScene(item->boundingRect().bottomRight());
-                   qreal len = sqrt(pow(tempPos.x()-movedRectF.topLeft().x(),2)+pow(tempPos.y()-movedRectF.topLeft().y(),2));
-                   lstTempLen.append(qMakePair(item,len));
-               }
-               //获取距离最近的块
-               std::sort(lstTempLen.begin(),lstTempLen.end(),[=](const QPair<MonitorProxyWidget *, qreal> &item1, const QPair<MonitorProxyWidget *, qreal> &item2) {
-                  return item1.second < item2.second;
-               });
-
-               QPointF dPos = lstTempLen.first().first->mapToScene(lstTempLen.first().first->boundingRect().bottomRight()) - m_movingItem->mapToScene(m_movingItem->boundingRect().topLeft());
-               g_dx = dPos.x();
-               g_dy = dPos.y();
-               qDebug() << "g_dx" << g_dx;
-               qDebug() << "g_dy" << g_dy;
-               g_bXYTogetherMoved = true;
-           }
-       }
-    }
-
-    qreal dx = g_dx, dy = g_dy;
 
-    //是自动吸附并且没有相交的情况，不需要要移动
-    if (isAutoAdsorption&&!isIntersect) {
-        if (isMove)
-            m_movingItem->moveBy(0, 0);
-        else {
-            dx = 0.0;
-            dy = 0.0;
-        }
-    }
-    //其他情况需要移动
-    else {
-        //是否XY一起移动
-        if (g_bXYTogetherMoved) {
-            if (isMove)
-                m_movingItem->moveBy(g_dx, g_dy);
-            qDebug() << "XY_XY_XY" << g_dx << g_dy;
-        }
-        else {
-            //XY其中一个为0的情况， 执行移动
-            if (qFuzzyIsNull(g_dx) || qFuzzyIsNull(g_dy)) {
-                if (isMove)
-                    m_movingItem->moveBy(g_dx, g_dy);
+    m_movingItem->moveBy(result.offset.x(), result.offset.y());
+    qDebug() << "multiScreenSortAlgo" << m_movingItem->name() << result.offset;
 
-                 qDebug() << "DBL_MIN" << g_dx << g_dy;
-            }
-            //X和Y都不为0的情况下，哪个移动的绝对值小移动哪一个
-            else{
-                if (isMove)
-                    fabs(g_dx) < fabs(g_dy) ?  m_movingItem->moveBy(g_dx, 0): m_movingItem->moveBy(0, g_dy);
-                else {
-                    fabs(g_dx) < fabs(g_dy) ?  dy = 0.0: dx = 0.0;
-                }
-                qDebug() << "fabs(g_dx) < fabs(g_dy) ?" << g_dx << g_dy;
-            }
-        }
-    }
     for (auto pw : m_monitors.keys()) {
         pw->update();
     }
     m_graphicsScene.update();
 
-    if (!isMove)
-        return QPointF(dx,dy);
-    else {
-        return QPointF(g_dx,g_dy);
-    }
+    return result.offset;
 }
 
 //多屏自动调整
 void MonitorsGround::multiScreenAutoAdjust()
 {
-    //在自动拼接之后已经达成全连通状态,无效执行自动调整
-    updateConnectedState();
-
-    //判断是否为全连通状态
-    if (getConnectedDomain(m_movingItem).size() == m_lstItems.size()) {
-        updateConnectedState(true);
-        return;
-    }
-
-    //存储移动块到临时变量
-    MonitorProxyWidget * m_movingItemTemp = m_movingItem;
-    QList<MonitorProxyWidget *> lstChangedItems = m_lstItems;
-
-    //处理之前变化的块为空则返回
-    if (lstChangedItems.isEmpty())
-        return;
-
-    QMap<MonitorProxyWidget *,QList<MonitorProxyWidget *>> maplstItems;
-    QMap<MonitorProxyWidget *, bool> mapItemsNeedMove;
-    QList<MonitorProxyWidget *> itemTemp;
-
-    //这个列表是存放的就是所有移动块相关的块
-    //判断改变连通的块与移动块的剩余联通块是否存在连接
-    //【这种是在移动块初始连接块是两个及以上的情况下触发的，如果是一个连通块的话不会改变连通状态的】
-
-    //获取屏幕集群
-    for (auto iter : m_lstItems) {
+    updateLayoutRects();
+    const QVector<QRectF> rects = m_layout.rects();
 
-        if (!lstChangedItems.contains(iter))
-            continue;
-
-        itemTemp = getConnectedDomain(iter);
-        for (auto k : itemTemp) {
-            if (lstChangedItems.contains(k) && k != iter) {
-                lstChangedItems.removeOne(k);
-            }
-        }
+    //说明除了移动块剩下的被拆分成了几部分，其他屏幕集群依次向中心屏幕集群(包含移动块)移动
+    const bool adjusted = m_layout.autoAdjust(m_lstItems.indexOf(m_movingItem));
+    for (int i = 0; i < m_lstItems.size(); ++i) {
+        const QPointF &offset = m_layout.rects().at(i).topLeft() - rects.at(i).topLeft();
+        if (!offset.isNull())
+            m_lstItems[i]->moveBy(offset.x(), offset.y());
     }
 
-    for (auto item : lstChangedItems) {
-        qDebug() << "处理之后变化的块:" << item->name();
-    }
-
-    for (auto iter : lstChangedItems) {
-        maplstItems.insert(iter, getConnectedDomain(iter));
-     }
-
-    for (auto iter : maplstItems.keys()) {
-        qDebug() << "屏幕集群:" << iter->name();
-        for (auto k : maplstItems[iter]) {
-            qDebug() << "val" << k->name();
-        }
+    if (!adjusted) {
+        qDebug() << "自动调整出现覆盖，自动回弹流程触发!";
+        autoRebound();
     }
 
-
-    if (maplstItems.size() > 0) {
-        //说明除了移动块剩下的被拆分成了几部分，需要重新向其中一个部分移动了
-       //找到中心屏幕集群(包含移动块)
-       for (auto iter1 = maplstItems.begin(); iter1 != maplstItems.end(); ++iter1) {
-            if (iter1.value().contains(m_movingItemTemp)) {
-                m_lstSortItems = iter1.value();
-                break;
-            }
-       }
-
-       //其他屏幕集群依次向中心屏幕集群移动
-       for (auto iter = maplstItems.begin(); iter != maplstItems.end(); ++iter) {
-            if (iter.value().contains(m_movingItemTemp))
-                continue;
-
-            QList<QPointF> lstPos;
-            QList<qreal> lstX,lstY;
-            for (auto item : iter.value()) {
-                m_movingItem = item;          
-                bool isRestore = false;
-                multiScreenSortAlgo(isRestore);
-
-                if (!m_lstSortItems.contains(item))
-                    m_lstSortItems.append(item);
-            }
-       }
-    }
-    m_lstSortItems = m_lstItems;
-    m_movingItem = m_movingItemTemp;
-
     //自动调整完毕后,更新连通域
     updateConnectedState(true);
 }
@@ -1115,27 +493,20 @@ void MonitorsGround::multiScreenAutoAdjust()
 //更新上一次拼接完成的值
 bool MonitorsGround::updateConnectedState(bool isInit)
 {
-    bool isIntersect = false;
-    QList<MonitorProxyWidget *> m_lstItemsTemp;
-    for (int i = 0; i < m_lstItems.size(); i++) {
-        m_lstItemsTemp.clear();
+    updateLayoutRects();
+    const bool isIntersect = m_layout.updateConnectedState();
+    const QVector<QVector<int>> &connected = m_layout.connectedState();
 
-        for (int j = 0; j < m_lstItems.size(); j++) {
-            if (j != i && m_lstItems[i]->mapRectToScene(m_lstItems[i]->boundingRectEx()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))
-                   && !m_lstItemsTemp.contains(m_lstItems[j])
-                   && !m_lstItems[i]->mapRectToScene(m_lstItems[i]->justIntersectRect()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))) {
-                m_lstItemsTemp.append(m_lstItems[j]);
-            }
-            if (j != i && m_lstItems[i]->mapRectToScene(m_lstItems[i]->justIntersectRect()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))) {
-                isIntersect = true;
-            }
-        }
+    for (int i = 0; i < m_lstItems.size(); i++) {
+        QList<MonitorProxyWidget *> lstItems;
+        for (int j : connected.at(i))
+            lstItems.append(m_lstItems.at(j));
 
         if (isInit) {
-            m_mapInitItemConnectedState.insert(m_lstItems[i],m_lstItemsTemp);
+            m_mapInitItemConnectedState.insert(m_lstItems[i], lstItems);
         }
 
-        m_mapItemConnectedState.insert(m_lstItems[i],m_lstItemsTemp);
+        m_mapItemConnectedState.insert(m_lstItems[i], lstItems);
     }
 
     return isIntersect;
@@ -1144,41 +515,22 @@ bool MonitorsGround::updateConnectedState(bool isInit)
 //获取连通域
 QList<MonitorProxyWidget *> MonitorsGround::getConnectedDomain(MonitorProxyWidget *item)
 {
-   QList<MonitorProxyWidget *> lstTemp1Items;
-
-   QList<MonitorProxyWidget *> lstTemp;
-   QList<MonitorProxyWidget *> lstItems;
-
-   lstItems.append(item);
+    QList<MonitorProxyWidget *> lstItems;
+    for (int i : m_layout.connectedDomain(m_lstItems.indexOf(item)))
+        lstItems.append(m_lstItems.at(i));
 
-   for (auto iter : m_lstItems) /*标记循环次数*/ {
-       Q_UNUSED(iter)
-
-       lstTemp.clear();
-       //获取所有的value
-       for (auto a : lstItems) {
-           for (auto t : m_mapItemConnectedState[a]) {
-               if (!lstTemp1Items.contains(t))
-                   lstTemp.append(t);
-           }
-       }
-
-       //去重插入
-       for (auto t : lstTemp) {
-           if (!lstTemp1Items.contains(t) && t != item)
-               lstTemp1Items.append(t);
-           else {
-               lstTemp.removeOne(t);
-           }
-       }
-
-       lstItems.clear();
-       lstItems.append(lstTemp);
-   }
+    return lstItems;
+}
 
-    lstTemp1Items.append(item);
+//同步所有块在场景中的位置
+void MonitorsGround::updateLayoutRects()
+{
+    QVector<QRectF> rects;
+    rects.reserve(m_lstItems.size());
+    for (auto item : m_lstItems)
+        rects.append(item->mapRectToScene(item->boundingRect()));
 
-    return lstTemp1Items;
+    m_layout.setRects(rects);
 }
 
 
@@ -1344,132 +696,16 @@ void MonitorsGround::onRequestMouseMove(MonitorProxyWidget *pw)
     m_effectiveTimer->stop();
 
     //当鼠标移动的时候开始响应并执行自动吸附的逻辑
-    //保证 bufferboundingRect 相交且 boundingRect 不相交，保证移动的块item始终在其他item的外边缘移动
-
-    qreal top = 0.0;
-    qreal bottom = 0.0;
-    qreal right = 0.0;
-    qreal left = 0.0;
-
-    qreal topLeft = 0.0;
-    qreal topRight = 0.0;
-    qreal bottomLeft = 0.0;
-    qreal bottomRight = 0.0;
-    qreal rightTop = 0.0;
-    qreal rightBottom = 0.0;
-    qreal leftTop = 0.0;
-    qreal leftBottom = 0.0;
-    
-    int space = 200;
-
-    auto minMoveLen = [=](qreal temp, qreal &len) {
-        if (fabs(len) > 0.0) {
-            if (fabs(temp) < fabs(len)) len = temp;
-        }
-        else {
-            len = temp;
-        }
-    };
-
-    for (auto item : m_lstItems) {
-        if (item == pw)
-            continue;
-
-        if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->boundingRect())))
-            return;
-
-        //与boundingRect 不相交
-        if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectTop()))) {
-            //上相交
-            qreal temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,top);
-
-            //判断边对齐
-            temp =  item->mapToScene(item->boundingRect().topRight()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,topLeft);
-            temp =  item->mapToScene(item->boundingRect().topLeft()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,topRight);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectBottom()))) {
-            //下相交
-            qreal temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().topLeft()).y();
-            minMoveLen(temp,bottom);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,bottomLeft);
-            temp =  item->mapToScene(item->boundingRect().topLeft()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,bottomRight);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectLeft()))) {
-            //左相交
-            qreal temp =  item->mapToScene(item->boundingRect().bottomLeft()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,left);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().topRight()).y();
-            minMoveLen(temp,leftTop);
-            temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,leftBottom);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectRight()))) {
-            //右相交
-            qreal temp = item->mapToScene(item->boundingRect().bottomRight()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,right);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().topRight()).y();
-            minMoveLen(temp,rightTop);
-            temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,rightBottom);
-        }
-    }
-
-    auto edgeAlignment = [=](qreal x1, qreal x2) {
-        if(fabs(x1) > fabs(x2))
-            return fabs(x2) < space ? x2 : 0;
-        else
-            return fabs(x1) < space ? x1 : 0;
-    };
-
-    QPointF autoAdsorptionPos(0.0,0.0),edgeAlignmentPos(0.0,0.0);
-
-    if (qFuzzyIsNull(top)) {
-        edgeAlignmentPos.setX(edgeAlignment(bottomRight,bottomLeft));
-        autoAdsorptionPos.setY(bottom);
-    }
-    else if (qFuzzyIsNull(bottom)) {
-        edgeAlignmentPos.setX(edgeAlignment(topRight,topLeft));
-        autoAdsorptionPos.setY(top);
-    } 
-    else {
-        autoAdsorptionPos.setY((fabs(top) < fabs(bottom)) ? top : bottom);
-        edgeAlignmentPos.setX((fabs(top) < fabs(bottom)) ? edgeAlignment(topRight,topLeft) : edgeAlignment(bottomRight,bottomLeft));
-    }
-
-
-    if (qFuzzyIsNull(left)) {
-        autoAdsorptionPos.setX(right);
-        edgeAlignmentPos.setY(edgeAlignment(rightTop,rightBottom));
-    }   
-    else if (qFuzzyIsNull(right)) {
-        autoAdsorptionPos.setX(left);
-        edgeAlignmentPos.setY(edgeAlignment(leftTop,leftBottom));
-    } 
-    else {
-        autoAdsorptionPos.setX((fabs(left) < fabs(right)) ? left : right);
-        edgeAlignmentPos.setY((fabs(left) < fabs(right)) ? edgeAlignment(leftTop,leftBottom) : edgeAlignment(rightTop,rightBottom));
-    }
-
-    if(!qFuzzyIsNull(autoAdsorptionPos.x())) {
-        edgeAlignmentPos.setX(0.0);
+    //按下时已经同步了所有块的位置，拖动过程中只有当前块的位置变化
+    const int index = m_lstItems.indexOf(pw);
+    if (m_layout.size() != m_lstItems.size()) {
+        updateLayoutRects();
+    } else {
+        m_layout.setRect(index, pw->mapRectToScene(pw->boundingRect()));
     }
 
-    if(!qFuzzyIsNull(autoAdsorptionPos.y())) {
-        edgeAlignmentPos.setY(0.0);
-    }
-    
-    pw->moveBy(edgeAlignmentPos.x() + autoAdsorptionPos.x(), edgeAlignmentPos.y() + autoAdsorptionPos.y());
+    const QPointF &offset = m_layout.adsorption(index);
+    pw->moveBy(offset.x(), offset.y());
 }
 
 //更新缩放比例
@@ -6,6 +6,7 @@
 #define MONITORSGROUND_H
 
 #include "monitor.h"
+#include "monitorlayoutsolver.h"
 
 #include <QWidget>
 #include <QGraphicsScene>
@@ -65,6 +66,7 @@ private:
     void multiScreenAutoAdjust(); // 手动调整完如果出现没有完全连通的情况，需要启动自动调整算法
     bool updateConnectedState(bool isInit = false); //更新连通状态
     QList<MonitorProxyWidget *> getConnectedDomain(MonitorProxyWidget *item); //获取每个屏幕的连通域
+    void updateLayoutRects(); //同步所有块的位置到拼接计算
     void updateScale();
     void singleScreenAdjest();//单屏幕调整
     void autoRebound(); //自动回弹流程
@@ -81,7 +83,7 @@ private:
     QList<MonitorProxyWidget *> m_lstItems;
     QList<MonitorProxyWidget *> m_lstSortItems;
     MonitorProxyWidget * m_movingItem;              //正在移动的块
-    QList<QPair<MonitorProxyWidget *, qreal>> m_lstMoveingItemToCenterPosLen;           //所有块的中心点到移动点的距离
+    MonitorLayoutSolver m_layout;                   //拼接计算，序号与 m_lstItems 一致
     QMap<MonitorProxyWidget *, QList<MonitorProxyWidget *>> m_mapItemConnectedState;    //所有块的实时连通状态
     QMap<MonitorProxyWidget *, QList<MonitorProxyWidget *>> m_mapInitItemConnectedState; //所有块的初始连通状态
 
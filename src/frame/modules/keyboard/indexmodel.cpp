@@ -5,9 +5,14 @@
 #include <DStandardItem>
 
 #include "indexmodel.h"
+#include "window/collatorsort.h"
+#include "window/pinyin.h"
+#include <QRegularExpression>
 #include <QDBusInterface>
 #include <com_deepin_daemon_inputdevice_keyboard.h>
 
+#include <algorithm>
+
 DWIDGET_USE_NAMESPACE
 
 namespace dcc {
@@ -100,6 +105,8 @@ IndexModel::IndexModel(QObject *parent)
 void IndexModel::setMetaData(const QList<MetaData> &datas)
 {
     beginResetModel();
+    // 重新设置时先移除旧的行，否则 rowCount 与实际的行对不上
+    invisibleRootItem()->removeRows(0, invisibleRootItem()->rowCount());
     m_datas = datas;
     for (int i = 0; i < m_datas.size(); ++i) {
         DStandardItem *item = new DStandardItem(m_datas[i].text());
@@ -150,5 +157,61 @@ int IndexModel::getModelCount()
     return m_datas.count();
 }
 
+QString IndexModel::layoutPinyin(const QString &title)
+{
+    if (title.isEmpty() || title.at(0).isLower() || title.at(0).isUpper())
+        return title;
+
+    // 本地拼音表转换，结果带有声调数字，如 "han4yu3"
+    static const QRegularExpression toneDigits("[0-9]");
+    QString pinyin = chinese2Pinyin(title);
+    pinyin.remove(toneDigits);
+
+    return pinyin.isEmpty() ? title : pinyin;
+}
+
+MetaDataIndex IndexModel::buildLayoutIndex(const QMap<QString, QString> &layouts, bool sectioned)
+{
+    MetaDataIndex index;
+    index.datas.reserve(layouts.size());
+
+    for (auto it(layouts.cbegin()); it != layouts.cend(); ++it) {
+        MetaData md;
+        md.setKey(it.key());
+        md.setText(it.value());
+        if (sectioned)
+            md.setPinyin(layoutPinyin(it.value()));
+        index.datas.append(md);
+    }
+
+    if (!sectioned) {
+        collatorSort(index.datas, [](const MetaData &md) { return md.text(); });
+
+        return index;
+    }
+
+    // 拼音相同的保持原来的顺序
+    std::stable_sort(index.datas.begin(), index.datas.end(), [](const MetaData &md1, const MetaData &md2) {
+        return md2 > md1;
+    });
+
+    QList<MetaData> datas;
+    datas.reserve(index.datas.size() + 26);
+    QChar ch = '\0';
+    for (const MetaData &md : index.datas) {
+        const QString &pinyin = md.pinyin();
+        const QChar flag = pinyin.isEmpty() ? QChar('\0') : pinyin.at(0).toUpper();
+        if (flag != ch) {
+            ch = flag;
+            index.letters.append(ch);
+            datas.append(MetaData(ch, true));
+        }
+        datas.append(md);
+    }
+    index.datas = datas;
+
+    return index;
+}
+
 }
 }
@@ -7,6 +7,7 @@
 
 #include <DListView>
 
+#include <QMap>
 #include <QString>
 #include <QStandardItemModel>
 #include <QItemDelegate>
@@ -50,6 +51,11 @@ private:
 
 QDebug &operator<<(QDebug dbg, const MetaData &md);
 
+struct MetaDataIndex {
+    QList<MetaData> datas;
+    QList<QString> letters;     // 按首字母分组时的分组字母
+};
+
 class IndexModel : public QStandardItemModel
 {
     Q_OBJECT
@@ -65,6 +71,11 @@ public:
     QList<QString> letters() const;
     int getModelCount();
 
+    // 布局名称的排序拼音，拉丁字母开头的直接使用名称，其他的转换成不带声调的拼音
+    static QString layoutPinyin(const QString &title);
+    // 由 <布局, 名称> 构建布局列表，sectioned 为 true 时按拼音排序并插入首字母分组，否则按名称排序
+    static MetaDataIndex buildLayoutIndex(const QMap<QString, QString> &layouts, bool sectioned);
+
 protected:
     int rowCount(const QModelIndex &parent) const;
 private:
@@ -161,6 +161,13 @@ void KeyboardModel::setRepeatInterval(const uint &repeatInterval)
 void KeyboardModel::setAllShortcut(const QMap<QStringList, int> &map)
 {
     m_shortcutMap = map;
+
+    m_shortcutIndex.clear();
+    m_shortcutIndex.reserve(map.size());
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        if (!it.key().isEmpty())
+            m_shortcutIndex.insert(qMakePair(it.value(), it.key().last()));
+    }
 }
 
 bool KeyboardModel::numLock() const
@@ -225,5 +232,10 @@ QMap<QStringList, int> KeyboardModel::allShortcut() const
     return m_shortcutMap;
 }
 
+bool KeyboardModel::shortcutOccupied(int modifiers, const QString &key) const
+{
+    return m_shortcutIndex.contains(qMakePair(modifiers, key));
+}
+
 }
 }
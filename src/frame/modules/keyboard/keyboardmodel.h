@@ -8,6 +8,7 @@
 #include <QObject>
 #include <QStringList>
 #include <QMap>
+#include <QSet>
 #include "indexmodel.h"
 
 
@@ -52,6 +53,8 @@ public:
     QList<MetaData> langLists() const;
     bool capsLock() const;
     QMap<QStringList, int> allShortcut() const;
+    // 修饰键组合和按键是否已被快捷键占用
+    bool shortcutOccupied(int modifiers, const QString &key) const;
 
     uint repeatInterval() const;
     void setRepeatInterval(const uint &repeatInterval);
@@ -108,6 +111,7 @@ private:
     QMap<QString, QString> m_layouts;
     QList<MetaData> m_langList;
     QMap<QStringList, int> m_shortcutMap;
+    QSet<QPair<int, QString>> m_shortcutIndex;    // (修饰键, 按键)，按键时检测冲突不需要遍历所有快捷键
     int m_status{0};
 };
 }
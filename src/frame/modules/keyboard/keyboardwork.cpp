@@ -8,15 +8,15 @@
 #include <QTime>
 #include <QDebug>
 #include <QLocale>
-#include <QCollator>
+#include "window/collatorsort.h"
 #include <QCoreApplication>
 #include <QGuiApplication>
+#include <QtConcurrent>
 
 namespace dcc {
 namespace keyboard{
 
 
-bool caseInsensitiveLessThan(const MetaData &s1, const MetaData &s2);
 
 KeyboardWorker::KeyboardWorker(KeyboardModel *model, QObject *parent)
     : QObject(parent)
@@ -133,6 +133,8 @@ void KeyboardWorker::active()
 
     m_metaDatas.clear();
     m_letters.clear();
+    m_indexedLayouts.clear();
+    m_layoutIndexPending = false;
 
     Q_EMIT onDatasChanged(m_metaDatas);
     Q_EMIT onLettersChanged(m_letters);
@@ -160,6 +162,9 @@ void KeyboardWorker::deactive()
 
 bool KeyboardWorker::keyOccupy(const QStringList &list)
 {
+    if (list.isEmpty())
+        return true;
+
     int bit = 0;
     for (QString t : list) {
         if (t == "Control")
@@ -174,15 +179,7 @@ bool KeyboardWorker::keyOccupy(const QStringList &list)
             continue;
     }
 
-    QMap<QStringList,int> keylist = m_model->allShortcut();
-    QMap<QStringList, int>::iterator i;
-    for (i = keylist.begin(); i != keylist.end(); ++i) {
-        if (bit == i.value() && i.key().last() == list.last()) {
-            return false;
-        }
-    }
-
-    return true;
+    return !m_model->shortcutOccupied(bit, list.last());
 }
 
 #ifndef DCC_DISABLE_KBLAYOUT
@@ -327,13 +324,6 @@ void KeyboardWorker::delUserLayout(const QString &value)
     m_keyboardInter->DeleteUserLayout(m_model->userLayout().key(value));
 }
 
-bool caseInsensitiveLessThan(const MetaData &s1, const MetaData &s2)
-{
-    QCollator qc;
-    return qc.compare(s1.text(), s2.text()) < 0;
-
-}
-
 void KeyboardWorker::onRequestShortcut(QDBusPendingCallWatcher *watch)
 {
     QDBusPendingReply<QString> reply = *watch;
@@ -398,7 +388,10 @@ void KeyboardWorker::onDisableShortcut(ShortcutInfo *info)
 {
     // disable shortcut need wait!
     m_keybindInter->ClearShortcutKeystrokes(info->id, static_cast<int>(info->type)).waitForFinished();
-    info->accels.clear();
+    if (m_shortcutModel)
+        m_shortcutModel->setAccels(info, QString());
+    else
+        info->accels.clear();
 }
 
 void KeyboardWorker::onAddedFinished(QDBusPendingCallWatcher *watch)
@@ -438,7 +431,7 @@ void KeyboardWorker::onLocalListsFinished(QDBusPendingCallWatcher *watch)
         m_datas.append(md);
     }
 
-    qSort(m_datas.begin(), m_datas.end(), caseInsensitiveLessThan);
+    collatorSort(m_datas, [](const MetaData &md) { return md.text(); });
 
     m_model->setLocaleList(m_datas);
 
@@ -508,71 +501,37 @@ void KeyboardWorker::onSearchFinished(QDBusPendingCallWatcher *watch)
 
 void KeyboardWorker::onPinyin()
 {
-    m_letters.clear();
-    m_metaDatas.clear();
-    QDBusInterface dbus_pinyin("com.deepin.api.Pinyin", "/com/deepin/api/Pinyin",
-                               "com.deepin.api.Pinyin");
-
-    Q_FOREACH(const QString &str, m_model->kbLayout().keys()) {
-        MetaData md;
-        QString title = m_model->kbLayout()[str];
-        md.setText(title);
-        md.setKey(str);
-        QChar letterFirst = title[0];
-        QStringList letterFirstList;
-        if (letterFirst.isLower() || letterFirst.isUpper()) {
-            letterFirstList << QString(letterFirst);
-            md.setPinyin(title);
-        } else {
-            QDBusMessage message = dbus_pinyin.call("Query", title);
-            letterFirstList = message.arguments()[0].toStringList();
-            md.setPinyin(letterFirstList.at(0));
-        }
-
-        append(md);
-    }
-
-    QLocale locale;
-
-    if (locale.language() == QLocale::Chinese) {
-        QChar ch = '\0';
-        for (int i(0); i != m_metaDatas.size(); ++i)
-        {
-            const QChar flag = m_metaDatas[i].pinyin().at(0).toUpper();
-            if (flag == ch)
-                continue;
-            ch = flag;
-
-            m_letters.append(ch);
-            m_metaDatas.insert(i, MetaData(ch, true));
+    const QMap<QString, QString> layouts = m_model->kbLayout();
+    if (layouts == m_indexedLayouts) {
+        // 布局列表没有变化，直接使用上次的结果，正在计算时等计算完成后再通知
+        if (!m_layoutIndexPending) {
+            Q_EMIT onDatasChanged(m_metaDatas);
+            Q_EMIT onLettersChanged(m_letters);
         }
-    } else {
-        qSort(m_metaDatas.begin(), m_metaDatas.end(), caseInsensitiveLessThan);
-    }
-
-    Q_EMIT onDatasChanged(m_metaDatas);
-    Q_EMIT onLettersChanged(m_letters);
-}
-
-void KeyboardWorker::append(const MetaData &md)
-{
-    if(m_metaDatas.count() == 0)
-    {
-        m_metaDatas.append(md);
         return;
     }
 
-    int index = 0;
-    for (int i = 0; i != m_metaDatas.size(); ++i) {
-        if(m_metaDatas.at(i) > md)
-        {
-            m_metaDatas.insert(index,md);
+    m_indexedLayouts = layouts;
+    m_layoutIndexPending = true;
+
+    // 拼音转换和排序在线程池中完成，数百个布局时不阻塞界面
+    const bool sectioned = QLocale().language() == QLocale::Chinese;
+    QFutureWatcher<MetaDataIndex> *watcher = new QFutureWatcher<MetaDataIndex>(this);
+    connect(watcher, &QFutureWatcher<MetaDataIndex>::finished, this, [ = ] {
+        watcher->deleteLater();
+        // 计算期间布局列表又变化了，以最新一次的结果为准
+        if (layouts != m_indexedLayouts)
             return;
-        }
-        index++;
-    }
 
-    m_metaDatas.append(md);
+        const MetaDataIndex &index = watcher->result();
+        m_metaDatas = index.datas;
+        m_letters = index.letters;
+        m_layoutIndexPending = false;
+
+        Q_EMIT onDatasChanged(m_metaDatas);
+        Q_EMIT onLettersChanged(m_letters);
+    });
+    watcher->setFuture(QtConcurrent::run(&IndexModel::buildLayoutIndex, layouts, sectioned));
 }
 #endif
 
@@ -109,7 +109,6 @@ public Q_SLOTS:
     void onPinyin();
     void onSearchShortcuts(const QString &searchKey);
     void onSearchFinished(QDBusPendingCallWatcher *watch);
-    void append(const MetaData& md);
 #endif
 
 #ifndef DCC_DISABLE_LANGUAGE
@@ -136,6 +135,8 @@ private:
     QList<MetaData> m_datas;
     QList<MetaData> m_metaDatas;
     QList<QString> m_letters;
+    QMap<QString, QString> m_indexedLayouts;    // m_metaDatas 对应的布局列表
+    bool m_layoutIndexPending = false;
     int m_delayValue;
     int m_speedValue;
     KeyboardModel* m_model;
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchfiltermodel.h"
+
+namespace dcc {
+namespace keyboard {
+
+SearchFilterModel::SearchFilterModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+    , m_sourceChanging(0)
+    , m_dirty(true)
+{
+
+}
+
+void SearchFilterModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    beginResetModel();
+
+    if (this->sourceModel())
+        disconnect(this->sourceModel(), nullptr, this, nullptr);
+
+    QAbstractProxyModel::setSourceModel(sourceModel);
+    m_sourceChanging = 0;
+    m_dirty = true;
+
+    if (sourceModel) {
+        connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &SearchFilterModel::onSourceAboutToChange);
+        connect(sourceModel, &QAbstractItemModel::modelReset, this, &SearchFilterModel::onSourceChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &SearchFilterModel::onSourceAboutToChange);
+        connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &SearchFilterModel::onSourceChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &SearchFilterModel::onSourceAboutToChange);
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &SearchFilterModel::onSourceChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeMoved, this, &SearchFilterModel::onSourceAboutToChange);
+        connect(sourceModel, &QAbstractItemModel::rowsMoved, this, &SearchFilterModel::onSourceChanged);
+        connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &SearchFilterModel::onSourceAboutToChange);
+        connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &SearchFilterModel::onSourceChanged);
+        connect(sourceModel, &QAbstractItemModel::dataChanged, this, &SearchFilterModel::onSourceDataChanged);
+    }
+
+    endResetModel();
+}
+
+void SearchFilterModel::setKeyFunction(const KeyFunction &function)
+{
+    beginResetModel();
+    m_keyFunction = function;
+    m_dirty = true;
+    endResetModel();
+}
+
+void SearchFilterModel::setFilterText(const QString &text)
+{
+    const QString filter = text.toLower();
+    if (filter == m_filterText)
+        return;
+
+    // 继续输入时新的搜索词包含上一次的搜索词，结果一定是上一次结果的子集
+    const bool narrow = !m_filterText.isEmpty() && filter.contains(m_filterText);
+
+    beginResetModel();
+    m_filterText = filter;
+    if (!m_dirty)
+        refilter(narrow);
+    endResetModel();
+}
+
+QModelIndex SearchFilterModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex SearchFilterModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child)
+
+    return QModelIndex();
+}
+
+int SearchFilterModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    ensureIndexed();
+    return m_rows.size();
+}
+
+int SearchFilterModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel())
+        return 0;
+
+    return sourceModel()->columnCount();
+}
+
+QModelIndex SearchFilterModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel())
+        return QModelIndex();
+
+    ensureIndexed();
+    if (proxyIndex.row() >= m_rows.size())
+        return QModelIndex();
+
+    return sourceModel()->index(m_rows.at(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex SearchFilterModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.model() != sourceModel())
+        return QModelIndex();
+
+    ensureIndexed();
+    const int row = sourceIndex.row();
+    if (row >= m_proxyRows.size() || m_proxyRows.at(row) < 0)
+        return QModelIndex();
+
+    return createIndex(m_proxyRows.at(row), sourceIndex.column());
+}
+
+void SearchFilterModel::onSourceAboutToChange()
+{
+    // 源模型重置期间还会逐行插入删除，只在最外层的变化开始和结束时重置
+    if (m_sourceChanging++ == 0)
+        beginResetModel();
+}
+
+void SearchFilterModel::onSourceChanged()
+{
+    m_dirty = true;
+    if (m_sourceChanging > 0 && --m_sourceChanging == 0)
+        endResetModel();
+}
+
+void SearchFilterModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    // 源模型结构变化期间的修改在变化结束后统一重建
+    if (m_sourceChanging > 0 || !topLeft.isValid() || topLeft.parent().isValid())
+        return;
+
+    ensureIndexed();
+
+    const int first = topLeft.row();
+    const int last = qMin(bottomRight.row(), m_keys.size() - 1);
+
+    // 关键字变化导致匹配结果变化时重新过滤，否则只转发变化
+    bool refiltered = false;
+    for (int row = first; row <= last; ++row) {
+        const QString &key = rowKey(row);
+        if (key == m_keys.at(row))
+            continue;
+
+        m_keys[row] = key;
+        if (!m_filterText.isEmpty() && accepts(row) != (m_proxyRows.at(row) >= 0))
+            refiltered = true;
+    }
+
+    if (refiltered) {
+        beginResetModel();
+        refilter(false);
+        endResetModel();
+        return;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        const int proxyRow = m_proxyRows.at(row);
+        if (proxyRow >= 0)
+            Q_EMIT dataChanged(index(proxyRow, topLeft.column()), index(proxyRow, bottomRight.column()), roles);
+    }
+}
+
+void SearchFilterModel::ensureIndexed() const
+{
+    if (!m_dirty)
+        return;
+
+    m_dirty = false;
+
+    const int count = sourceModel() ? sourceModel()->rowCount() : 0;
+    m_keys.resize(count);
+    for (int row = 0; row < count; ++row)
+        m_keys[row] = rowKey(row);
+
+    refilter(false);
+}
+
+QString SearchFilterModel::rowKey(int sourceRow) const
+{
+    const QModelIndex &index = sourceModel()->index(sourceRow, 0);
+    const QString &key = m_keyFunction ? m_keyFunction(index) : index.data(Qt::DisplayRole).toString();
+
+    return key.toLower();
+}
+
+bool SearchFilterModel::accepts(int sourceRow) const
+{
+    const QString &key = m_keys.at(sourceRow);
+    return !key.isEmpty() && key.contains(m_filterText);
+}
+
+void SearchFilterModel::refilter(bool narrow) const
+{
+    const int count = m_keys.size();
+
+    QVector<int> rows;
+    if (m_filterText.isEmpty()) {
+        rows.reserve(count);
+        for (int row = 0; row < count; ++row)
+            rows.append(row);
+    } else if (narrow) {
+        for (int row : m_rows) {
+            if (accepts(row))
+                rows.append(row);
+        }
+    } else {
+        for (int row = 0; row < count; ++row) {
+            if (accepts(row))
+                rows.append(row);
+        }
+    }
+
+    m_rows = rows;
+    m_proxyRows.fill(-1, count);
+    for (int i = 0; i < m_rows.size(); ++i)
+        m_proxyRows[m_rows.at(i)] = i;
+}
+
+}
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SEARCHFILTERMODEL_H
+#define SEARCHFILTERMODEL_H
+
+#include <QAbstractProxyModel>
+#include <QVector>
+
+#include <functional>
+
+namespace dcc {
+namespace keyboard {
+
+/**
+ * @brief 列表搜索过滤代理
+ * 建立时为源模型的每一行计算一次小写的搜索关键字(名称、拼音等)，搜索时只做子串匹配，
+ * 新的搜索词包含上一次的搜索词时(继续输入)只在上一次的结果中查找，不需要为每次输入重新创建模型。
+ * 只支持单列的列表模型。
+ */
+class SearchFilterModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+public:
+    using KeyFunction = std::function<QString(const QModelIndex &)>;
+
+    explicit SearchFilterModel(QObject *parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+    // 每一行的搜索关键字，返回空字符串的行(如分组标题)不会被搜索到，默认使用显示文本
+    void setKeyFunction(const KeyFunction &function);
+
+    // 搜索词为空时显示源模型的所有行
+    void setFilterText(const QString &text);
+    inline QString filterText() const { return m_filterText; }
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+private Q_SLOTS:
+    void onSourceAboutToChange();
+    void onSourceChanged();
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+private:
+    // 源模型结构变化后只标记，下次访问时再重建，逐行插入时不会反复计算
+    void ensureIndexed() const;
+    QString rowKey(int sourceRow) const;
+    bool accepts(int sourceRow) const;
+    void refilter(bool narrow) const;
+
+private:
+    KeyFunction m_keyFunction;
+    QString m_filterText;               // 已转换为小写
+    int m_sourceChanging;               // 源模型未结束的结构变化层数
+    mutable bool m_dirty;
+    mutable QVector<QString> m_keys;    // 源模型每一行的小写关键字
+    mutable QVector<int> m_rows;        // 匹配的源模型行号
+    mutable QVector<int> m_proxyRows;   // 源模型行号对应的代理行号，-1 表示被过滤
+};
+
+}
+}
+
+#endif // SEARCHFILTERMODEL_H
@@ -13,6 +13,8 @@
 #include <QThreadPool>
 #include <QGuiApplication>
 
+#include <algorithm>
+
 #include "shortcutitem.h"
 
 static const QStringList systemFilter = {"terminal",
@@ -52,6 +54,24 @@ static QStringList workspaceFilter = {"switch-to-workspace-left",
 
 static QStringList assistiveToolsFilter = {"ai-assistant", "text-to-speech", "speech-to-text", "translation"};
 
+// id 在列表中的位置，排序和分类时不需要反复调用 indexOf
+static QHash<QString, int> filterOrder(const QStringList &filter)
+{
+    QHash<QString, int> order;
+    order.reserve(filter.size());
+    for (int i = filter.size() - 1; i >= 0; --i)
+        order.insert(filter.at(i), i);
+
+    return order;
+}
+
+static void sortByFilter(QList<dcc::keyboard::ShortcutInfo *> &list, const QHash<QString, int> &order)
+{
+    std::sort(list.begin(), list.end(), [ &order ](dcc::keyboard::ShortcutInfo *s1, dcc::keyboard::ShortcutInfo *s2) {
+        return order.value(s1->id, -1) < order.value(s2->id, -1);
+    });
+}
+
 namespace dcc {
 namespace keyboard {
 
@@ -95,6 +115,9 @@ ShortcutModel::~ShortcutModel()
     qDeleteAll(m_infos);
 
     m_infos.clear();
+    m_accelsIndex.clear();
+    m_indexedAccels.clear();
+    m_idIndex.clear();
     m_systemInfos.clear();
     m_windowInfos.clear();
     m_workspaceInfos.clear();
@@ -137,6 +160,7 @@ void ShortcutModel::delInfo(ShortcutInfo *info)
 {
     if (m_infos.contains(info)) {
         m_infos.removeOne(info);
+        unindexInfo(info);
     }
     if (m_customInfos.contains(info)) {
         m_customInfos.removeOne(info);
@@ -177,12 +201,20 @@ void ShortcutModel::onParseInfo(const QString &info)
     qDeleteAll(m_infos);
 
     m_infos.clear();
+    m_accelsIndex.clear();
+    m_indexedAccels.clear();
+    m_idIndex.clear();
     m_systemInfos.clear();
     m_windowInfos.clear();
     m_workspaceInfos.clear();
     m_assistiveToolsInfos.clear();
     m_customInfos.clear();
 
+    const QHash<QString, int> &systemOrder = filterOrder(systemShortKeys);
+    const QHash<QString, int> &windowOrder = filterOrder(windowFilter);
+    const QHash<QString, int> &workspaceOrder = filterOrder(workspaceFilter);
+    const QHash<QString, int> &assistiveToolsOrder = filterOrder(assistiveToolsFilter);
+
     QJsonArray array = QJsonDocument::fromJson(info.toStdString().c_str()).array();
 
     Q_FOREACH (QJsonValue value, array) {
@@ -197,21 +229,22 @@ void ShortcutModel::onParseInfo(const QString &info)
         info->command = obj["Exec"].toString();
 
         m_infos << info;
+        indexInfo(info);
 
         if (type != MEDIAKEY) {
-            if (systemShortKeys.contains(info->id)) {
+            if (systemOrder.contains(info->id)) {
                 m_systemInfos << info;
                 continue;
             }
-            if (windowFilter.contains(info->id)) {
+            if (windowOrder.contains(info->id)) {
                 m_windowInfos << info;
                 continue;
             }
-            if (workspaceFilter.contains(info->id)) {
+            if (workspaceOrder.contains(info->id)) {
                 m_workspaceInfos << info;
                 continue;
             }
-            if (assistiveToolsFilter.contains(info->id)) {
+            if (assistiveToolsOrder.contains(info->id)) {
                 m_assistiveToolsInfos << info;
                 continue;
             }
@@ -221,21 +254,10 @@ void ShortcutModel::onParseInfo(const QString &info)
         }
     }
 
-    qSort(m_systemInfos.begin(), m_systemInfos.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return systemShortKeys.indexOf(s1->id) < systemShortKeys.indexOf(s2->id);
-    });
-
-    qSort(m_windowInfos.begin(), m_windowInfos.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return windowFilter.indexOf(s1->id) < windowFilter.indexOf(s2->id);
-    });
-
-    qSort(m_workspaceInfos.begin(), m_workspaceInfos.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return workspaceFilter.indexOf(s1->id) < workspaceFilter.indexOf(s2->id);
-    });
-
-    qSort(m_assistiveToolsInfos.begin(), m_assistiveToolsInfos.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return assistiveToolsFilter.indexOf(s1->id) < assistiveToolsFilter.indexOf(s2->id);
-    });
+    sortByFilter(m_systemInfos, systemOrder);
+    sortByFilter(m_windowInfos, windowOrder);
+    sortByFilter(m_workspaceInfos, workspaceOrder);
+    sortByFilter(m_assistiveToolsInfos, assistiveToolsOrder);
 
     Q_EMIT listChanged(m_systemInfos, InfoType::System);
     Q_EMIT listChanged(m_windowInfos, InfoType::Window);
@@ -258,6 +280,7 @@ void ShortcutModel::onCustomInfo(const QString &json)
     info->command = obj["Exec"].toString();
     m_infos.append(info);
     m_customInfos.append(info);
+    indexInfo(info);
     Q_EMIT addCustomInfo(info);
 }
 
@@ -265,17 +288,14 @@ void ShortcutModel::onKeyBindingChanged(const QString &value)
 {
     const QJsonObject &obj       = QJsonDocument::fromJson(value.toStdString().c_str()).object();
     const QString     &update_id = obj["Id"].toString();
-    auto res = std::find_if(m_infos.begin(), m_infos.end(), [ = ] (const ShortcutInfo *info)->bool{
-        return info->id == update_id;
-    });
+    ShortcutInfo *info = m_idIndex.value(infoKey(update_id, obj["Type"].toInt()));
 
-    if (res != m_infos.end()) {
-        (*res)->type = obj["Type"].toInt();
-        (*res)->accels  = obj["Accels"].toArray().first().toString();
-        (*res)->name    = obj["Name"].toString();
-        (*res)->command = obj["Exec"].toString();
+    if (info) {
+        setAccels(info, obj["Accels"].toArray().first().toString());
+        info->name    = obj["Name"].toString();
+        info->command = obj["Exec"].toString();
 
-        Q_EMIT shortcutChanged((*res));
+        Q_EMIT shortcutChanged(info);
     }
 }
 
@@ -307,15 +327,74 @@ ShortcutInfo *ShortcutModel::getInfo(const QString &shortcut)
     if (QGuiApplication::platformName().startsWith("wayland", Qt::CaseInsensitive)) {
         newShortcut = parseKeystroke(newShortcut);
     }
-    auto res = std::find_if(m_infos.begin(), m_infos.end(), [ = ] (const ShortcutInfo *info)->bool{
-        return !QString::compare(info->accels, newShortcut, Qt::CaseInsensitive); //判断是否相等，相等则返回0
-    });
 
-    if (res != m_infos.end()) {
-        return *res;
+    return m_accelsIndex.value(accelsKey(newShortcut));
+}
+
+void ShortcutModel::setAccels(ShortcutInfo *info, const QString &accels)
+{
+    if (!info)
+        return;
+
+    // 不在列表中的快捷键(如新建时的临时数据)只修改数据
+    const bool indexed = m_indexedAccels.contains(info);
+    if (indexed)
+        unindexInfo(info);
+
+    info->accels = accels;
+
+    if (indexed)
+        indexInfo(info);
+}
+
+QString ShortcutModel::accelsKey(const QString &accels)
+{
+    // 与原来不区分大小写的比较保持一致
+    return accels.toLower();
+}
+
+QString ShortcutModel::infoKey(const QString &id, int type)
+{
+    return id + '\n' + QString::number(type);
+}
+
+void ShortcutModel::indexInfo(ShortcutInfo *info)
+{
+    const QString &key = accelsKey(info->accels);
+    m_indexedAccels.insert(info, key);
+    // 多个快捷键相同时和原来一样返回列表中靠前的一个
+    if (!key.isEmpty() && !m_accelsIndex.contains(key))
+        m_accelsIndex.insert(key, info);
+
+    const QString &id = infoKey(info->id, info->type);
+    if (!m_idIndex.contains(id))
+        m_idIndex.insert(id, info);
+}
+
+void ShortcutModel::unindexInfo(ShortcutInfo *info)
+{
+    // 使用建立索引时的快捷键，数据被直接修改过也不会留下无效的指针
+    const QString &key = m_indexedAccels.take(info);
+    if (!key.isEmpty() && m_accelsIndex.value(key) == info) {
+        m_accelsIndex.remove(key);
+        for (ShortcutInfo *other : m_infos) {
+            if (other != info && m_indexedAccels.value(other) == key) {
+                m_accelsIndex.insert(key, other);
+                break;
+            }
+        }
     }
 
-    return nullptr;
+    const QString &id = infoKey(info->id, info->type);
+    if (m_idIndex.value(id) == info) {
+        m_idIndex.remove(id);
+        for (ShortcutInfo *other : m_infos) {
+            if (other != info && infoKey(other->id, other->type) == id) {
+                m_idIndex.insert(id, other);
+                break;
+            }
+        }
+    }
 }
 
 QString ShortcutModel::parseKeystroke(QString& shortcut)
@@ -403,15 +482,9 @@ void ShortcutModel::setSearchResult(const QString &searchResult)
         }
     }
 
-    qSort(systemInfoList.begin(), systemInfoList.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return systemFilter.indexOf(s1->id) < systemFilter.indexOf(s2->id);
-    });
-    qSort(windowInfoList.begin(), windowInfoList.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return windowFilter.indexOf(s1->id) < windowFilter.indexOf(s2->id);
-    });
-    qSort(workspaceInfoList.begin(), workspaceInfoList.end(), [ = ](ShortcutInfo *s1, ShortcutInfo *s2) {
-        return workspaceFilter.indexOf(s1->id) < workspaceFilter.indexOf(s2->id);
-    });
+    sortByFilter(systemInfoList, filterOrder(systemFilter));
+    sortByFilter(windowInfoList, filterOrder(windowFilter));
+    sortByFilter(workspaceInfoList, filterOrder(workspaceFilter));
     m_searchList.append(systemInfoList);
     m_searchList.append(windowInfoList);
     m_searchList.append(workspaceInfoList);
@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include "modules/display/displaymodel.h"
 
 static const QMap<QString, QString> DisplaykeyMap = { {"exclam", "!"}, {"at", "@"}, {"numbersign", "#"}, {"dollar", "$"}, {"percent", "%"},
@@ -76,6 +77,8 @@ public:
     void setCurrentInfo(ShortcutInfo *currentInfo);
 
     ShortcutInfo *getInfo(const QString &shortcut);
+    // 修改快捷键需要通过这里同步更新冲突检测的索引
+    void setAccels(ShortcutInfo *info, const QString &accels);
     void setSearchResult(const QString &searchResult);
     bool getWindowSwitch();
     QString parseKeystroke(QString& shortcuts);
@@ -94,6 +97,12 @@ public Q_SLOTS:
     void onKeyBindingChanged(const QString &value);
     void onWindowSwitchChanged(bool value);
 
+private:
+    static QString accelsKey(const QString &accels);
+    static QString infoKey(const QString &id, int type);
+    void indexInfo(ShortcutInfo *info);
+    void unindexInfo(ShortcutInfo *info);
+
 private:
     QString m_info;
     QList<ShortcutInfo *> m_infos;
@@ -103,6 +112,9 @@ private:
     QList<ShortcutInfo *> m_assistiveToolsInfos;
     QList<ShortcutInfo *> m_customInfos;
     QList<ShortcutInfo *> m_searchList;
+    QHash<QString, ShortcutInfo *> m_accelsIndex;       // 小写的快捷键 -> 快捷键信息，快捷键为空的不记录
+    QHash<const ShortcutInfo *, QString> m_indexedAccels; // 建立索引时使用的快捷键
+    QHash<QString, ShortcutInfo *> m_idIndex;           // id 和类型 -> 快捷键信息
     ShortcutInfo *m_currentInfo = nullptr;
     bool m_windowSwitchState;
     dcc::display::DisplayModel m_dis;
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "mousedbusproxy.h"
+#include "window/dbuscallcoalescer.h"
+
 using namespace dcc;
 using namespace dcc::mouse;
 const QString Service = "com.deepin.daemon.InputDevices";
@@ -19,6 +21,7 @@ MouseDBusProxy::MouseDBusProxy(MouseWorker *worker, QObject *parent)
     , m_dbusDevices(new InputDevices(Service, "/com/deepin/daemon/InputDevices", QDBusConnection::sessionBus(), this))
     , m_worker(worker)
     , m_systemTouchpad(new QDBusInterface(SystemTouchpadService, SystemTouchpadPath, SystemTouchpadInterface, QDBusConnection::systemBus(), this))
+    , m_sliderCalls(new DBusCallCoalescer(this))
 {
     m_dbusMouse->setSync(false);
     m_dbusTouchPad->setSync(false);
@@ -168,7 +171,7 @@ void MouseDBusProxy::setAccelProfile(const bool state)
 
 void MouseDBusProxy::setMouseMotionAcceleration(const double &value)
 {
-    m_dbusMouse->setMotionAcceleration(value);
+    m_sliderCalls->setDBusProperty("MouseMotionAcceleration", m_dbusMouse, "MotionAcceleration", value);
 }
 
 void MouseDBusProxy::setTouchNaturalScrollState(const bool state)
@@ -183,7 +186,7 @@ void MouseDBusProxy::setDisTyping(const bool state)
 
 void MouseDBusProxy::setTouchpadMotionAcceleration(const double &value)
 {
-    m_dbusTouchPad->setMotionAcceleration(value);
+    m_sliderCalls->setDBusProperty("TouchpadMotionAcceleration", m_dbusTouchPad, "MotionAcceleration", value);
 }
 
 void MouseDBusProxy::setTapClick(const bool state)
@@ -213,10 +216,10 @@ void MouseDBusProxy::setPalmMinz(int palmMinz)
 
 void MouseDBusProxy::setTrackPointMotionAcceleration(const double &value)
 {
-    m_dbusTrackPoint->setMotionAcceleration(value);
+    m_sliderCalls->setDBusProperty("TrackPointMotionAcceleration", m_dbusTrackPoint, "MotionAcceleration", value);
 }
 
 void MouseDBusProxy::setScrollSpeed(uint speed)
 {
-    m_dbusDevices->setWheelSpeed(speed);
+    m_sliderCalls->setDBusProperty("WheelSpeed", m_dbusDevices, "WheelSpeed", speed);
 }
@@ -19,6 +19,8 @@ using TouchPad = com::deepin::daemon::inputdevice::TouchPad;
 using TrackPoint = com::deepin::daemon::inputdevice::TrackPoint;
 using InputDevices = com::deepin::daemon::InputDevices;
 
+class DBusCallCoalescer;
+
 namespace dcc {
 namespace mouse {
 class MouseDBusProxy : public QObject
@@ -66,6 +68,7 @@ private:
     InputDevices *m_dbusDevices;
     MouseWorker  *m_worker;
     QDBusInterface *m_systemTouchpad;
+    DBusCallCoalescer *m_sliderCalls;   // 速度滑动条拖动时只发送最新的值
 };
 }
 }
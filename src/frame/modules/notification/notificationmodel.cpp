@@ -29,23 +29,30 @@ void NotificationModel::clearModel()
     m_sysItemModel = nullptr;
     qDeleteAll(m_appItemModels);
     m_appItemModels.clear();
+    m_appIndex.clear();
 }
 
 void NotificationModel::appAdded(AppItemModel *item)
 {
-    m_appItemModels.append(item);
+    appsAdded({ item });
+}
+
+void NotificationModel::appsAdded(const QList<AppItemModel *> &items)
+{
+    for (AppItemModel *item : items) {
+        m_appItemModels.append(item);
+        m_appIndex.insert(item->getActName(), item);
+    }
+
     Q_EMIT appListChanged();
 }
 
 void NotificationModel::appRemoved(const QString &appName)
 {
-    for (int i = 0; i < m_appItemModels.size(); i++) {
-        if (m_appItemModels[i]->getActName() == appName) {
-            m_appItemModels[i]->deleteLater();
-            m_appItemModels[i] = nullptr;
-            m_appItemModels.removeAt(i);
-            break;
-        }
+    AppItemModel *item = m_appIndex.take(appName);
+    if (item) {
+        m_appItemModels.removeOne(item);
+        item->deleteLater();
     }
 
     Q_EMIT appListChanged();
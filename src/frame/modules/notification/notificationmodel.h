@@ -6,6 +6,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 
 QT_BEGIN_NAMESPACE
 class QJsonArray;
@@ -26,10 +27,13 @@ public:
     inline int getAppSize()const {return m_appItemModels.size();}
     inline SysItemModel *getSystemModel()const {return m_sysItemModel;}
     inline AppItemModel *getAppModel(const int &index) {return m_appItemModels[index];}
+    inline AppItemModel *getAppModel(const QString &appName) const {return m_appIndex.value(appName);}
     void clearModel();
 
 public Q_SLOTS:
     void appAdded(AppItemModel* item);
+    // 批量添加，列表只刷新一次
+    void appsAdded(const QList<AppItemModel *> &items);
     void appRemoved(const QString &appName);
 
 Q_SIGNALS:
@@ -38,6 +42,7 @@ Q_SIGNALS:
 private:
     SysItemModel *m_sysItemModel;
     QList<AppItemModel *> m_appItemModels;
+    QHash<QString, AppItemModel *> m_appIndex;  // 应用名 -> 应用设置
     QString m_theme;
 };
 
@@ -5,7 +5,9 @@
 #include "notificationworker.h"
 #include "model/appitemmodel.h"
 #include "model/sysitemmodel.h"
+#include "window/dbuspropertybatch.h"
 
+#include <QDebug>
 #include <QtConcurrent>
 
 const QString Path    = "/com/deepin/dde/Notification";
@@ -20,6 +22,8 @@ NotificationWorker::NotificationWorker(NotificationModel *model, QObject *parent
 {
     connect(m_dbus, &Notification::AppAddedSignal, this, &NotificationWorker::onAppAdded);
     connect(m_dbus, &Notification::AppRemovedSignal, this, &NotificationWorker::onAppRemoved);
+    // 只连接一次，按应用名转发给对应的应用设置
+    connect(m_dbus, &Notification::AppInfoChanged, this, &NotificationWorker::onAppInfoChanged);
 }
 
 void NotificationWorker::active(bool sync)
@@ -55,26 +59,77 @@ void NotificationWorker::initSystemSetting()
 
 void NotificationWorker::initAppSetting()
 {
-    QStringList appList = m_dbus->GetAppList();
-    for (int i = 0; i < appList.size(); i++) {
-        onAppAdded(appList[i]);
-    }
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbus->GetAppList(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        QDBusPendingReply<QStringList> reply = *watcher;
+        if (!reply.isError())
+            loadApps(reply.value());
+        else
+            qWarning() << reply.error();
+
+        watcher->deleteLater();
+    });
 }
 
 void NotificationWorker::onAppAdded(const QString &id)
 {
-    AppItemModel *item = new AppItemModel(this);
-    item->setActName(id);
-    item->setSoftName(m_dbus->GetAppInfo(id, AppItemModel::APPNAME).value().variant().toString());
-    item->setIcon(m_dbus->GetAppInfo(id, AppItemModel::APPICON).value().variant().toString());
-    item->setAllowNotify(m_dbus->GetAppInfo(id, AppItemModel::ENABELNOTIFICATION).value().variant().toBool());
-    item->setShowNotifyPreview(m_dbus->GetAppInfo(id, AppItemModel::ENABELPREVIEW).value().variant().toBool());
-    item->setNotifySound(m_dbus->GetAppInfo(id, AppItemModel::ENABELSOUND).value().variant().toBool());
-    item->setShowInNotifyCenter(m_dbus->GetAppInfo(id, AppItemModel::SHOWINNOTIFICATIONCENTER).value().variant().toBool());
-    item->setLockShowNotify(m_dbus->GetAppInfo(id, AppItemModel::LOCKSCREENSHOWNOTIFICATION).value().variant().toBool());
-
-    connect(m_dbus, &Notification::AppInfoChanged, item, &AppItemModel::onSettingChanged);
-    m_model->appAdded(item);
+    loadApps({ id });
+}
+
+void NotificationWorker::loadApps(const QStringList &ids)
+{
+    static const QList<uint> configItems = { AppItemModel::APPNAME,
+                                             AppItemModel::APPICON,
+                                             AppItemModel::ENABELNOTIFICATION,
+                                             AppItemModel::ENABELPREVIEW,
+                                             AppItemModel::ENABELSOUND,
+                                             AppItemModel::SHOWINNOTIFICATIONCENTER,
+                                             AppItemModel::LOCKSCREENSHOWNOTIFICATION };
+
+    // 所有应用的所有配置同时请求，全部返回后一次性创建
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    for (const QString &id : ids) {
+        for (uint configItem : configItems)
+            batch->addCall(id + '/' + QString::number(configItem), m_dbus->GetAppInfo(id, configItem));
+    }
+
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        batch->deleteLater();
+
+        QList<AppItemModel *> items;
+        for (const QString &id : ids) {
+            // 加载期间收到的 AppAddedSignal 可能重复添加
+            if (m_model->getAppModel(id))
+                continue;
+
+            auto value = [ & ](uint configItem) {
+                QDBusPendingReply<QDBusVariant> reply = batch->call(id + '/' + QString::number(configItem));
+                return reply.isError() ? QVariant() : reply.value().variant();
+            };
+
+            AppItemModel *item = new AppItemModel(this);
+            item->setActName(id);
+            item->setSoftName(value(AppItemModel::APPNAME).toString());
+            item->setIcon(value(AppItemModel::APPICON).toString());
+            item->setAllowNotify(value(AppItemModel::ENABELNOTIFICATION).toBool());
+            item->setShowNotifyPreview(value(AppItemModel::ENABELPREVIEW).toBool());
+            item->setNotifySound(value(AppItemModel::ENABELSOUND).toBool());
+            item->setShowInNotifyCenter(value(AppItemModel::SHOWINNOTIFICATIONCENTER).toBool());
+            item->setLockShowNotify(value(AppItemModel::LOCKSCREENSHOWNOTIFICATION).toBool());
+            items << item;
+        }
+
+        if (!items.isEmpty())
+            m_model->appsAdded(items);
+    });
+    batch->start();
+}
+
+void NotificationWorker::onAppInfoChanged(const QString &id, uint item, const QDBusVariant &var)
+{
+    AppItemModel *appItem = m_model->getAppModel(id);
+    if (appItem)
+        appItem->onSettingChanged(id, item, var);
 }
 
 void NotificationWorker::onAppRemoved(const QString &id)
@@ -36,6 +36,12 @@ public Q_SLOTS:
     void setAppSetting(const QString &id, uint item, QVariant var);
     void setSystemSetting(uint item, QVariant var);
 
+private Q_SLOTS:
+    void onAppInfoChanged(const QString &id, uint item, const QDBusVariant &var);
+
+private:
+    void loadApps(const QStringList &ids);
+
 private:
     NotificationModel *m_model;
     Notification *m_dbus;
@@ -31,14 +31,26 @@ QMap<QString, QString> ThemeModel::getPicList() const
     return m_picList;
 }
 
-void ThemeModel::addPic(const QString &id, const QString &picPath)
+void ThemeModel::addPic(const QString &id, const QString &picPath, const QImage &image)
 {
     m_picList.insert(id, picPath);
+    if (image.isNull())
+        m_picImages.remove(id);
+    else
+        m_picImages.insert(id, image);
+
     Q_EMIT picAdded(id, picPath);
 }
 
+QImage ThemeModel::picImage(const QString &id) const
+{
+    return m_picImages.value(id);
+}
+
 void ThemeModel::removeItem(const QString &id)
 {
     m_list.remove(id);
+    m_picList.remove(id);
+    m_picImages.remove(id);
     Q_EMIT itemRemoved(id);
 }
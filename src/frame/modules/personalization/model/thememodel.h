@@ -8,6 +8,7 @@
 #include <QObject>
 #include <QMap>
 #include <QJsonObject>
+#include <QImage>
 #include <QDebug>
 
 namespace dcc
@@ -27,7 +28,9 @@ public:
     inline QString getDefault() {return m_default;}
 
     QMap<QString, QString> getPicList() const;
-    void addPic(const QString &id, const QString &picPath);
+    // image 为已经解码的缩略图，界面有图片时不需要再读取 picPath
+    void addPic(const QString &id, const QString &picPath, const QImage &image = QImage());
+    QImage picImage(const QString &id) const;
 
     void removeItem(const QString &id);
 
@@ -41,6 +44,7 @@ private:
     QMap<QString, QJsonObject> m_list;
     QString m_default;
     QMap<QString, QString> m_picList;
+    QMap<QString, QImage> m_picImages;
 };
 }
 }
@@ -8,6 +8,7 @@
 #include "model/fontsizemodel.h"
 #include "window/dconfigwatcher.h"
 #include "window/utils.h"
+#include "window/collatorsort.h"
 
 #include <QGuiApplication>
 #include <QScreen>
@@ -44,6 +45,7 @@ PersonalizationWork::PersonalizationWork(PersonalizationModel *model, QObject *p
     , m_wmSwitcher(new WMSwitcher("com.deepin.WMSwitcher", "/com/deepin/WMSwitcher", QDBusConnection::sessionBus(), this))
     , m_wm(new WM("com.deepin.wm", "/com/deepin/wm", QDBusConnection::sessionBus(), this))
     , m_effects(new Effects("org.kde.KWin", "/Effects", QDBusConnection::sessionBus(), this))
+    , m_thumbnails(new ThemeThumbnailCache(this))
     , m_isWayland(qEnvironmentVariable("XDG_SESSION_TYPE").contains("wayland"))
 {
     ThemeModel *cursorTheme      = m_model->getMouseModel();
@@ -60,6 +62,7 @@ PersonalizationWork::PersonalizationWork(PersonalizationModel *model, QObject *p
     connect(m_dbus, &Appearance::StandardFontChanged,  fontStand,     &FontModel::setFontName);
     connect(m_dbus, &Appearance::FontSizeChanged, this, &PersonalizationWork::FontSizeChanged);
     connect(m_dbus, &Appearance::Refreshed, this, &PersonalizationWork::onRefreshedChanged);
+    connect(m_thumbnails, &ThemeThumbnailCache::thumbnailsReady, this, &PersonalizationWork::onThumbnailsReady);
 
     //connect(m_wmSwitcher, &WMSwitcher::WMChanged, this, &PersonalizationWork::onToggleWM);
     connect(m_dbus, &Appearance::OpacityChanged, this, &PersonalizationWork::refreshOpacity);
@@ -259,19 +262,10 @@ void PersonalizationWork::addList(ThemeModel *model, const QString &type, const
         object.insert("type", QJsonValue(type));
         objList << object;
         list.append(object["Id"].toString());
-
-        QDBusPendingReply<QString> pic = m_dbus->Thumbnail(type, object["Id"].toString());
-        QDBusPendingCallWatcher *picWatcher = new QDBusPendingCallWatcher(pic, this);
-        picWatcher->setProperty("category", type);
-        picWatcher->setProperty("id", object["Id"].toString());
-        connect(picWatcher, &QDBusPendingCallWatcher::finished, this, &PersonalizationWork::onGetPicFinished);
     }
 
     // sort for display name
-    std::sort(objList.begin(), objList.end(), [=] (const QJsonObject &obj1, const QJsonObject &obj2) {
-        QCollator qc;
-        return qc.compare(obj1["Id"].toString(), obj2["Id"].toString()) < 0;
-    });
+    collatorSort(objList, [](const QJsonObject &obj) { return obj["Id"].toString(); });
 
     for (const QJsonObject &obj : objList) {
         model->addItem(obj["Id"].toString(), obj);
@@ -282,6 +276,12 @@ void PersonalizationWork::addList(ThemeModel *model, const QString &type, const
             model->removeItem(id);
         }
     }
+
+    // 缩略图优先使用缓存，缓存中没有的才向后端请求
+    m_thumbnails->setDevicePixelRatio(qApp->devicePixelRatio());
+    m_thumbnails->load(type, objList, [ = ](const QString &id) -> QDBusPendingCall {
+        return m_dbus->Thumbnail(type, id);
+    });
 }
 
 void PersonalizationWork::refreshWMState()
@@ -348,20 +348,16 @@ void PersonalizationWork::onGetThemeFinished(QDBusPendingCallWatcher *w)
     w->deleteLater();
 }
 
-void PersonalizationWork::onGetPicFinished(QDBusPendingCallWatcher *w)
+void PersonalizationWork::onThumbnailsReady(const QString &type, const QList<ThemeThumbnail> &thumbnails)
 {
-    QDBusPendingReply<QString> reply = *w;
-
-    if (!reply.isError()) {
-        const QString &category = w->property("category").toString();
-        const QString &id = w->property("id").toString();
+    ThemeModel *model = m_themeModels.value(type);
+    if (!model)
+        return;
 
-        m_themeModels[category]->addPic(id, reply.value());
-    } else {
-        qWarning() << reply.error();
+    for (const ThemeThumbnail &thumbnail : thumbnails) {
+        if (!thumbnail.path.isEmpty())
+            model->addPic(thumbnail.id, thumbnail.path, thumbnail.image);
     }
-
-    w->deleteLater();
 }
 
 void PersonalizationWork::onGetActiveColorFinished(QDBusPendingCallWatcher *w)
@@ -461,10 +457,7 @@ void PersonalizationWork::setFontList(FontModel *model, const QString &type, con
 
             QList<QJsonObject> list = converToList(type, arrayValue);
             // sort for display name
-            std::sort(list.begin(), list.end(), [=] (const QJsonObject &obj1, const QJsonObject &obj2) {
-                QCollator qc;
-                return qc.compare(obj1["Name"].toString(), obj2["Name"].toString()) < 0;
-            });
+            collatorSort(list, [](const QJsonObject &obj) { return obj["Name"].toString(); });
 
             model->setFontList(list);
         } else {
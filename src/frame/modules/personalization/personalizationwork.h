@@ -6,6 +6,7 @@
 #define PERSONALIZATIONWORK_H
 
 #include "personalizationmodel.h"
+#include "themethumbnailcache.h"
 #include <QObject>
 #include <QDebug>
 #include <QStringList>
@@ -59,7 +60,7 @@ private Q_SLOTS:
     void FontSizeChanged(const double value) const;
     void onGetFontFinished(QDBusPendingCallWatcher *w);
     void onGetThemeFinished(QDBusPendingCallWatcher *w);
-    void onGetPicFinished(QDBusPendingCallWatcher *w);
+    void onThumbnailsReady(const QString &type, const QList<ThemeThumbnail> &thumbnails);
     void onGetActiveColorFinished(QDBusPendingCallWatcher *w);
     void onRefreshedChanged(const QString &type);
     void onToggleWM(const QString &wm);
@@ -93,6 +94,7 @@ private:
     WM *m_wm;
     Effects *m_effects;
     QMap<QString, ThemeModel*> m_themeModels;
+    ThemeThumbnailCache *m_thumbnails;
     QMap<QString, FontModel*> m_fontModels;
     QGSettings *m_setting;
     bool m_isWayland;
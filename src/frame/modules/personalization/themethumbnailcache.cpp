@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "themethumbnailcache.h"
+
+#include <QCryptographicHash>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+using namespace dcc::personalization;
+
+ThemeThumbnailCache::ThemeThumbnailCache(QObject *parent)
+    : QObject(parent)
+    , m_cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/theme-thumbnails")
+    , m_ratio(1.0)
+{
+
+}
+
+void ThemeThumbnailCache::setCacheDir(const QString &dir)
+{
+    m_cacheDir = dir;
+}
+
+void ThemeThumbnailCache::setDevicePixelRatio(qreal ratio)
+{
+    m_ratio = ratio > 0 ? ratio : 1.0;
+}
+
+QString ThemeThumbnailCache::cacheFile(const QString &type, const QJsonObject &theme) const
+{
+    const QFileInfo themeDir(theme["Path"].toString());
+    if (themeDir.filePath().isEmpty() || !themeDir.exists())
+        return QString();
+
+    // 同一个主题只保留一个缓存文件，文件名前缀相同的旧文件在写入时删除
+    const QByteArray &idHash = QCryptographicHash::hash(theme["Id"].toString().toUtf8(), QCryptographicHash::Md5).toHex();
+    return QString("%1/%2_%3_%4@%5.png").arg(m_cacheDir, type, QString::fromLatin1(idHash))
+                                         .arg(themeDir.lastModified().toMSecsSinceEpoch())
+                                         .arg(qRound(m_ratio * 100));
+}
+
+void ThemeThumbnailCache::load(const QString &type, const QList<QJsonObject> &themes, const Requester &requester)
+{
+    const int generation = ++m_generations[type];
+    QDir().mkpath(m_cacheDir);
+
+    QList<ThemeThumbnail> cached;
+    QSharedPointer<QList<ThemeThumbnail>> missing(new QList<ThemeThumbnail>);
+    for (const QJsonObject &theme : themes) {
+        ThemeThumbnail thumbnail;
+        thumbnail.id = theme["Id"].toString();
+        thumbnail.cacheFile = cacheFile(type, theme);
+        thumbnail.ratio = m_ratio;
+
+        if (!thumbnail.cacheFile.isEmpty() && QFile::exists(thumbnail.cacheFile)) {
+            thumbnail.source = thumbnail.cacheFile;
+            cached << thumbnail;
+        } else {
+            missing->append(thumbnail);
+        }
+    }
+
+    if (!cached.isEmpty())
+        decode(type, generation, cached);
+
+    if (missing->isEmpty())
+        return;
+
+    // 后端没有批量获取的接口，同时发出所有请求，全部返回后再一起解码
+    QSharedPointer<int> remaining(new int(missing->size()));
+    for (int i = 0; i < missing->size(); ++i) {
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(requester(missing->at(i).id), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+            QDBusPendingReply<QString> reply = *watcher;
+            if (!reply.isError())
+                (*missing)[i].source = reply.value();
+            else
+                qWarning() << reply.error();
+
+            watcher->deleteLater();
+            if (--(*remaining) == 0)
+                decode(type, generation, *missing);
+        });
+    }
+}
+
+void ThemeThumbnailCache::decode(const QString &type, int generation, const QList<ThemeThumbnail> &thumbnails)
+{
+    if (m_generations.value(type) != generation)
+        return;
+
+    QFutureWatcher<ThemeThumbnail> *watcher = new QFutureWatcher<ThemeThumbnail>(this);
+    connect(watcher, &QFutureWatcher<ThemeThumbnail>::finished, this, [ = ] {
+        watcher->deleteLater();
+        if (m_generations.value(type) != generation)
+            return;
+
+        Q_EMIT thumbnailsReady(type, watcher->future().results());
+    });
+    watcher->setFuture(QtConcurrent::mapped(thumbnails, &ThemeThumbnailCache::render));
+}
+
+ThemeThumbnail ThemeThumbnailCache::render(const ThemeThumbnail &thumbnail)
+{
+    ThemeThumbnail result = thumbnail;
+    if (thumbnail.source.isEmpty())
+        return result;
+
+    if (thumbnail.source == thumbnail.cacheFile) {
+        // 缓存文件已经缩放过，损坏时删除，下次刷新重新获取
+        result.image = QImage(thumbnail.cacheFile);
+        if (result.image.isNull()) {
+            QFile::remove(thumbnail.cacheFile);
+            return result;
+        }
+
+        result.image.setDevicePixelRatio(thumbnail.ratio);
+        result.path = thumbnail.cacheFile;
+        return result;
+    }
+
+    // 无法解码时界面仍使用后端返回的图片
+    result.path = thumbnail.source;
+
+    // 矢量图按设备像素比放大，位图本身已经是屏幕缩放后的大小
+    QImageReader reader(thumbnail.source);
+    const QSize size = reader.size();
+    if (reader.format() == "svg" && size.isValid())
+        reader.setScaledSize(size * thumbnail.ratio);
+
+    QImage image = reader.read();
+    if (image.isNull())
+        return result;
+
+    image.setDevicePixelRatio(thumbnail.ratio);
+    result.image = image;
+
+    if (thumbnail.cacheFile.isEmpty() || !image.save(thumbnail.cacheFile, "PNG"))
+        return result;
+
+    result.path = thumbnail.cacheFile;
+
+    const QFileInfo cacheInfo(thumbnail.cacheFile);
+    const QString prefix = cacheInfo.fileName().section('_', 0, 1) + "_*.png";
+    for (const QFileInfo &old : cacheInfo.dir().entryInfoList({ prefix }, QDir::Files)) {
+        if (old.fileName() != cacheInfo.fileName())
+            QFile::remove(old.filePath());
+    }
+
+    return result;
+}
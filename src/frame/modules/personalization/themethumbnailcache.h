@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef THEMETHUMBNAILCACHE_H
+#define THEMETHUMBNAILCACHE_H
+
+#include <QDBusPendingCall>
+#include <QImage>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QObject>
+
+#include <functional>
+
+namespace dcc
+{
+namespace personalization
+{
+
+struct ThemeThumbnail
+{
+    QString id;
+    QString source;     // 待解码的图片，缓存命中时就是缓存文件
+    QString cacheFile;  // 主题没有路径时为空，不缓存
+    qreal ratio = 1.0;
+
+    QString path;       // 解码结果，界面使用的图片路径
+    QImage image;
+};
+
+/**
+ * @brief 主题缩略图缓存
+ * 缩略图按主题 id 和主题目录的修改时间缓存在用户缓存目录中，保存的是按设备像素比缩放好的 PNG，
+ * 缓存中没有的主题一起向后端请求，全部返回后在线程池中解码，每个分类每次刷新只更新一次界面。
+ */
+class ThemeThumbnailCache : public QObject
+{
+    Q_OBJECT
+public:
+    using Requester = std::function<QDBusPendingCall(const QString &id)>;
+
+    explicit ThemeThumbnailCache(QObject *parent = nullptr);
+
+    void setCacheDir(const QString &dir);
+    inline QString cacheDir() const { return m_cacheDir; }
+    void setDevicePixelRatio(qreal ratio);
+
+    // 加载一个分类的所有缩略图，requester 返回后端 Thumbnail 调用
+    void load(const QString &type, const QList<QJsonObject> &themes, const Requester &requester);
+    QString cacheFile(const QString &type, const QJsonObject &theme) const;
+
+    // 在线程池中执行，解码并写入缓存
+    static ThemeThumbnail render(const ThemeThumbnail &thumbnail);
+
+Q_SIGNALS:
+    void thumbnailsReady(const QString &type, const QList<ThemeThumbnail> &thumbnails);
+
+private:
+    void decode(const QString &type, int generation, const QList<ThemeThumbnail> &thumbnails);
+
+private:
+    QString m_cacheDir;
+    qreal m_ratio;
+    QMap<QString, int> m_generations; // 每个分类的刷新次数，丢弃过期的结果
+};
+
+}
+}
+
+#endif // THEMETHUMBNAILCACHE_H
@@ -9,6 +9,10 @@
 #include <DIconButton>
 
 #include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
 #include <QDBusInterface>
 #include <QDBusReply>
 #include <QStandardItemModel>
@@ -203,6 +207,7 @@ void SoundModel::addPort(Port *port)
 {
     if (!containsPort(port)) {
         m_ports.append(port);
+        m_portIndex.insert(qMakePair(port->cardId(), port->id()), port);
 
         if (port->direction() == Port::Out) {
             m_outputPorts.append(port);
@@ -222,6 +227,7 @@ void SoundModel::removePort(const QString &portId, const uint &cardId)
     if (port) {
         Q_EMIT portRemoved(portId, cardId, port->direction());
         m_ports.removeOne(port);
+        m_portIndex.remove(qMakePair(cardId, portId));
 
         if (port->direction() == Port::Out) {
             m_outputPorts.removeOne(port);
@@ -240,15 +246,7 @@ bool SoundModel::containsPort(const Port *port)
 
 Port *SoundModel::findPort(const QString &portId, const uint &cardId) const
 {
-    auto res = std::find_if(m_ports.cbegin(), m_ports.end(), [=] (const Port *data)->bool {
-        return ((data->id() == portId) && (data->cardId() == cardId));
-    });
-
-    if (res != m_ports.cend()) {
-        return *res;
-    }
-
-    return nullptr;
+    return m_portIndex.value(qMakePair(cardId, portId), nullptr);
 }
 
 QList<Port *> SoundModel::ports() const
@@ -256,6 +254,59 @@ QList<Port *> SoundModel::ports() const
     return m_ports;
 }
 
+void SoundModel::updatePorts(const QString &cards, const std::function<bool(uint, const QString &)> &isActive)
+{
+    QSet<QPair<uint, QString>> currentPorts;
+    const QJsonArray &jCards = QJsonDocument::fromJson(cards.toUtf8()).array();
+    for (const QJsonValue &cV : jCards) {
+        const QJsonObject &jCard = cV.toObject();
+        const uint cardId = static_cast<uint>(jCard["Id"].toInt());
+        const QString &cardName = jCard["Name"].toString();
+
+        for (const QJsonValue &pV : jCard["Ports"].toArray()) {
+            const QJsonObject &jPort = pV.toObject();
+            const double portAvai = jPort["Available"].toDouble();
+            if (portAvai != 2.0 && portAvai != 0.0)  // 0 Unknown 1 Not available 2 Available
+                continue;
+
+            const QString &portId = jPort["Name"].toString();
+            const Port::Direction direction = Port::Direction(jPort["Direction"].toDouble());
+            currentPorts.insert(qMakePair(cardId, portId));
+
+            // 方向变化时端口要换到另一个列表，按删除后重新添加处理
+            Port *port = findPort(portId, cardId);
+            if (port && port->direction() != direction) {
+                removePort(portId, cardId);
+                port = nullptr;
+            }
+
+            const bool include = port != nullptr;
+            if (!include) {
+                port = new Port(this);
+                port->setId(portId);
+                port->setCardId(cardId);
+                port->setDirection(direction);
+            }
+
+            // 已有端口的属性只在变化时发出信号
+            port->setName(jPort["Description"].toString());
+            port->setCardName(cardName);
+            port->setEnabled(jPort["Enabled"].toBool());
+            port->setIsBluetoothPort(jPort["Bluetooth"].toBool());
+            port->setIsActive(isActive(cardId, portId));
+
+            if (!include)
+                addPort(port);
+        }
+    }
+
+    // 删除声卡信息中已经没有的端口
+    for (Port *port : ports()) {
+        if (!currentPorts.contains(qMakePair(port->cardId(), port->id())))
+            removePort(port->id(), port->cardId());
+    }
+}
+
 void SoundModel::setSpeakerVolume(double speakerVolume)
 {
     if (!qFuzzyCompare(m_speakerVolume, speakerVolume)) {
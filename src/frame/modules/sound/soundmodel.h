@@ -8,9 +8,13 @@
 #include <QDBusObjectPath>
 #include <QObject>
 #include <QMap>
+#include <QHash>
+#include <QPair>
 #include <QString>
 #include <QLabel>
 
+#include <functional>
+
 #include <DDesktopServices>
 #include <DToolButton>
 DWIDGET_USE_NAMESPACE
@@ -137,6 +141,8 @@ public:
     bool containsPort(const Port *port);
     Port *findPort(const QString &portId, const uint &cardId) const;
     QList<Port *> ports() const;
+    // 按 (声卡 id, 端口 id) 与声卡信息比较，只添加、删除或更新有变化的端口
+    void updatePorts(const QString &cards, const std::function<bool(uint cardId, const QString &portId)> &isActive);
 
     inline double speakerVolume() const { return m_speakerVolume; }
     void setSpeakerVolume(double speakerVolume);
@@ -258,6 +264,8 @@ private:
     QString m_microphoneName;
     double m_microphoneFeedback;
     QList<Port *> m_ports;
+    // (声卡 id, 端口 id) 到端口的索引，声卡信息变化时直接查找端口
+    QHash<QPair<uint, QString>, Port *> m_portIndex;
     QList<Port *> m_inputPorts;
     QList<Port *> m_outputPorts;
     Port *m_activePort;
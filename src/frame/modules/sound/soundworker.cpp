@@ -3,10 +3,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "soundworker.h"
+#include "window/dbuscallcoalescer.h"
 
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QDebug>
 #include <QGSettings>
 
@@ -28,10 +26,14 @@ SoundWorker::SoundWorker(SoundModel *model, QObject *parent)
     , m_dccSettings(new QGSettings("com.deepin.dde.control-center", QByteArray(), this))
     , m_pingTimer(new QTimer(this))
     , m_inter(QDBusConnection::sessionBus().interface())
+    , m_sliderCalls(new DBusCallCoalescer(this))
 {
     m_audioInter->setSync(false);
     m_powerInter->setSync(false);
 
+    // 调节音量时后端会同步到声卡，限制拖动滑动条时的调用频率
+    m_sliderCalls->setMinimumInterval(50);
+
     m_pingTimer->setInterval(5000);
     m_pingTimer->setSingleShot(false);
 
@@ -151,26 +153,38 @@ void SoundWorker::setPortEnabled(unsigned int cardid, QString portName, bool ena
 
 void SoundWorker::setSinkBalance(double balance)
 {
-    if (m_defaultSink) {
-        m_defaultSink->SetBalance(balance, true);
+    if (!m_defaultSink)
+        return;
+
+    Sink *sink = m_defaultSink;
+    m_sliderCalls->post("SinkBalance:" + sink->path(), [ = ] {
         qDebug() << "set balance to " << balance;
-    }
+        return sink->SetBalance(balance, true);
+    }, sink);
 }
 
 void SoundWorker::setSourceVolume(double volume)
 {
-    if (m_defaultSource) {
-        m_defaultSource->SetVolume(volume, true);
+    if (!m_defaultSource)
+        return;
+
+    Source *source = m_defaultSource;
+    m_sliderCalls->post("SourceVolume:" + source->path(), [ = ] {
         qDebug() << "set source volume to " << volume;
-    }
+        return source->SetVolume(volume, true);
+    }, source);
 }
 
 void SoundWorker::setSinkVolume(double volume)
 {
-    if (m_defaultSink) {
-        m_defaultSink->SetVolume(volume, true);
+    if (!m_defaultSink)
+        return;
+
+    Sink *sink = m_defaultSink;
+    m_sliderCalls->post("SinkVolume:" + sink->path(), [ = ] {
         qDebug() << "set sink volume to " << volume;
-    }
+        return sink->SetVolume(volume, true);
+    }, sink);
 }
 
 //切换输入静音状态，flag为false时直接取消静音
@@ -297,60 +311,18 @@ void SoundWorker::defaultSourceChanged(const QDBusObjectPath &path)
 
 void SoundWorker::cardsChanged(const QString &cards)
 {
-    QMap<uint, QStringList> tmpCardIds;
-    QJsonDocument doc = QJsonDocument::fromJson(cards.toUtf8());
-    QJsonArray jCards = doc.array();
-    for (QJsonValue cV : jCards) {
-        QJsonObject jCard = cV.toObject();
-        const uint cardId = static_cast<uint>(jCard["Id"].toInt());
-        const QString cardName = jCard["Name"].toString();
-        QJsonArray jPorts = jCard["Ports"].toArray();
-
-        QStringList tmpPorts;
-
-        for (QJsonValue pV : jPorts) {
-            QJsonObject jPort = pV.toObject();
-            const double portAvai = jPort["Available"].toDouble();
-            if (portAvai == 2.0 || portAvai == 0.0) {  // 0 Unknown 1 Not available 2 Available
-                const QString portId = jPort["Name"].toString();
-                const QString portName = jPort["Description"].toString();
-                const bool isEnabled = jPort["Enabled"].toBool();
-                const bool isBluetooth = jPort["Bluetooth"].toBool();
-
-                Port *port = m_model->findPort(portId, cardId);
-                const bool include = port != nullptr;
-                if (!include) { port = new Port(m_model); }
-
-                port->setId(portId);
-                port->setName(portName);
-                port->setDirection(Port::Direction(jPort["Direction"].toDouble()));
-                port->setCardId(cardId);
-                port->setCardName(cardName);
-                port->setEnabled(isEnabled);
-                port->setIsBluetoothPort(isBluetooth);
-
-                const bool isActiveOuputPort = (portId == m_activeSinkPort) && (cardId == m_activeOutputCard);
-                const bool isActiveInputPort = (portId == m_activeSourcePort) && (cardId == m_activeInputCard);
-
-                port->setIsActive(isActiveInputPort || isActiveOuputPort);
-
-                if (!include) { m_model->addPort(port); }
-
-                tmpPorts << portId;
-            }
-        }
-        if (!jPorts.isEmpty())
-            tmpCardIds.insert(cardId, tmpPorts);
+    // 切换耳机配置时后端会连续发送相同的声卡信息，没有变化时只需要刷新当前端口
+    if (cards == m_cards) {
+        updatePortActivity();
+        return;
     }
+    m_cards = cards;
 
-    for (Port *port : m_model->ports()) {
-        //if the card is not in the list
-        if (!tmpCardIds.contains(port->cardId())) {
-            m_model->removePort(port->id(), port->cardId());
-        } else if (!tmpCardIds[port->cardId()].contains(port->id())) {
-            m_model->removePort(port->id(), port->cardId());
-        }
-    }
+    m_model->updatePorts(cards, [this](uint cardId, const QString &portId) {
+        const bool isActiveOuputPort = (portId == m_activeSinkPort) && (cardId == m_activeOutputCard);
+        const bool isActiveInputPort = (portId == m_activeSourcePort) && (cardId == m_activeInputCard);
+        return isActiveInputPort || isActiveOuputPort;
+    });
 }
 
 void SoundWorker::sourcesChanged(const QList<QDBusObjectPath> &sources)
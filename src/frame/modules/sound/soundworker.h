@@ -28,6 +28,7 @@ using com::deepin::daemon::audio::Meter;
 using com::deepin::daemon::SoundEffect;
 using SystemPowerInter = com::deepin::system::Power;
 class QGSettings;
+class DBusCallCoalescer;
 
 namespace dcc {
 namespace sound {
@@ -86,6 +87,7 @@ private:
     QString m_activeSourcePort;
     uint m_activeOutputCard;
     uint m_activeInputCard;
+    QString m_cards; // 上次处理的声卡信息
 
     Audio *m_audioInter;
     SoundEffect *m_soundEffectInter;
@@ -100,6 +102,7 @@ private:
 
     QTimer *m_pingTimer;
     QDBusConnectionInterface *m_inter;
+    DBusCallCoalescer *m_sliderCalls;   // 音量、平衡滑动条拖动时只发送最新的值
     int m_waitSoundPortReceipt;
 };
 
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mirrorspeedprober.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace dcc {
+namespace update {
+
+MirrorSpeedProber::MirrorSpeedProber(QObject *parent)
+    : QObject(parent)
+    , m_maxParallel(8)
+    , m_timeout(3000)
+    , m_cacheTtl(10 * 60 * 1000)
+{
+
+}
+
+MirrorSpeedProber::~MirrorSpeedProber()
+{
+    cancel();
+}
+
+void MirrorSpeedProber::start(const QList<QPair<QString, QUrl>> &mirrors)
+{
+    cancel();
+
+    m_queue = mirrors;
+    startNext();
+}
+
+void MirrorSpeedProber::cancel()
+{
+    m_queue.clear();
+
+    for (auto it = m_probes.begin(); it != m_probes.end(); ++it) {
+        QTcpSocket *socket = it.key();
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+    m_probes.clear();
+}
+
+void MirrorSpeedProber::startNext()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    while (m_probes.size() < m_maxParallel && !m_queue.isEmpty()) {
+        const QPair<QString, QUrl> mirror = m_queue.takeFirst();
+        const QString &key = cacheKey(mirror.second);
+
+        auto cache = m_cache.constFind(key);
+        if (cache != m_cache.constEnd() && now - cache.value().second < m_cacheTtl) {
+            Q_EMIT resultReady(mirror.first, cache.value().first);
+            continue;
+        }
+
+        if (mirror.second.host().isEmpty()) {
+            qWarning() << "Invalid mirror url:" << mirror.second;
+            Q_EMIT resultReady(mirror.first, TimeoutValue);
+            continue;
+        }
+
+        QTcpSocket *socket = new QTcpSocket(this);
+        QTimer *timer = new QTimer(socket);
+        timer->setSingleShot(true);
+        timer->setInterval(m_timeout);
+
+        connect(timer, &QTimer::timeout, this, [ = ] {
+            finishProbe(socket, TimeoutValue);
+        });
+        connect(socket, &QTcpSocket::connected, this, [ = ] {
+            finishProbe(socket, qMax<int>(1, static_cast<int>(m_probes.value(socket).elapsed.elapsed())));
+        });
+        connect(socket, static_cast<void (QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error), this, [ = ] {
+            qDebug() << "Test speed of" << mirror.second.host() << "failed:" << socket->errorString();
+            finishProbe(socket, TimeoutValue);
+        });
+
+        Probe probe;
+        probe.id = mirror.first;
+        probe.cacheKey = key;
+        probe.elapsed.start();
+        m_probes.insert(socket, probe);
+
+        // 域名解析的耗时也计算在内，与实际下载时的体验一致
+        socket->connectToHost(mirror.second.host(), static_cast<quint16>(mirror.second.port(mirror.second.scheme() == "https" ? 443 : 80)));
+        timer->start();
+    }
+
+    if (m_queue.isEmpty() && m_probes.isEmpty())
+        Q_EMIT finished();
+}
+
+void MirrorSpeedProber::finishProbe(QTcpSocket *socket, int latency)
+{
+    // 超时和连接错误可能先后触发，只处理第一次
+    auto it = m_probes.find(socket);
+    if (it == m_probes.end())
+        return;
+
+    const Probe probe = it.value();
+    m_probes.erase(it);
+
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+
+    // 只缓存成功的结果，暂时不可达的镜像在重试时需要重新测速
+    if (latency < TimeoutValue)
+        m_cache.insert(probe.cacheKey, qMakePair(latency, QDateTime::currentMSecsSinceEpoch()));
+    qDebug() << "speed of mirror" << probe.id << "is" << latency;
+
+    Q_EMIT resultReady(probe.id, latency);
+    startNext();
+}
+
+QString MirrorSpeedProber::cacheKey(const QUrl &url)
+{
+    return QString("%1:%2").arg(url.host()).arg(url.port(url.scheme() == "https" ? 443 : 80));
+}
+
+}
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MIRRORSPEEDPROBER_H
+#define MIRRORSPEEDPROBER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QUrl>
+
+class QTcpSocket;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief 镜像源测速
+ * 在当前线程的事件循环中异步建立 TCP 连接，以建立连接的耗时(毫秒)作为镜像的延迟，
+ * 同时进行的连接数和单个镜像的超时时间可以配置，超时或连接失败的镜像结果为 TimeoutValue。
+ * 成功的测速结果会缓存一段时间，缓存有效期内再次测速直接返回缓存结果，失败的结果不缓存。
+ */
+class MirrorSpeedProber : public QObject
+{
+    Q_OBJECT
+public:
+    static const int TimeoutValue = 10000;
+
+    explicit MirrorSpeedProber(QObject *parent = nullptr);
+    ~MirrorSpeedProber();
+
+    void setMaxParallel(int count) { m_maxParallel = qMax(1, count); }
+    void setTimeout(int msec) { m_timeout = msec; }
+    void setCacheTtl(int msec) { m_cacheTtl = msec; }
+    bool isRunning() const { return !m_queue.isEmpty() || !m_probes.isEmpty(); }
+
+    // 每一项为 <镜像id, 镜像地址>
+    void start(const QList<QPair<QString, QUrl>> &mirrors);
+    void cancel();
+    void clearCache() { m_cache.clear(); }
+
+Q_SIGNALS:
+    void resultReady(const QString &id, int latency);
+    void finished();
+
+private:
+    struct Probe {
+        QString id;
+        QString cacheKey;
+        QElapsedTimer elapsed;
+    };
+
+    void startNext();
+    void finishProbe(QTcpSocket *socket, int latency);
+    static QString cacheKey(const QUrl &url);
+
+private:
+    int m_maxParallel;
+    int m_timeout;
+    int m_cacheTtl;
+    QList<QPair<QString, QUrl>> m_queue;
+    QHash<QTcpSocket *, Probe> m_probes;
+    QHash<QString, QPair<int, qint64>> m_cache;     // <host:port, <延迟, 测速时间>>
+};
+
+}
+}
+
+#endif // MIRRORSPEEDPROBER_H
@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "updatelogcache.h"
+#include "window/utils.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// 缓存文件格式变化时需要修改版本号，旧的缓存会被直接丢弃
+const quint32 LogCacheMagic = 0x44434355; // "DCCU"
+const quint32 LogCacheVersion = 1;
+
+namespace dcc {
+namespace update {
+
+static QDataStream &operator<<(QDataStream &out, const UpdateLogItem &item)
+{
+    return out << item.id << item.platformType << item.serverType << item.logType
+               << item.systemVersion << item.cnLog << item.enLog << item.publishTime;
+}
+
+static QDataStream &operator>>(QDataStream &in, UpdateLogItem &item)
+{
+    return in >> item.id >> item.platformType >> item.serverType >> item.logType
+              >> item.systemVersion >> item.cnLog >> item.enLog >> item.publishTime;
+}
+
+UpdateLogCache::UpdateLogCache()
+    : m_loaded(false)
+{
+    m_cacheFile = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/update/update-log.cache";
+}
+
+bool UpdateLogCache::load()
+{
+    if (m_loaded)
+        return true;
+
+    m_loaded = true;
+    QFile file(m_cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != LogCacheMagic || version != LogCacheVersion) {
+        qInfo() << "Update log cache version mismatch, ignore it";
+        return false;
+    }
+
+    QString requestKey;
+    QByteArray etag, lastModified;
+    QList<UpdateLogItem> logs;
+    in >> requestKey >> etag >> lastModified >> logs;
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "Update log cache is broken:" << m_cacheFile;
+        return false;
+    }
+
+    // 内存中已有服务器返回的数据时不使用缓存覆盖
+    if (m_logs.isEmpty()) {
+        m_requestKey = requestKey;
+        m_etag = etag;
+        m_lastModified = lastModified;
+        m_logs = logs;
+        buildIndex();
+    }
+
+    qInfo() << "Load update logs from cache, size:" << m_logs.size();
+    return true;
+}
+
+bool UpdateLogCache::save() const
+{
+    QDir().mkpath(QFileInfo(m_cacheFile).absolutePath());
+
+    QSaveFile file(m_cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Can not open update log cache:" << m_cacheFile << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << LogCacheMagic << LogCacheVersion << m_requestKey << m_etag << m_lastModified << m_logs;
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "Write update log cache failed:" << m_cacheFile;
+        return false;
+    }
+
+    return true;
+}
+
+void UpdateLogCache::prepareRequest(QNetworkRequest &request, const QString &requestKey) const
+{
+    // 请求参数(平台、是否内测等)变化后缓存的日志已不可用，需要全量获取
+    if (m_logs.isEmpty() || requestKey != m_requestKey)
+        return;
+
+    if (!m_etag.isEmpty())
+        request.setRawHeader("If-None-Match", m_etag);
+    if (!m_lastModified.isEmpty())
+        request.setRawHeader("If-Modified-Since", m_lastModified);
+}
+
+void UpdateLogCache::setLogs(const QString &requestKey, const QByteArray &etag, const QByteArray &lastModified, const QList<UpdateLogItem> &logs)
+{
+    m_loaded = true;
+    m_requestKey = requestKey;
+    m_etag = etag;
+    m_lastModified = lastModified;
+    m_logs = logs;
+    buildIndex();
+}
+
+QList<UpdateLogItem> UpdateLogCache::logs(int logType) const
+{
+    return logs(m_typeIndex.value(logType));
+}
+
+QList<UpdateLogItem> UpdateLogCache::logs(int logType, const QString &systemVersion) const
+{
+    return logs(m_versionIndex.value(qMakePair(logType, normalizedVersion(systemVersion))));
+}
+
+QList<UpdateLogItem> UpdateLogCache::logs(const QVector<int> &indexes) const
+{
+    QList<UpdateLogItem> result;
+    result.reserve(indexes.size());
+    for (int index : indexes)
+        result << m_logs.at(index);
+
+    return result;
+}
+
+/**
+ * @brief 服务器返回 304 表示日志没有变化，继续使用缓存
+ */
+bool UpdateLogCache::isNotModified(const QNetworkReply *reply)
+{
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+}
+
+/**
+ * @brief 解析服务器返回的更新日志并排序，不涉及成员变量，可以在子线程中调用
+ */
+bool UpdateLogCache::parseLogs(const QByteArray &body, QList<UpdateLogItem> &logs)
+{
+    QJsonParseError error;
+    const QJsonDocument &doc = QJsonDocument::fromJson(body, &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "Parse update log error: " << error.errorString();
+        return false;
+    }
+
+    const QJsonObject &obj = doc.object();
+    if (obj.isEmpty()) {
+        qWarning() << "Request body json object is empty";
+        return false;
+    }
+    if (obj.value("code").toInt() != 0) {
+        qWarning() << "Request update log failed";
+        return false;
+    }
+
+    const QJsonArray &array = obj.value("data").toArray();
+    logs.clear();
+    logs.reserve(array.size());
+    for (const QJsonValue &value : array) {
+        const QJsonObject &item = value.toObject();
+        if (item.isEmpty())
+            continue;
+
+        UpdateLogItem logItem;
+        logItem.id = item.value("id").toInt();
+        logItem.systemVersion = item.value("systemVersion").toString();
+        logItem.cnLog = item.value("cnLog").toString();
+        logItem.enLog = item.value("enLog").toString();
+        logItem.publishTime = DCC_NAMESPACE::utcDateTime2LocalDate(item.value("publishTime").toString());
+        logItem.platformType = item.value("platformType").toInt();
+        logItem.serverType = item.value("serverType").toInt();
+        logItem.logType = item.value("logType").toInt();
+        logs.append(std::move(logItem));
+    }
+
+    // 不依赖服务器返回来日志顺序，用systemVersion进行排序
+    // 如果systemVersion版本号相同，则用发布时间排序；不考虑版本号相同且发布时间相同的情况，这种情况应该由运维人员避免
+    std::sort(logs.begin(), logs.end(), [] (const UpdateLogItem &v1, const UpdateLogItem &v2) -> bool {
+        int compareRet = v1.systemVersion.compare(v2.systemVersion);
+        if (compareRet == 0) {
+            return v1.publishTime.compare(v2.publishTime) > 0;
+        }
+        return compareRet > 0;
+    });
+
+    return true;
+}
+
+/**
+ * @brief 安全更新只匹配同一维护线的系统版本，例如 1052 和 1053 都归到 1050
+ */
+QString UpdateLogCache::normalizedVersion(const QString &systemVersion)
+{
+    QString version = systemVersion;
+    if (!version.isEmpty())
+        version.replace(version.length() - 1, 1, '0');
+
+    return version;
+}
+
+void UpdateLogCache::buildIndex()
+{
+    m_typeIndex.clear();
+    m_versionIndex.clear();
+    for (int i = 0; i < m_logs.size(); ++i) {
+        const UpdateLogItem &item = m_logs.at(i);
+        if (!item.isValid())
+            continue;
+
+        m_typeIndex[item.logType] << i;
+        m_versionIndex[qMakePair(item.logType, normalizedVersion(item.systemVersion))] << i;
+    }
+}
+
+}
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef UPDATELOGCACHE_H
+#define UPDATELOGCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+class QNetworkReply;
+class QNetworkRequest;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief 更新日志中一个版本的信息
+ *
+ * 示例数据：
+ * {
+        "id": 1,
+        "platformType": 1,
+        "cnLog": "<p>中文日志</p>",
+        "enLog": "<p>英文日志</p>",
+        "serverType": 0,
+        "systemVersion": "1070U1",
+        "createdAt": "2022-08-10T17:45:54+08:00",
+        "logType": 1,
+        "publishTime": "2022-08-06T00:00:00+08:00"
+    }
+ */
+struct UpdateLogItem
+{
+    int id = -1;
+    int platformType = 1;
+    int serverType = 0;
+    int logType = 1;
+    QString systemVersion = "";
+    QString cnLog = "";
+    QString enLog = "";
+    QString publishTime = "";
+
+    bool isValid() const { return -1 != id; }
+};
+
+/**
+ * @brief 更新日志的本地缓存
+ * 日志保存在用户缓存目录中，同时记录服务器返回的 ETag/Last-Modified，
+ * 下次请求时带上 If-None-Match/If-Modified-Since，服务器返回 304 时直接使用缓存。
+ * 日志按 logType 和 systemVersion 建立索引，查询某一类日志时不需要遍历全部数据。
+ */
+class UpdateLogCache
+{
+public:
+    UpdateLogCache();
+
+    bool load();
+    bool save() const;
+
+    void prepareRequest(QNetworkRequest &request, const QString &requestKey) const;
+    void setLogs(const QString &requestKey, const QByteArray &etag, const QByteArray &lastModified, const QList<UpdateLogItem> &logs);
+
+    bool isEmpty() const { return m_logs.isEmpty(); }
+    int size() const { return m_logs.size(); }
+    QList<UpdateLogItem> logs(int logType) const;
+    QList<UpdateLogItem> logs(int logType, const QString &systemVersion) const;
+
+    static bool isNotModified(const QNetworkReply *reply);
+    static bool parseLogs(const QByteArray &body, QList<UpdateLogItem> &logs);
+    static QString normalizedVersion(const QString &systemVersion);
+
+private:
+    void buildIndex();
+    QList<UpdateLogItem> logs(const QVector<int> &indexes) const;
+
+private:
+    bool m_loaded;
+    QString m_cacheFile;
+    QString m_requestKey;
+    QByteArray m_etag;
+    QByteArray m_lastModified;
+    QList<UpdateLogItem> m_logs;    // 按版本号和发布时间倒序排列
+    QHash<int, QVector<int>> m_typeIndex;
+    QHash<QPair<int, QString>, QVector<int>> m_versionIndex;
+};
+
+}
+}
+
+#endif // UPDATELOGCACHE_H
@@ -6,6 +6,8 @@
 #include "window/utils.h"
 #include "widgets/utils.h"
 #include "window/dconfigwatcher.h"
+#include "window/dbuspropertybatch.h"
+#include "mirrorspeedprober.h"
 
 #include <QtConcurrent>
 #include <QFuture>
@@ -17,6 +19,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QDesktopServices>
+#include <QDir>
 #include <QVariant>
 
 #include <vector>
@@ -28,7 +31,10 @@ using namespace DCC_NAMESPACE;
 const QString TestingChannelPackage = "deepin-unstable-source";
 const QString ChangeLogFile = "/usr/share/deepin/release-note/UpdateInfo.json";
 const QString ChangeLogDic = "/usr/share/deepin/";
-const QString UpdateLogTmpFile = "/tmp/deepin-update-log.json";
+const QString DpkgStatusFile = "/var/lib/dpkg/status";
+const QString AptListsDir = "/var/lib/apt/lists";
+const QString AptSourcesDir = "/etc/apt/sources.list.d";
+const QString AptSourcesFile = "/etc/apt/sources.list";
 
 const int LogTypeSystem = 1;    // 系统更新
 const int LogTypeSecurity = 2;  // 安全更新
@@ -41,45 +47,130 @@ const QString DDEId = "dde";
 
 namespace dcc {
 namespace update {
-static int TestMirrorSpeedInternal(const QString &url, QPointer<QObject> baseObject)
+// 以 apt 列表文件名的形式表示仓库地址，例如 https://a.com/deepin/ -> a.com_deepin
+static QString AptRepositoryName(const QString &url)
 {
-    if (!baseObject || QCoreApplication::closingDown()) {
-        return -1;
+    QString name = url;
+    const int index = name.indexOf("://");
+    if (index >= 0)
+        name = name.mid(index + 3);
+
+    while (name.endsWith('/'))
+        name.chop(1);
+
+    return name.replace('/', '_');
+}
+
+// 依次读取 deb822 格式文件(dpkg status、apt Packages 列表)中每个包的 Package/Version/Status 字段
+template<typename Func>
+static void ReadPackageParagraphs(const QString &fileName, Func callback)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "Testing:" << "can not open" << fileName;
+        return;
     }
 
-    QStringList args;
-    args << url << "-s" << "1";
+    QByteArray package, version, status;
+    while (!file.atEnd()) {
+        const QByteArray &line = file.readLine();
+        if (line.trimmed().isEmpty()) {
+            if (!package.isEmpty())
+                callback(package, version, status);
+            package.clear();
+            version.clear();
+            status.clear();
+        } else if (line.startsWith("Package:")) {
+            package = line.mid(8).trimmed();
+        } else if (line.startsWith("Version:")) {
+            version = line.mid(8).trimmed();
+        } else if (line.startsWith("Status:")) {
+            status = line.mid(7).trimmed();
+        }
+    }
+
+    if (!package.isEmpty())
+        callback(package, version, status);
+}
+
+// 没有可以直接读取的列表文件时(例如列表被压缩)，一次 apt-cache madison 查询全部包
+static void ReadSourcesByAptCache(const QHash<QByteArray, QByteArray> &installed, QHash<QByteArray, QSet<QString>> &sources)
+{
+    QStringList args("madison");
+    for (auto it = installed.constBegin(); it != installed.constEnd(); ++it)
+        args << QString::fromUtf8(it.key());
 
     QProcess process;
-    process.start("netselect", args);
+    process.start("apt-cache", args);
+    process.waitForFinished(-1);
+    while (process.canReadLine()) {
+        const QString line(process.readLine());
+        QStringList fields = line.split("|", QString::SkipEmptyParts);
+        if (fields.length() <= 2)
+            continue;
 
-    if (!process.waitForStarted()) {
-        return 10000;
+        const QByteArray &pkg = fields[0].trimmed().toUtf8();
+        const QByteArray &ver = fields[1].trimmed().toUtf8();
+        QString src = fields[2].trimmed();
+        src.truncate(src.indexOf(" "));
+        if (installed.value(pkg) == ver)
+            sources[pkg].insert(AptRepositoryName(src));
     }
+}
 
-    do {
-        if (!baseObject || QCoreApplication::closingDown()) {
-            process.kill();
-            process.terminate();
-            process.waitForFinished(1000);
+// 单次读取 dpkg 状态数据库和 apt 列表文件，判断是否有系统包只存在于内测源中
+static bool CanExitTestingChannelInternal(const QString &testingChannelSource)
+{
+    QHash<QByteArray, QByteArray> installed;
+    ReadPackageParagraphs(DpkgStatusFile, [ &installed ](const QByteArray &pkg, const QByteArray &version, const QByteArray &status) {
+        // skip uninstalled and non system software
+        if (status != "install ok installed")
+            return;
+        if (!pkg.contains("dde") && !pkg.contains("deepin") && !pkg.contains("dtk") && !pkg.contains("uos"))
+            return;
+        installed.insert(pkg, version);
+    });
 
-            return -1;
+    QHash<QByteArray, QSet<QString>> sources;
+    const QFileInfoList &lists = QDir(AptListsDir).entryInfoList(QStringList("*_Packages"), QDir::Files);
+    if (lists.isEmpty()) {
+        ReadSourcesByAptCache(installed, sources);
+    } else {
+        for (const QFileInfo &info : lists) {
+            // 列表文件名为 <仓库地址>_dists_<发行版>_<组件>_binary-<架构>_Packages
+            QString repository = info.fileName();
+            const int index = repository.indexOf("_dists_");
+            if (index >= 0)
+                repository.truncate(index);
+
+            ReadPackageParagraphs(info.absoluteFilePath(), [ & ](const QByteArray &pkg, const QByteArray &version, const QByteArray &) {
+                auto it = installed.constFind(pkg);
+                if (it != installed.constEnd() && it.value() == version)
+                    sources[pkg].insert(repository);
+            });
         }
+    }
 
-        if (process.waitForFinished(500))
-            break;
-    } while (process.state() == QProcess::Running);
-
-    const QString output = process.readAllStandardOutput().trimmed();
-    const QStringList result = output.split(' ');
+    // Does the package exists only in the internal test source
+    const QString &testingRepository = AptRepositoryName(testingChannelSource);
+    for (auto it = sources.constBegin(); it != sources.constEnd(); ++it) {
+        if (it.value().size() == 1 && it.value().begin()->contains(testingRepository)) {
+            qDebug() << "Testing:" << it.key() << "only exists in testing channel";
+            return false;
+        }
+    }
 
-    qDebug() << "speed of url" << url << "is" << result.first();
+    return true;
+}
 
-    if (!result.first().isEmpty()) {
-        return result.first().toInt();
-    }
+static qint64 LastModified(const QString &fileName)
+{
+    return QFileInfo(fileName).lastModified().toMSecsSinceEpoch();
+}
 
-    return 10000;
+static QString currentSystemVersion()
+{
+    return DCC_NAMESPACE::IsCommunitySystem ? Dtk::Core::DSysInfo::deepinVersion() : Dtk::Core::DSysInfo::minorVersion();
 }
 
 static int getPlatform()
@@ -123,6 +214,9 @@ UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     , m_iconThemeState("")
     , m_backupStatus(BackupStatus::NoBackup)
     , m_backupingClassifyType(ClassifyUpdateType::Invalid)
+    , m_mirrorSpeedProber(nullptr)
+    , m_testingChannelChecking(false)
+    , m_canExitTestingChannel(true)
 {
 
 }
@@ -254,20 +348,19 @@ void UpdateWorker::activate()
 #ifndef DISABLE_SYS_UPDATE_MIRRORS
     refreshMirrors();
 #endif
-    m_managerInter->setSync(true);
-    m_updateInter->setSync(true);
-    QString checkTime;
-    double interval = m_updateInter->GetCheckIntervalAndTime(checkTime);
-    m_model->setLastCheckUpdateTime(checkTime);
-    m_model->setAutoCheckUpdateCircle(static_cast<int>(interval));
+    // lastore 的属性通过一次 GetAll 批量获取，全部返回后再统一更新 model，不阻塞界面线程
+    DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+    batch->addInterface("manager", m_managerInter->connection(), m_managerInter->service(),
+                        m_managerInter->path(), m_managerInter->interface());
+    batch->addInterface("updater", m_updateInter->connection(), m_updateInter->service(),
+                        m_updateInter->path(), m_updateInter->interface());
+    batch->addCall("checkInterval", m_updateInter->asyncCall("GetCheckIntervalAndTime"));
+    connect(batch, &DBusPropertyBatch::finished, this, [ = ] {
+        onLastorePropertiesReady(batch);
+        batch->deleteLater();
+    });
+    batch->start();
 
-    m_model->setAutoCleanCache(m_managerInter->autoClean());
-    m_model->setAutoDownloadUpdates(m_updateInter->autoDownloadUpdates());
-    m_model->setAutoInstallUpdates(m_updateInter->autoInstallUpdates());
-    m_model->setAutoInstallUpdateType(m_updateInter->autoInstallUpdateType());
-    m_model->setAutoCheckUpdates(m_updateInter->autoCheckUpdates());
-    m_model->setUpdateMode(m_managerInter->updateMode());
-    m_model->setUpdateNotify(m_updateInter->updateNotify());
     if (IsCommunitySystem) {
         m_model->setSmartMirrorSwitch(m_smartMirrorInter->enable());
         onSmartMirrorServiceIsValid(m_smartMirrorInter->isValid());
@@ -281,21 +374,6 @@ void UpdateWorker::activate()
     setBatteryPercentage(m_powerInter->batteryPercentage());
     // setSystemBatteryPercentage(m_powerSystemInter->batteryPercentage());
 
-    const QList<QDBusObjectPath> jobs = m_managerInter->jobList();
-    if (jobs.count() > 0) {
-        for (QDBusObjectPath dBusObjectPath : jobs) {
-            if (dBusObjectPath.path().contains("upgrade")) {
-                qDebug() << "UpdateWorker::activate, jobs.count() == " << jobs.count();
-                setUpdateInfo();
-                break;
-            }
-        }
-    }
-
-    onJobListChanged(m_managerInter->jobList());
-    m_managerInter->setSync(false);
-    m_updateInter->setSync(false);
-
 #ifndef DISABLE_SYS_UPDATE_MIRRORS
     refreshMirrors();
 #endif
@@ -306,25 +384,6 @@ void UpdateWorker::activate()
                                          "com.deepin.license.Info", "LicenseStateChange",
                                          this, SLOT(licenseStateChangeSlot()));
 
-    QFutureWatcher<QMap<QString, QStringList>> *packagesWatcher = new QFutureWatcher<QMap<QString, QStringList>>();
-    connect(packagesWatcher, &QFutureWatcher<QStringList>::finished, this, [ = ] {
-        QMap<QString, QStringList> updatablePackages = std::move(packagesWatcher->result());
-        checkUpdatablePackages(updatablePackages);
-        packagesWatcher->deleteLater();
-    });
-
-    packagesWatcher->setFuture(QtConcurrent::run([ = ]() -> QMap<QString, QStringList> {
-        m_updateInter->setSync(true);
-        QMap<QString, QStringList> map;
-        if (!m_updateInter->isValid()) {
-            qDebug() << "com.deepin.license error ," << m_updateInter->lastError().name();
-            return map;
-        }
-        map = m_updateInter->classifiedUpdatablePackages();
-        m_updateInter->setSync(false);
-        return map;
-    }));
-
     QFutureWatcher<QString> *iconWatcher = new QFutureWatcher<QString>();
     connect(iconWatcher, &QFutureWatcher<QString>::finished, this, [ = ] {
         m_iconThemeState = iconWatcher->result();
@@ -340,6 +399,46 @@ void UpdateWorker::activate()
     }));
 }
 
+void UpdateWorker::onLastorePropertiesReady(DBusPropertyBatch *batch)
+{
+    const QVariantMap &manager = batch->properties("manager");
+    const QVariantMap &updater = batch->properties("updater");
+
+    if (!batch->hasError("checkInterval")) {
+        QDBusPendingReply<double, QString> reply = batch->call("checkInterval");
+        m_model->setLastCheckUpdateTime(reply.argumentAt<1>());
+        m_model->setAutoCheckUpdateCircle(static_cast<int>(reply.argumentAt<0>()));
+    }
+
+    if (!batch->hasError("manager")) {
+        m_model->setAutoCleanCache(DBusPropertyBatch::value<bool>(manager, "AutoClean"));
+        m_model->setUpdateMode(DBusPropertyBatch::value<qulonglong>(manager, "UpdateMode"));
+    }
+
+    if (!batch->hasError("updater")) {
+        m_model->setAutoDownloadUpdates(DBusPropertyBatch::value<bool>(updater, "AutoDownloadUpdates"));
+        m_model->setAutoInstallUpdates(DBusPropertyBatch::value<bool>(updater, "AutoInstallUpdates"));
+        m_model->setAutoInstallUpdateType(DBusPropertyBatch::value<qulonglong>(updater, "AutoInstallUpdateType"));
+        m_model->setAutoCheckUpdates(DBusPropertyBatch::value<bool>(updater, "AutoCheckUpdates"));
+        m_model->setUpdateNotify(DBusPropertyBatch::value<bool>(updater, "UpdateNotify"));
+    }
+
+    const QMap<QString, QStringList> &updatablePackages = DBusPropertyBatch::value<QMap<QString, QStringList>>(updater, "ClassifiedUpdatablePackages");
+    const QList<QDBusObjectPath> &jobs = DBusPropertyBatch::value<QList<QDBusObjectPath>>(manager, "JobList");
+    for (const QDBusObjectPath &dBusObjectPath : jobs) {
+        if (dBusObjectPath.path().contains("upgrade")) {
+            qDebug() << "UpdateWorker::activate, jobs.count() == " << jobs.count();
+            setUpdateInfo(updatablePackages);
+            break;
+        }
+    }
+
+    onJobListChanged(jobs);
+
+    if (!batch->hasError("updater"))
+        checkUpdatablePackages(updatablePackages);
+}
+
 void UpdateWorker::deactivate()
 {
 
@@ -377,6 +476,15 @@ void UpdateWorker::checkForUpdates()
 
 
 void UpdateWorker::setUpdateInfo()
+{
+    m_updateInter->setSync(true);
+    const QMap<QString, QStringList> &packages = m_updateInter->classifiedUpdatablePackages();
+    m_updateInter->setSync(false);
+
+    setUpdateInfo(packages);
+}
+
+void UpdateWorker::setUpdateInfo(const QMap<QString, QStringList> &packages)
 {
     m_updatePackages.clear();
     m_systemPackages.clear();
@@ -384,17 +492,11 @@ void UpdateWorker::setUpdateInfo()
     m_unknownPackages.clear();
 
     qDebug() << " UpdateWorker::setUpdateInfo() ";
-    m_updateInter->setSync(true);
-    m_managerInter->setSync(true);
-
-    m_updatePackages = m_updateInter->classifiedUpdatablePackages();
+    m_updatePackages = packages;
     m_systemPackages = m_updatePackages.value(SystemUpdateType);
     m_safePackages = m_updatePackages.value(SecurityUpdateType);
     m_unknownPackages = m_updatePackages.value(UnknownUpdateType);
 
-    m_updateInter->setSync(false);
-    m_managerInter->setSync(false);
-
     qDebug() << "systemUpdate packages:" <<  m_systemPackages;
     qDebug() << "safeUpdate packages:" <<  m_safePackages;
     qDebug() << "unkonowUpdate packages:" <<  m_unknownPackages;
@@ -413,29 +515,8 @@ void UpdateWorker::setUpdateInfo()
         }
     }
 
-    // 如果内存中没有日志数据，那么从文件里面读取
-    do {
-        if (!m_updateLogs.isEmpty() || !QFile::exists(UpdateLogTmpFile))
-            break;
-
-        qInfo() << "Update log is empty, read logs from temporary file";
-        QFile logFile(UpdateLogTmpFile);
-        if (!logFile.open(QFile::ReadOnly)) {
-            qWarning() << "Can not open update log file:" << UpdateLogTmpFile;
-            break;
-        }
-
-        QJsonParseError err_rpt;
-        QJsonDocument updateInfoDoc = QJsonDocument::fromJson(logFile.readAll(), &err_rpt);
-        logFile.close();
-        if (err_rpt.error != QJsonParseError::NoError) {
-            qWarning() << "Parse update log error: " << err_rpt.errorString();
-            break;
-        }
-        setUpdateLogs(updateInfoDoc.array());
-        qInfo() << "Update logs size: " << m_updateLogs.size();
-    } while(0);
-
+    // 如果内存中没有日志数据，那么从缓存里面读取
+    m_updateLogCache.load();
 
     QMap<ClassifyUpdateType, UpdateItemInfo *> updateInfoMap = getAllUpdateInfo();
     m_model->setAllDownloadInfo(updateInfoMap);
@@ -516,11 +597,12 @@ QMap<ClassifyUpdateType, UpdateItemInfo *> UpdateWorker::getAllUpdateInfo()
         if (!itemInfo)
             continue;
 
-        for (UpdateLogItem logItem : m_updateLogs) {
-            if (!logItem.isValid() || logItem.logType != logType)
-                continue;
-
-            updateItemInfo(logItem, resultMap.value(type));
+        // 安全更新只显示与当前系统版本匹配的日志，直接从版本索引中取
+        const QList<UpdateLogItem> &logs = logType == LogTypeSecurity
+                ? m_updateLogCache.logs(logType, currentSystemVersion())
+                : m_updateLogCache.logs(logType);
+        for (const UpdateLogItem &logItem : logs) {
+            updateItemInfo(logItem, itemInfo);
         }
     }
 
@@ -549,13 +631,18 @@ void UpdateWorker::requestUpdateLog()
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     // 请求体
-    // TODO 增加过滤参数，避免每次请求全量更新日志，这个需要web端配合
     QJsonObject requestBody;
     requestBody["platformType"] = getPlatform();
     requestBody["isUnstable"] = isUnstableResource();
     QJsonDocument doc;
     doc.setObject(requestBody);
-    const QByteArray &body = doc.toJson();
+    const QByteArray &body = doc.toJson(QJsonDocument::Compact);
+
+    // 带上缓存的 ETag/Last-Modified，日志没有变化时服务器只返回 304
+    m_updateLogCache.load();
+    const QString &requestKey = url.toString(QUrl::RemoveQuery) + QString::fromUtf8(body);
+    m_updateLogCache.prepareRequest(request, requestKey);
+    request.setAttribute(QNetworkRequest::User, requestKey);
 
     http->post(request, body);
     qInfo() << "Pose request to get update log, request body: " << body;
@@ -568,34 +655,20 @@ void UpdateWorker::handleUpdateLogsReply(QNetworkReply *reply)
         qWarning() << "Network Error" << reply->errorString();
         return;
     }
-    QByteArray respondBody = reply->readAll();
-    if (respondBody.isEmpty()) {
-        qWarning() << "Request body is empty";
+    if (UpdateLogCache::isNotModified(reply)) {
+        qInfo() << "Update log not modified, use cache";
         return;
     }
 
-    const QJsonDocument &doc = QJsonDocument::fromJson(respondBody);
-    const QJsonObject &obj = doc.object();
-    if (obj.isEmpty()) {
-        qWarning() << "Request body json object is empty";
-        return;
-    }
-    if (obj.value("code").toInt() != 0) {
-        qWarning() << "Request update log failed";
+    QByteArray respondBody = reply->readAll();
+    if (respondBody.isEmpty()) {
+        qWarning() << "Request body is empty";
         return;
     }
 
-    const QJsonArray array = obj.value("data").toArray();
-    setUpdateLogs(array);
-    // 保存一个临时文件，在没有获取到在线日志的时候展示文件中的内容
-    QFile::remove(UpdateLogTmpFile);
-    QFile file(UpdateLogTmpFile);
-    if (file.open(QIODevice::WriteOnly)) {
-        QJsonDocument dataDoc;
-        dataDoc.setArray(array);
-        file.write(dataDoc.toJson());
-        file.close();
-    }}
+    setUpdateLogs(reply->request().attribute(QNetworkRequest::User).toString(),
+                  reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"), respondBody);
+}
 
 QString UpdateWorker::getUpdateLogAddress() const
 {
@@ -630,10 +703,7 @@ void UpdateWorker::updateItemInfo(const UpdateLogItem &logItem, UpdateItemInfo *
     // 安全更新只会更新与当前系统版本匹配的内容，例如，105X的系统版本只会更新105X的安全更新，而不会更新106X的
     // 更新日志也需要与之匹配，只显示与当前系统版本相同的安全更新日志
     if (logItem.logType == LogTypeSecurity) {
-        const QString &currentSystemVer = dccV20::IsCommunitySystem ? Dtk::Core::DSysInfo::deepinVersion() : Dtk::Core::DSysInfo::minorVersion();
-        QString tmpSystemVersion = logItem.systemVersion;
-        tmpSystemVersion.replace(tmpSystemVersion.length() - 1, 1, '0');
-        if (currentSystemVer.compare(tmpSystemVersion) != 0) {
+        if (currentSystemVersion().compare(UpdateLogCache::normalizedVersion(logItem.systemVersion)) != 0) {
             return;
         }
     }
@@ -937,77 +1007,39 @@ QString UpdateWorker::getTestingChannelSource()
     }
     return "";
 }
-// get all sources of the package
-QStringList UpdateWorker::getSourcesOfPackage(const QString pkg, const QString version)
-{
-    QStringList sources;
-    QProcess aptCacheProcess(this);
-    QStringList args;
-    args.append("madison");
-    args.append(pkg);
-    // exec apt-cache madison $pkg
-    aptCacheProcess.start("apt-cache", args);
-    aptCacheProcess.waitForFinished();
-    while (aptCacheProcess.canReadLine()) {
-        QString line(aptCacheProcess.readLine());
-        auto fields = line.split("|", QString::SkipEmptyParts);
-        for (QString &field : fields) {
-            field = field.trimmed();
-        }
-        if (fields.length() <= 2) {
-            continue;
-        }
-        auto p = fields[0], ver = fields[1], src = fields[2];
-        src.truncate(fields[2].indexOf(" "));
-        if (p == pkg) {
-            if (version.length() == 0 || version == ver) {
-                sources.append(src);
-            }
-        }
-    }
-    return sources.toSet().toList();
+// 已安装的包、软件源配置或仓库索引变化后，退出内测通道的检查结果需要重新计算
+QString UpdateWorker::testingChannelCheckStamp() const
+{
+    return QString("%1-%2-%3-%4").arg(LastModified(DpkgStatusFile))
+            .arg(LastModified(AptListsDir))
+            .arg(LastModified(AptSourcesDir))
+            .arg(LastModified(AptSourcesFile));
 }
 
 // checkCanExitTestingChannel check if the current env can exit internal test channel
 void UpdateWorker::checkCanExitTestingChannel()
 {
-    // 如果在执行apt-get clean之后使用apt-cache会很慢，比正常情况慢23倍
-    // 执行一次apt update，可以让apt-cache恢复到正常速度
-    checkForUpdates();
-    auto testingChannelSource = getTestingChannelSource();
-    QProcess dpkgProcess(this);
-    // exec dpkg -l
-    dpkgProcess.start("dpkg", QStringList("-l"));
-    dpkgProcess.waitForStarted();
-    // read stdout by line
-    while (dpkgProcess.state() == QProcess::Running) {
-        dpkgProcess.waitForReadyRead();
-        while (dpkgProcess.canReadLine()) {
-            QString line(dpkgProcess.readLine());
-            // skip uninstalled
-            if (!line.startsWith("ii")) {
-                continue;
-            }
-            auto field = line.split(" ", QString::SkipEmptyParts);
-            // skip unknown format line
-            if (field.length() <= 2) {
-                continue;
-            }
-            auto pkg = field[1], version = field[2];
-            // skip non system software
-            if (!pkg.contains("dde") && !pkg.contains("deepin") && !pkg.contains("dtk") && !pkg.contains("uos")) {
-                continue;
-            }
-            // Does the package exists only in the internal test source
-            auto sources = getSourcesOfPackage(pkg, version);
-            if (sources.length() == 1 && sources[0].contains(testingChannelSource)) {
-                m_model->setCanExitTestingChannel(false);
-                return;
-            }
-        }
+    // 软件源和已安装的包都没有变化时直接使用上次的结果
+    const QString &stamp = testingChannelCheckStamp();
+    if (!m_testingChannelCheckStamp.isEmpty() && m_testingChannelCheckStamp == stamp) {
+        m_model->setCanExitTestingChannel(m_canExitTestingChannel);
+        return;
     }
-    m_model->setCanExitTestingChannel(true);
-    return;
+
+    if (m_testingChannelChecking)
+        return;
+
+    m_testingChannelChecking = true;
+    const QString &testingChannelSource = getTestingChannelSource();
+    QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [ = ] {
+        m_testingChannelChecking = false;
+        m_canExitTestingChannel = watcher->result();
+        m_testingChannelCheckStamp = stamp;
+        m_model->setCanExitTestingChannel(m_canExitTestingChannel);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(CanExitTestingChannelInternal, testingChannelSource));
 }
 
 #ifndef DISABLE_SYS_UPDATE_SOURCE_CHECK
@@ -1019,50 +1051,36 @@ void UpdateWorker::setSourceCheck(bool enable)
 
 void UpdateWorker::testMirrorSpeed()
 {
-    QList<MirrorInfo> mirrors = m_model->mirrorInfos();
-
-    QStringList urlList;
-    for (MirrorInfo &info : mirrors) {
-        urlList << info.m_url;
+    QList<QPair<QString, QUrl>> mirrors;
+    for (const MirrorInfo &info : m_model->mirrorInfos()) {
+        mirrors << qMakePair(info.m_id, QUrl(info.m_url));
     }
 
     // reset the data;
     m_model->setMirrorSpeedInfo(QMap<QString, int>());
 
-    QFutureWatcher<int> *watcher = new QFutureWatcher<int>();
-    connect(watcher, &QFutureWatcher<int>::resultReadyAt, [this, urlList, watcher, mirrors](int index) {
-        QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
-
-        int result = watcher->resultAt(index);
-        QString mirrorId = mirrors.at(index).m_id;
-        speedInfo[mirrorId] = result;
+    if (!m_mirrorSpeedProber) {
+        m_mirrorSpeedProber = new MirrorSpeedProber(this);
+        connect(m_mirrorSpeedProber, &MirrorSpeedProber::resultReady, this, [ this ](const QString &id, int latency) {
+            QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
+            speedInfo[id] = latency;
+            m_model->setMirrorSpeedInfo(speedInfo);
+        });
+    }
 
-        m_model->setMirrorSpeedInfo(speedInfo);
-    });
+    m_mirrorSpeedProber->start(mirrors);
+}
 
-    QPointer<QObject> guest(this);
-    QFuture<int> future = QtConcurrent::mapped(urlList, std::bind(TestMirrorSpeedInternal, std::placeholders::_1, guest));
-    watcher->setFuture(future);
+void UpdateWorker::cancelTestMirrorSpeed()
+{
+    if (m_mirrorSpeedProber)
+        m_mirrorSpeedProber->cancel();
 }
 
 void UpdateWorker::checkNetselect()
 {
-    QProcess *process = new QProcess;
-    process->start("netselect", QStringList() << "127.0.0.1");
-    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
-        if ((error == QProcess::FailedToStart) || (error == QProcess::Crashed)) {
-            m_model->setNetselectExist(false);
-            process->deleteLater();
-        }
-    });
-    connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished), this, [this, process](int result) {
-        bool isNetselectExist = 0 == result;
-        if (!isNetselectExist) {
-            qDebug() << "[wubw UpdateWorker] netselect 127.0.0.1 : " << isNetselectExist;
-        }
-        m_model->setNetselectExist(isNetselectExist);
-        process->deleteLater();
-    });
+    // 测速已经在进程内完成，不再依赖 netselect
+    m_model->setNetselectExist(true);
 }
 
 void UpdateWorker::setSmartMirror(bool enable)
@@ -1896,38 +1914,26 @@ void UpdateWorker::onRequestLastoreHeartBeat()
     lastoreManager.asyncCall("GetCheckIntervalAndTime");
 }
 
-void UpdateWorker::setUpdateLogs(const QJsonArray &array)
+void UpdateWorker::setUpdateLogs(const QString &requestKey, const QByteArray &etag, const QByteArray &lastModified, const QByteArray &body)
 {
-    if (array.isEmpty())
-        return;
-
-    m_updateLogs.clear();
-    for(const QJsonValue &value : array) {
-        QJsonObject obj = value.toObject();
-        if (obj.isEmpty())
-            continue;
+    // 日志内容可能较大，解析和排序放到子线程中
+    QFutureWatcher<QList<UpdateLogItem>> *watcher = new QFutureWatcher<QList<UpdateLogItem>>(this);
+    connect(watcher, &QFutureWatcher<QList<UpdateLogItem>>::finished, this, [ = ] {
+        const QList<UpdateLogItem> &logs = watcher->result();
+        watcher->deleteLater();
+        if (logs.isEmpty())
+            return;
 
-        UpdateLogItem item;
-        item.id = obj.value("id").toInt();
-        item.systemVersion = obj.value("systemVersion").toString();
-        item.cnLog = obj.value("cnLog").toString();
-        item.enLog = obj.value("enLog").toString();
-        item.publishTime = DCC_NAMESPACE::utcDateTime2LocalDate(obj.value("publishTime").toString());
-        item.platformType = obj.value("platformType").toInt();
-        item.serverType = obj.value("serverType").toInt();
-        item.logType = obj.value("logType").toInt();
-        m_updateLogs.append(std::move(item));
-    }
-    qInfo() << "m_updateLogs size: " << m_updateLogs.size();
-    // 不依赖服务器返回来日志顺序，用systemVersion进行排序
-    // 如果systemVersion版本号相同，则用发布时间排序；不考虑版本号相同且发布时间相同的情况，这种情况应该由运维人员避免
-    qSort(m_updateLogs.begin(), m_updateLogs.end(), [] (const UpdateLogItem &v1, const UpdateLogItem &v2) -> bool {
-        int compareRet = v1.systemVersion.compare(v2.systemVersion);
-        if (compareRet == 0) {
-            return v1.publishTime.compare(v2.publishTime) >= 0;
-        }
-        return compareRet > 0;
+        m_updateLogCache.setLogs(requestKey, etag, lastModified, logs);
+        m_updateLogCache.save();
+        qInfo() << "Update logs size: " << m_updateLogCache.size();
     });
+
+    watcher->setFuture(QtConcurrent::run([ body ] {
+        QList<UpdateLogItem> logs;
+        UpdateLogCache::parseLogs(body, logs);
+        return logs;
+    }));
 }
 
 /**
@@ -6,6 +6,7 @@
 #define UPDATEWORK_H
 
 #include "updatemodel.h"
+#include "updatelogcache.h"
 
 #include <QObject>
 #include <QNetworkAccessManager>
@@ -33,7 +34,7 @@ using SmartMirrorInter = com::deepin::lastore::Smartmirror;
 using RecoveryInter = com::deepin::ABRecovery;
 using Appearance = com::deepin::daemon::Appearance;
 
-class QJsonArray;
+class DBusPropertyBatch;
 
 namespace dcc {
 namespace update {
@@ -44,35 +45,7 @@ struct CheckUpdateJobRet {
     QString jobDescription;
 };
 
-/**
- * @brief 更新日志中一个版本的信息
- *
- * 示例数据：
- * {
-        "id": 1,
-        "platformType": 1,
-        "cnLog": "<p>中文日志</p>",
-        "enLog": "<p>英文日志</p>",
-        "serverType": 0,
-        "systemVersion": "1070U1",
-        "createdAt": "2022-08-10T17:45:54+08:00",
-        "logType": 1,
-        "publishTime": "2022-08-06T00:00:00+08:00"
-    }
- */
-struct UpdateLogItem
-{
-    int id = -1;
-    int platformType = 1;
-    int serverType = 0;
-    int logType = 1;
-    QString systemVersion = "";
-    QString cnLog = "";
-    QString enLog = "";
-    QString publishTime = "";
-
-    bool isValid() const { return -1 != id; }
-};
+class MirrorSpeedProber;
 
 class UpdateWorker : public QObject
 {
@@ -118,6 +91,7 @@ public Q_SLOTS:
     void setSourceCheck(bool enable);
 #endif
     void testMirrorSpeed();
+    void cancelTestMirrorSpeed();
     void checkNetselect();
     void setSmartMirror(bool enable);
 #ifndef DISABLE_SYS_UPDATE_MIRRORS
@@ -156,7 +130,6 @@ private Q_SLOTS:
     void onSafeUpdateInstallProgressChanged(double value);
     void onUnkonwnUpdateInstallProgressChanged(double value);
     void checkTestingChannelStatus();
-    QStringList getSourcesOfPackage(const QString pkg, const QString version);
     QString getTestingChannelSource();
     void handleUpdateLogsReply(QNetworkReply *reply);
     QString getUpdateLogAddress() const;
@@ -164,6 +137,8 @@ private Q_SLOTS:
 private:
     QMap<ClassifyUpdateType, UpdateItemInfo *> getAllUpdateInfo();
     void setUpdateInfo();
+    void setUpdateInfo(const QMap<QString, QStringList> &packages);
+    void onLastorePropertiesReady(DBusPropertyBatch *batch);
     void setUpdateItemDownloadSize(UpdateItemInfo *updateItem, QStringList packages);
 
     inline bool checkDbusIsValid();
@@ -194,8 +169,9 @@ private:
     void checkUpdatablePackages(const QMap<QString, QStringList> &updatablePackages);
     void requestUpdateLog();
     void updateItemInfo(const UpdateLogItem &logItem, UpdateItemInfo *itemInfo);
-    void setUpdateLogs(const QJsonArray &array);
+    void setUpdateLogs(const QString &requestKey, const QByteArray &etag, const QByteArray &lastModified, const QByteArray &body);
     int isUnstableResource() const;
+    QString testingChannelCheckStamp() const;
 
 private:
     UpdateModel *m_model;
@@ -245,7 +221,12 @@ private:
 
     QMutex m_mutex;
     QMutex m_downloadMutex;
-    QList<UpdateLogItem> m_updateLogs;
+    UpdateLogCache m_updateLogCache;
+    MirrorSpeedProber *m_mirrorSpeedProber;
+
+    bool m_testingChannelChecking;
+    bool m_canExitTestingChannel;
+    QString m_testingChannelCheckStamp;
 };
 
 }
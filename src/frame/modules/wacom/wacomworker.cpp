@@ -5,6 +5,7 @@
 #include "wacomworker.h"
 #include "wacommodel.h"
 #include "model/wacommodelbase.h"
+#include "window/dbuscallcoalescer.h"
 
 using namespace dcc;
 using namespace dcc::wacom;
@@ -14,7 +15,8 @@ const QString Service = "com.deepin.daemon.InputDevices";
 WacomWorker::WacomWorker(WacomModel *model, QObject *parent) :
     QObject(parent),
     m_dbusWacom(new Wacom(Service, "/com/deepin/daemon/InputDevice/Wacom", QDBusConnection::sessionBus(), this)),
-    m_model(model)
+    m_model(model),
+    m_sliderCalls(new DBusCallCoalescer(this))
 {
     connect(m_dbusWacom, &Wacom::StylusPressureSensitiveChanged, this, &WacomWorker::setPressureSensitive);
     connect(m_dbusWacom, &Wacom::ExistChanged, m_model, &WacomModel::setExist);
@@ -46,8 +48,8 @@ void WacomWorker::setPressureSensitive(const int value)
 
 void WacomWorker::onPressureSensitiveChanged(const int value)
 {
-    m_dbusWacom->setStylusPressureSensitive(static_cast<uint>(value));
-    m_dbusWacom->setEraserPressureSensitive(static_cast<uint>(value));
+    m_sliderCalls->setDBusProperty("StylusPressureSensitive", m_dbusWacom, "StylusPressureSensitive", static_cast<uint>(value));
+    m_sliderCalls->setDBusProperty("EraserPressureSensitive", m_dbusWacom, "EraserPressureSensitive", static_cast<uint>(value));
 }
 
 bool WacomWorker::exist()
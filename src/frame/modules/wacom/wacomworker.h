@@ -9,6 +9,7 @@
 #include <QObject>
 
 using com::deepin::daemon::inputdevice::Wacom;
+class DBusCallCoalescer;
 namespace dcc
 {
 namespace wacom
@@ -33,6 +34,7 @@ private:
 private:
     Wacom *m_dbusWacom;
     WacomModel *m_model;
+    DBusCallCoalescer *m_sliderCalls;   // 压感滑动条拖动时只发送最新的值
 };
 }
 }
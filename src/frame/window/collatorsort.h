@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef COLLATORSORT_H
+#define COLLATORSORT_H
+
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QList>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief 按当前语言的排序规则排序
+ * 每个元素只生成一次 QCollatorSortKey，排序时只比较排序键，
+ * 不需要在每次比较时创建 QCollator 或重复处理字符串。关键字相同的元素保持原来的顺序。
+ *
+ * 用法：
+ *     collatorSort(fonts, [](const QJsonObject &obj) { return obj["Name"].toString(); });
+ */
+template<typename T, typename KeyFunction>
+void collatorSort(QList<T> &list, KeyFunction key, const QCollator &collator = QCollator())
+{
+    if (list.size() < 2)
+        return;
+
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(static_cast<size_t>(list.size()));
+    for (const T &item : list)
+        keys.push_back(collator.sortKey(key(item)));
+
+    std::vector<int> order(static_cast<size_t>(list.size()));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](int i1, int i2) {
+        return keys[static_cast<size_t>(i1)].compare(keys[static_cast<size_t>(i2)]) < 0;
+    });
+
+    QList<T> sorted;
+    sorted.reserve(list.size());
+    for (int i : order)
+        sorted.append(list.at(i));
+
+    list.swap(sorted);
+}
+
+#endif // COLLATORSORT_H
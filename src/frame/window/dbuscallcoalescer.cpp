@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbuscallcoalescer.h"
+
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusVariant>
+#include <QDebug>
+#include <QTimer>
+
+const QString PropertiesInterface = "org.freedesktop.DBus.Properties";
+
+DBusCallCoalescer::DBusCallCoalescer(QObject *parent)
+    : QObject(parent)
+    , m_minimumInterval(0)
+{
+
+}
+
+void DBusCallCoalescer::post(const QString &key, const Call &call, QObject *context)
+{
+    Entry &entry = m_entries[key];
+    entry.waiting = call;
+    entry.context = context;
+    entry.hasContext = context != nullptr;
+
+    // 上一次调用还未返回或在等待间隔时只记录最新请求
+    if (entry.inFlight || entry.timerArmed)
+        return;
+
+    dispatch(key);
+}
+
+void DBusCallCoalescer::setDBusProperty(const QString &key, QDBusAbstractInterface *inter, const QString &name, const QVariant &value)
+{
+    const QDBusConnection connection = inter->connection();
+    const QString service = inter->service();
+    const QString path = inter->path();
+    const QString interface = inter->interface();
+
+    post(key, [ = ] {
+        QDBusMessage msg = QDBusMessage::createMethodCall(service, path, PropertiesInterface, "Set");
+        msg << interface << name << QVariant::fromValue(QDBusVariant(value));
+        return connection.asyncCall(msg);
+    });
+}
+
+void DBusCallCoalescer::cancel(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+        it->waiting = nullptr;
+}
+
+bool DBusCallCoalescer::isBusy(const QString &key) const
+{
+    auto it = m_entries.constFind(key);
+    return it != m_entries.constEnd() && (it->inFlight || it->waiting);
+}
+
+void DBusCallCoalescer::dispatch(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->inFlight || !it->waiting)
+        return;
+
+    // 调用的对象已经销毁，没有可以发出的调用
+    if (it->hasContext && !it->context) {
+        m_entries.erase(it);
+        return;
+    }
+
+    if (m_minimumInterval > 0 && it->lastSent.isValid()) {
+        const qint64 remaining = m_minimumInterval - it->lastSent.elapsed();
+        if (remaining > 0) {
+            if (!it->timerArmed) {
+                it->timerArmed = true;
+                QTimer::singleShot(static_cast<int>(remaining), this, [ = ] {
+                    auto entry = m_entries.find(key);
+                    if (entry != m_entries.end())
+                        entry->timerArmed = false;
+                    dispatch(key);
+                });
+            }
+            return;
+        }
+    }
+
+    const Call call = it->waiting;
+    it->waiting = nullptr;
+    it->inFlight = true;
+    it->lastSent.start();
+
+    const QDBusPendingCall pending = call();
+
+    // 空调用的 watcher 不会发出 finished，已完成的调用也不需要再等待
+    if (pending.isFinished()) {
+        const QDBusError error = pending.isError() ? pending.error() : QDBusError();
+        QTimer::singleShot(0, this, [ = ] {
+            onCallFinished(key, error);
+        });
+        return;
+    }
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(pending, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        watcher->deleteLater();
+        onCallFinished(key, watcher->error());
+    });
+}
+
+void DBusCallCoalescer::onCallFinished(const QString &key, const QDBusError &error)
+{
+    if (error.isValid())
+        qWarning() << "DBusCallCoalescer:" << key << "failed:" << error.message();
+
+    auto entry = m_entries.find(key);
+    if (entry != m_entries.end())
+        entry->inFlight = false;
+
+    Q_EMIT finished(key, error);
+    dispatch(key);
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBUSCALLCOALESCER_H
+#define DBUSCALLCOALESCER_H
+
+#include <QDBusAbstractInterface>
+#include <QDBusError>
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QVariant>
+
+#include <functional>
+
+/**
+ * @brief 合并滑动条等高频设置产生的 DBus 调用
+ * 按 key 区分不同的设置项，每个 key 同时最多只有一个调用未返回，期间新的请求只保留最后一次，
+ * 调用返回后再发出最新的值；设置了最小间隔时，两次调用之间至少间隔该时间。
+ * call 返回的调用已经完成（包括空调用）时，在下一次事件循环中按已返回处理，不会一直占用该 key。
+ * 需要在对象所在线程的事件循环中使用，调用方不需要加锁。
+ *
+ * 用法：
+ *     m_coalescer = new DBusCallCoalescer(this);
+ *     m_coalescer->post("volume", [ = ] { return sink->SetVolume(volume, true); }, sink);
+ *     m_coalescer->setDBusProperty("speed", m_dbusMouse, "MotionAcceleration", value);
+ */
+class DBusCallCoalescer : public QObject
+{
+    Q_OBJECT
+public:
+    using Call = std::function<QDBusPendingCall()>;
+
+    explicit DBusCallCoalescer(QObject *parent = nullptr);
+
+    // 同一个 key 两次调用之间的最小间隔，0 表示上一次返回后立即发出
+    void setMinimumInterval(int msec) { m_minimumInterval = msec; }
+    int minimumInterval() const { return m_minimumInterval; }
+
+    // context 不为空时，发出前 context 已经销毁则丢弃该请求并清除 key 的状态
+    void post(const QString &key, const Call &call, QObject *context = nullptr);
+    // 通过 org.freedesktop.DBus.Properties.Set 设置属性，不经过代理类的属性缓存
+    void setDBusProperty(const QString &key, QDBusAbstractInterface *inter, const QString &name, const QVariant &value);
+    // 丢弃还未发出的请求，已发出的调用不受影响
+    void cancel(const QString &key);
+
+    bool isBusy(const QString &key) const;
+
+Q_SIGNALS:
+    // 每次调用返回后发出，出错时 error 有效
+    void finished(const QString &key, const QDBusError &error);
+
+private:
+    void dispatch(const QString &key);
+    void onCallFinished(const QString &key, const QDBusError &error);
+
+private:
+    struct Entry {
+        Call waiting;
+        QPointer<QObject> context;
+        bool hasContext = false;
+        bool inFlight = false;
+        bool timerArmed = false;
+        QElapsedTimer lastSent;
+    };
+
+    int m_minimumInterval;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // DBUSCALLCOALESCER_H
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbuspropertybatch.h"
+
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDebug>
+
+const QString PropertiesInterface = "org.freedesktop.DBus.Properties";
+
+DBusPropertyBatch::DBusPropertyBatch(QObject *parent)
+    : QObject(parent)
+    , m_started(false)
+    , m_pending(0)
+{
+
+}
+
+void DBusPropertyBatch::addInterface(const QString &key, const QDBusConnection &connection, const QString &service,
+                                     const QString &path, const QString &interface)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(service, path, PropertiesInterface, "GetAll");
+    msg << interface;
+
+    watch(key, connection.asyncCall(msg), true);
+}
+
+void DBusPropertyBatch::addCall(const QString &key, const QDBusPendingCall &call)
+{
+    watch(key, call, false);
+}
+
+void DBusPropertyBatch::start()
+{
+    m_started = true;
+
+    // 没有请求或请求都已立即失败时也保证 finished 异步发出，调用方可以在 start 之后再连接信号
+    if (m_pending == 0)
+        QMetaObject::invokeMethod(this, &DBusPropertyBatch::finished, Qt::QueuedConnection);
+}
+
+/**
+ * @brief 阻塞等待全部请求返回，返回前会同步发出 finished 信号，用于必须同步初始化数据的场景
+ */
+void DBusPropertyBatch::waitForFinished()
+{
+    Q_ASSERT(m_started);
+
+    for (QDBusPendingCallWatcher *watcher : findChildren<QDBusPendingCallWatcher *>()) {
+        if (m_pending == 0)
+            break;
+        watcher->waitForFinished();
+    }
+}
+
+QDBusPendingCall DBusPropertyBatch::call(const QString &key) const
+{
+    return m_calls.value(key, QDBusPendingCall::fromCompletedCall(QDBusMessage()));
+}
+
+void DBusPropertyBatch::watch(const QString &key, const QDBusPendingCall &call, bool isGetAll)
+{
+    Q_ASSERT(!m_started);
+
+    ++m_pending;
+    m_calls.insert(key, call);
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        if (watcher->isError()) {
+            qWarning() << "DBusPropertyBatch:" << key << "failed:" << watcher->error().message();
+            m_errors.insert(key, watcher->error());
+        } else if (isGetAll) {
+            QDBusPendingReply<QVariantMap> reply = *watcher;
+            m_properties.insert(key, reply.value());
+        }
+
+        --m_pending;
+        watcher->deleteLater();
+        checkFinished();
+    });
+}
+
+void DBusPropertyBatch::checkFinished()
+{
+    if (m_started && m_pending == 0)
+        Q_EMIT finished();
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBUSPROPERTYBATCH_H
+#define DBUSPROPERTYBATCH_H
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusError>
+#include <QDBusPendingCall>
+#include <QHash>
+#include <QObject>
+#include <QVariantMap>
+
+/**
+ * @brief 批量异步获取 DBus 属性
+ * 每个接口只发起一次 org.freedesktop.DBus.Properties.GetAll 调用，也可以附带任意异步方法调用，
+ * 所有请求同时发出，全部返回后发送一次 finished 信号，调用方可以在槽函数中一次性更新数据模型。
+ * 用于替代 setSync(true) 后逐个读取属性的写法，避免在界面线程中等待 DBus 往返。
+ *
+ * 用法：
+ *     DBusPropertyBatch *batch = new DBusPropertyBatch(this);
+ *     batch->addInterface("manager", inter->connection(), inter->service(), inter->path(), inter->interface());
+ *     batch->addCall("interval", inter->asyncCall("GetCheckIntervalAndTime"));
+ *     connect(batch, &DBusPropertyBatch::finished, this, [ = ] { ...; batch->deleteLater(); });
+ *     batch->start();
+ */
+class DBusPropertyBatch : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DBusPropertyBatch(QObject *parent = nullptr);
+
+    void addInterface(const QString &key, const QDBusConnection &connection, const QString &service,
+                      const QString &path, const QString &interface);
+    void addCall(const QString &key, const QDBusPendingCall &call);
+    void start();
+    void waitForFinished();
+
+    bool isFinished() const { return m_started && m_pending == 0; }
+    QVariantMap properties(const QString &key) const { return m_properties.value(key); }
+    QDBusPendingCall call(const QString &key) const;
+    QDBusError error(const QString &key) const { return m_errors.value(key); }
+    bool hasError(const QString &key) const { return m_errors.contains(key); }
+
+    // GetAll 返回的复杂类型(ao、a{sas}等)是 QDBusArgument，需要通过 qdbus_cast 解析
+    template<typename T>
+    static T value(const QVariantMap &properties, const QString &name, const T &defaultValue = T())
+    {
+        auto it = properties.constFind(name);
+        if (it == properties.constEnd())
+            return defaultValue;
+
+        return qdbus_cast<T>(it.value());
+    }
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    void watch(const QString &key, const QDBusPendingCall &call, bool isGetAll);
+    void checkFinished();
+
+private:
+    bool m_started;
+    int m_pending;
+    QHash<QString, QVariantMap> m_properties;
+    QHash<QString, QDBusPendingCall> m_calls;
+    QHash<QString, QDBusError> m_errors;
+};
+
+#endif // DBUSPROPERTYBATCH_H
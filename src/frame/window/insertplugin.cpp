@@ -3,20 +3,124 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "insertplugin.h"
+#include "tracer.h"
 
 #include <QGSettings>
+#include <QJsonDocument>
+#include <QLocale>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
 
 #include <DStandardItem>
 
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
+// 插件元数据缓存版本，缓存内容变化时修改
+const int PluginCacheVersion = 1;
 
 using namespace DCC_NAMESPACE;
 DWIDGET_USE_NAMESPACE
 
 QPointer<InsertPlugin> InsertPlugin::INSTANCE = nullptr;
 
+namespace {
+// 由缓存的元数据构造的模块信息，用于在插件加载前注册搜索数据
+class PluginMetaData : public ModuleInterface
+{
+public:
+    explicit PluginMetaData(const QJsonObject &meta) : m_meta(meta) {}
+
+    void initialize() override {}
+    const QString name() const override { return m_meta.value("name").toString(); }
+    const QString displayName() const override { return m_meta.value("displayName").toString(); }
+    QIcon icon() const override { return QIcon::fromTheme(m_meta.value("icon").toString()); }
+    QString translationPath() const override { return m_meta.value("translationPath").toString(); }
+
+private:
+    QJsonObject m_meta;
+};
+
+QString pluginCacheFile()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/plugins.json";
+}
+
+// 缓存以库文件路径为键，通过mtime和size判断是否有效；显示名称需要翻译，语言变化时缓存失效
+QJsonObject loadPluginCache()
+{
+    QFile file(pluginCacheFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+
+    const QJsonObject &root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != PluginCacheVersion || root.value("locale").toString() != QLocale::system().name())
+        return QJsonObject();
+
+    return root.value("plugins").toObject();
+}
+
+void savePluginCache(const QJsonObject &plugins)
+{
+    QJsonObject root;
+    root.insert("version", PluginCacheVersion);
+    root.insert("locale", QLocale::system().name());
+    root.insert("plugins", plugins);
+
+    QDir().mkpath(QFileInfo(pluginCacheFile()).absolutePath());
+    QSaveFile file(pluginCacheFile());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "open plugin cache failed:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+bool isCacheValid(const QJsonObject &meta, const QFileInfo &info)
+{
+    return !meta.isEmpty()
+            && meta.value("mtime").toVariant().toLongLong() == info.lastModified().toMSecsSinceEpoch()
+            && meta.value("size").toVariant().toLongLong() == info.size();
+}
+
+// 一级菜单插件、图标或翻译文件在插件资源中的插件需要在启动时加载
+bool isDeferrable(const QJsonObject &meta)
+{
+    return meta.value("path").toString() != MAINWINDOW
+            && !meta.value("icon").toString().isEmpty()
+            && !meta.value("translationPath").toString().startsWith(":");
+}
+}
+
+PluginPreloader::PluginPreloader(const QStringList &files)
+    : m_files(files)
+{
+    // 由主线程在finished后释放，不在线程池线程中析构QObject
+    setAutoDelete(false);
+}
+
+void PluginPreloader::run()
+{
+    for (const QString &file : m_files) {
+        TraceScope trace("preload plugin", file);
+        QElapsedTimer et;
+        et.start();
+        QPluginLoader loader(file);
+        if (!loader.load()) {
+            qWarning() << "preload plugin failed:" << file << loader.errorString();
+        }
+        qDebug() << "preload plugin" << file << "using time:" << et.elapsed() << "ms";
+        Q_EMIT loaded(file);
+    }
+
+    Q_EMIT finished();
+}
+
 InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
+    : m_parent(obj)
+    , m_frameProxy(frameProxy)
 {
+    TraceScope trace("InsertPlugin::InsertPlugin");
     QDir moduleDir(ModuleDirectory);
     if (!moduleDir.exists())
     {
@@ -24,6 +128,10 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         return;
     }
 
+    const QJsonObject &cache = loadPluginCache();
+    QJsonObject newCache;
+    QStringList deferredFiles;
+
     auto moduleList = moduleDir.entryInfoList();
     for (auto i : moduleList)
     {
@@ -32,10 +140,31 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         if (!QLibrary::isLibrary(path))
             continue;
 
+        // 元数据缓存有效时不加载插件，等到插件所在模块显示时再加载
+        const QJsonObject &cached = cache.value(path).toObject();
+        if (isCacheValid(cached, i) && isDeferrable(cached))
+        {
+            qDebug() << "defer loading module: " << i;
+            if (frameProxy && cached.value("follow").toString() != MAINWINDOW)
+            {
+                PluginMetaData metaData(cached);
+                frameProxy->setSearchPath(&metaData);
+            }
+
+            Plugin plugin;
+            plugin.path = cached.value("path").toString();
+            plugin.follow = cached.value("follow").toString();
+            plugin.enabled = cached.value("enabled").toBool();
+            plugin.file = path;
+
+            m_allModules.push_back({plugin, {nullptr, cached.value("name").toString()}});
+            newCache.insert(path, cached);
+            deferredFiles << path;
+            continue;
+        }
+
         qDebug() << "loading module: " << i;
 
-        QElapsedTimer et;
-        et.start();
         QPluginLoader loader(path);
         const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
         if (!compareVersion(meta.value("api").toString(), "1.0.0"))
@@ -44,24 +173,11 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
             continue;
         }
 
-        QObject *instance = loader.instance();
+        QObject *instance = createInstance(path);
         if (!instance)
-        {
-            qDebug() << loader.errorString();
             continue;
-        }
-
-        instance->setParent(obj);
 
         auto *module = qobject_cast<ModuleInterface *>(instance);
-        if (!module)
-        {
-            return;
-        }
-        qDebug() << "load plugin Name: " << module->name() << module->displayName();
-        qDebug() << "load this plugin using time: " << et.elapsed() << "ms";
-        module->setFrameProxy(frameProxy);
-
         if (module->follow() != MAINWINDOW && frameProxy)
         {
             frameProxy->setSearchPath(module);
@@ -71,8 +187,99 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         plugin.path = module->path();
         plugin.follow = module->follow();
         plugin.enabled = module->enabled();
+        plugin.file = path;
 
         m_allModules.push_back({plugin, {instance, module->name()}});
+
+        QJsonObject pluginMeta;
+        pluginMeta.insert("mtime", QString::number(i.lastModified().toMSecsSinceEpoch()));
+        pluginMeta.insert("size", QString::number(i.size()));
+        pluginMeta.insert("path", plugin.path);
+        pluginMeta.insert("follow", plugin.follow);
+        pluginMeta.insert("enabled", plugin.enabled);
+        pluginMeta.insert("name", module->name());
+        pluginMeta.insert("displayName", module->displayName());
+        pluginMeta.insert("icon", module->icon().name());
+        pluginMeta.insert("translationPath", module->translationPath());
+        newCache.insert(path, pluginMeta);
+    }
+
+    if (newCache != cache)
+        savePluginCache(newCache);
+
+    // 剩余的插件在后台线程中依次预加载
+    if (!deferredFiles.isEmpty())
+    {
+        PluginPreloader *preloader = new PluginPreloader(deferredFiles);
+        connect(preloader, &PluginPreloader::loaded, this, &InsertPlugin::onDeferredPluginLoaded, Qt::QueuedConnection);
+        connect(preloader, &PluginPreloader::finished, preloader, &PluginPreloader::deleteLater, Qt::QueuedConnection);
+        QThreadPool::globalInstance()->start(preloader);
+    }
+}
+
+QObject *InsertPlugin::createInstance(const QString &file)
+{
+    TraceScope trace("load plugin", file);
+    QElapsedTimer et;
+    et.start();
+    QPluginLoader loader(file);
+    QObject *instance = loader.instance();
+    if (!instance)
+    {
+        qDebug() << loader.errorString();
+        return nullptr;
+    }
+
+    auto *module = qobject_cast<ModuleInterface *>(instance);
+    if (!module)
+    {
+        qDebug() << "plugin is not a module interface:" << file;
+        // 根对象由QPluginLoader管理，unload时释放
+        loader.unload();
+        return nullptr;
+    }
+
+    instance->setParent(m_parent);
+    qDebug() << "load plugin Name: " << module->name() << module->displayName();
+    qDebug() << "load this plugin using time: " << et.elapsed() << "ms";
+    module->setFrameProxy(m_frameProxy);
+
+    return instance;
+}
+
+QObject *InsertPlugin::loadDeferredPlugin(int index)
+{
+    auto &pluginSetting = m_allModules[index];
+    if (pluginSetting.second.first)
+        return pluginSetting.second.first;
+
+    if (!pluginSetting.first.resident)
+        qDebug() << "plugin is not preloaded yet:" << pluginSetting.first.file;
+
+    QObject *instance = createInstance(pluginSetting.first.file);
+    if (!instance)
+        return nullptr;
+
+    pluginSetting.second.first = instance;
+    if (pluginSetting.first.preInitializeRequested)
+    {
+        // 调用模块初始化函数搜索数据
+        qobject_cast<ModuleInterface *>(instance)->preInitialize(false);
+    }
+
+    return instance;
+}
+
+void InsertPlugin::onDeferredPluginLoaded(const QString &file)
+{
+    // 只记录库已驻留内存，实例在updatePluginInfo中插件所在模块显示时再创建
+    for (auto &pluginSetting : m_allModules)
+    {
+        if (pluginSetting.first.file == file)
+        {
+            pluginSetting.first.resident = true;
+            break;
+        }
     }
 }
 
@@ -80,11 +287,11 @@ bool InsertPlugin::updatePluginInfo(QString moduleName)
 {
     m_currentPlugins.clear();
 
-    for (auto pluginSetting : m_allModules)
+    for (int i = 0; i < m_allModules.size(); i++)
     {
-        if (pluginSetting.first.path == moduleName)
+        if (m_allModules[i].first.path == moduleName && loadDeferredPlugin(i))
         {
-            m_currentPlugins << pluginSetting;
+            m_currentPlugins << m_allModules[i];
         }
     }
 
@@ -101,10 +308,17 @@ InsertPlugin *InsertPlugin::instance(QObject *obj, FrameProxyInterface *FramePro
 
 void InsertPlugin::preInitialize(QString moduleName)
 {
-    for (auto pluginSetting : m_allModules)
+    for (auto &pluginSetting : m_allModules)
     {
         if (pluginSetting.first.path == moduleName)
         {
+            // 尚未加载的插件在加载完成后再初始化
+            if (!pluginSetting.second.first)
+            {
+                pluginSetting.first.preInitializeRequested = true;
+                break;
+            }
+
             auto *module = qobject_cast<ModuleInterface *>(pluginSetting.second.first);
             // 调用模块初始化函数搜索数据
             module->preInitialize(false);
@@ -259,10 +473,9 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
  */
 QStringList InsertPlugin::availPages(const QString &moduleName)
 {
-    updatePluginInfo(moduleName);
-
+    // 插件名称已缓存，不需要为此加载插件
     QStringList pages;
-    for (auto it : m_currentPlugins)
+    for (auto it : m_allModules)
     {
         if (it.first.path != moduleName)
             continue;
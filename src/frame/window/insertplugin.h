@@ -8,6 +8,7 @@
 #include <QDir>
 #include <QLibrary>
 #include <QPluginLoader>
+#include <QRunnable>
 #include <QStandardItemModel>
 #include <QJsonObject>
 
@@ -22,6 +23,26 @@ namespace DCC_NAMESPACE
         QString path;   // 插件级别及二级菜单插件所属模块
         QString follow; // 插件插入位置，可以字符串或者数字
         bool enabled;   // 插件是否处于可用状态
+        QString file;   // 插件库文件路径
+        bool preInitializeRequested = false; // 延迟加载的插件在加载完成后需要执行preInitialize
+        bool resident = false;  // 延迟加载的插件库已由后台线程预加载
+    };
+
+    // 在后台线程中预先dlopen插件，每个插件加载后通过loaded通知主线程，实例在模块需要时才在主线程中创建
+    class PluginPreloader : public QObject, public QRunnable
+    {
+        Q_OBJECT
+    public:
+        explicit PluginPreloader(const QStringList &files);
+
+        void run() override;
+
+    Q_SIGNALS:
+        void loaded(const QString &file);
+        void finished();
+
+    private:
+        QStringList m_files;
     };
 
     class InsertPlugin : public QObject
@@ -44,9 +65,18 @@ namespace DCC_NAMESPACE
         // 获取对应displayName的插件对象
         ModuleInterface *pluginInterface(const QString &displayName);
 
+    private:
+        QObject *createInstance(const QString &file);
+        QObject *loadDeferredPlugin(int index);
+
+    private Q_SLOTS:
+        void onDeferredPluginLoaded(const QString &file);
+
     private:
         static QPointer<InsertPlugin> INSTANCE;
-        // 保存加载的所有插件
+        QObject *m_parent;
+        FrameProxyInterface *m_frameProxy;
+        // 保存加载的所有插件，延迟加载的插件在加载前QObject为空
         QList<QPair<Plugin, QPair<QObject *, QString>>> m_allModules;
         // 保存插入到某个模块的所有插件
         QList<QPair<Plugin, QPair<QObject *, QString>>> m_currentPlugins;
@@ -29,12 +29,14 @@
 #include "widgets/multiselectlistview.h"
 #include "mainwindow.h"
 #include "insertplugin.h"
+#include "moduleprobe.h"
 #include "constant.h"
 #include "search/searchwidget.h"
 #include "dtitlebar.h"
 #include "utils.h"
 #include "interface/moduleinterface.h"
 #include "window/gsettingwatcher.h"
+#include "window/tracer.h"
 
 #include <DBackgroundGroup>
 #include <DIconButton>
@@ -58,6 +60,9 @@
 #include <QDialog>
 #include <QDesktopWidget>
 #include <QApplication>
+#include <QtConcurrent>
+#include <QJsonArray>
+#include <QJsonDocument>
 
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::search;
@@ -70,6 +75,7 @@ const QString GSettinsWindowHeight = "window-height";
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
 const QString ControlCenterIconPath = "/usr/share/icons/bloom/apps/64/preferences-system.svg";
 const QString ControlCenterGroupName = "com.deepin.dde-grand-search.group.dde-control-center-setting";
+const int GrandSearchWaitTimeout = 5000;
 
 const int WidgetMinimumWidth = 820;
 const int WidgetMinimumHeight = 634;
@@ -106,6 +112,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_primaryScreen(nullptr)
     , m_fontSize(getAppearanceFontSize())
 {
+    TraceScope trace("MainWindow::MainWindow");
+
     //Initialize view and layout structure
     DMainWindow::installEventFilter(this);
 
@@ -170,6 +178,7 @@ MainWindow::MainWindow(QWidget *parent)
     titlebar->setAccessibleName("Mainwindow bar");
     titlebar->addWidget(m_searchWidget, Qt::AlignCenter);
     connect(m_searchWidget, &SearchWidget::notifyModuleSearch, this, &MainWindow::onEnterSearchWidget);
+    connect(m_searchWidget, &SearchWidget::searchDataReady, this, &MainWindow::dispatchGrandSearchTasks);
 
     auto menu = titlebar->menu();
     if (!menu) {
@@ -328,6 +337,7 @@ void MainWindow::initAllModule(const QString &m)
         return;
 
     m_bInit = true;
+    TraceScope trace("MainWindow::initAllModule");
 #ifndef DISABLE_AUTHENTICATION
     using namespace authentication;
 #endif
@@ -438,6 +448,7 @@ void MainWindow::initAllModule(const QString &m)
 
     QElapsedTimer et;
     et.start();
+    TraceScope searchTrace("SearchWidget::setLanguage");
     //after initAllModule to load ts data
     m_searchWidget->setLanguage(QLocale::system().name());
     qDebug() << QString("load search info with %1ms").arg(et.elapsed());
@@ -481,6 +492,11 @@ void MainWindow::updateModuleVisible()
 {
     m_hideModuleNames = m_moduleSettings->get(GSETTINGS_HIDE_MODULE).toStringList();
     for (auto i : m_modules) {
+        // 还未preInitialize的模块没有worker，按静态探测的结果显示
+        if (m_pendingPreInitModules.contains(i)) {
+            setModuleVisible(i.second, !m_hideModuleNames.contains(i.first->name()) && ModuleProbe::probe(i.first->name()) == ModuleProbe::Available);
+            continue;
+        }
 
         if (m_hideModuleNames.contains((i.first->name())) || i.first->deviceUnavailabel() || !i.first->isAvailable()) {
             setModuleVisible(i.second, false);
@@ -493,23 +509,73 @@ void MainWindow::updateModuleVisible()
 void MainWindow::modulePreInitialize(const QString &m)
 {
     // 初始化后模块后直接设置模块是否显示，不需要在updateModuleVisible()中处理，避免再次遍历循环
+    TraceScope trace("MainWindow::modulePreInitialize");
     m_hideModuleNames = m_moduleSettings->get(GSETTINGS_HIDE_MODULE).toStringList();
+    m_lazyModuleInit = qEnvironmentVariableIntValue("DCC_LAZY_MODULE_INIT") > 0;
 
     for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it) {
-        QElapsedTimer et;
-        et.start();
-        it->first->preInitialize(m == it->first->name());
-        qDebug() << QString("initialize %1 module using time: %2ms")
-                 .arg(it->first->name())
-                 .arg(et.elapsed());
-        if (it->first->isAvailable()) {
-            // 模块有效时先初始化模块和搜索数据
-            InsertPlugin::instance()->preInitialize(it->first->name());
-            setModuleVisible(it->second, !m_hideModuleNames.contains(it->first->name()) && !it->first->deviceUnavailabel());
-        } else {
-            setModuleVisible(it->second, false);
+        const QString &name = it->first->name();
+        const ModuleProbe::State state = m_lazyModuleInit && m != name ? ModuleProbe::probe(name) : ModuleProbe::Unknown;
+        if (state == ModuleProbe::Unknown) {
+            preInitializeModule(*it, m == name);
+            continue;
         }
+
+        // 延迟初始化：导航栏按模块的静态信息和可用性探测显示，模块的worker/model在第一次进入或搜索跳转时再创建
+        setModuleVisible(it->second, state == ModuleProbe::Available && !m_hideModuleNames.contains(name));
+        m_pendingPreInitModules << *it;
+    }
+
+    reportModuleInitCost();
+}
+
+void MainWindow::preInitializeModule(const QPair<ModuleInterface *, QString> &module, bool sync)
+{
+    TraceScope trace("preInitialize", module.first->name());
+    QElapsedTimer et;
+    et.start();
+    module.first->preInitialize(sync);
+    qDebug() << QString("initialize %1 module using time: %2ms")
+             .arg(module.first->name())
+             .arg(et.elapsed());
+    m_moduleInitCost << qMakePair(module.first->name(), et.elapsed());
+
+    if (module.first->isAvailable()) {
+        // 模块有效时先初始化模块和搜索数据
+        InsertPlugin::instance()->preInitialize(module.first->name());
+        setModuleVisible(module.second, !m_hideModuleNames.contains(module.first->name()) && !module.first->deviceUnavailabel());
+    } else {
+        setModuleVisible(module.second, false);
+    }
+}
+
+// 进入模块或跳转搜索结果前，保证模块已经完成preInitialize
+void MainWindow::ensureModulePreInitialized(const QString &name)
+{
+    for (int i = 0; i < m_pendingPreInitModules.count(); i++) {
+        if (m_pendingPreInitModules[i].first->name() == name) {
+            preInitializeModule(m_pendingPreInitModules.takeAt(i), true);
+            return;
+        }
+    }
+}
+
+void MainWindow::reportModuleInitCost()
+{
+    QList<QPair<QString, qint64>> costList = m_moduleInitCost;
+    std::sort(costList.begin(), costList.end(), [](const QPair<QString, qint64> &a, const QPair<QString, qint64> &b) {
+        return a.second > b.second;
+    });
+
+    qint64 total = 0;
+    QStringList report;
+    for (const auto &cost : costList) {
+        total += cost.second;
+        report << QString("%1: %2ms").arg(cost.first).arg(cost.second);
     }
+
+    qDebug() << QString("module startup cost report (%1, total %2ms, %3 deferred):").arg(m_lazyModuleInit ? "lazy" : "eager").arg(total).arg(m_pendingPreInitModules.size())
+             << report.join(", ");
 }
 
 void MainWindow::popWidget()
@@ -687,6 +753,8 @@ void MainWindow::setModuleSubscriptVisible(const QString &module, bool bIsDispla
 
 bool MainWindow::isModuleAvailable(const QString &m)
 {
+    ensureModulePreInitialized(m);
+
     auto res = std::find_if(m_modules.begin(), m_modules.end(), [ = ](const QPair<ModuleInterface *, QString> &data)->bool{
         return data.first->name() == m;
     });
@@ -963,6 +1031,16 @@ void MainWindow::onEnterSearchWidget(QString moduleName, QString widget)
     for (int firstCount = 0; firstCount < m_modules.count(); firstCount++) {
         //Compare moduleName and m_modules.second(module name)
         if (moduleName == m_modules[firstCount].first->name()) {
+            ensureModulePreInitialized(moduleName);
+            if (!m_modules[firstCount].first->isAvailable()) {
+                auto errStr = QString("module %1 is not available!").arg(moduleName);
+                qDebug() << errStr;
+                if (calledFromDBus()) {
+                    sendErrorReply(QDBusError::InvalidArgs, errStr);
+                }
+                break;
+            }
+
             //enter first level widget
             m_navView->setCurrentIndex(m_navView->model()->index(firstCount, 0));
 
@@ -1304,6 +1382,12 @@ void MainWindow::onFirstItemClick(const QModelIndex &index)
         return;
     }
 
+    // 延迟初始化的模块在切换页面前完成preInitialize，不可用时保留当前页面
+    ensureModulePreInitialized(inter->name());
+    if (!inter->isAvailable()) {
+        return;
+    }
+
     m_navView->setFocus();
     popAllWidgets();
 
@@ -1399,57 +1483,137 @@ void MainWindow::setSearchPath(ModuleInterface *const inter) const
     m_searchWidget->addModulesName(inter->name(), inter->displayName(), inter->icon(), inter->translationPath());
 }
 
-QString MainWindow::GrandSearchSearch(const QString json)
+//应答全局搜索请求，可在任意线程调用，同一个任务只会应答一次
+static void replyGrandSearch(const QJsonObject &request, const QDBusMessage &message,
+                             const QSharedPointer<QAtomicInt> &replied, const QList<QString> &lstMsg)
+{
+    if (!replied->testAndSetOrdered(0, 1)) {
+        return;
+    }
+
+    QJsonArray items;
+    for (int i = 0; i < lstMsg.size(); i++) {
+        QJsonObject jsonObj;
+        jsonObj.insert("item", lstMsg[i]);
+        jsonObj.insert("name", lstMsg[i]);
+        jsonObj.insert("icon", ControlCenterIconPath);
+        jsonObj.insert("type", "application/x-dde-control-center-xx");
+
+        items.insert(i, jsonObj);
+    }
+
+    QJsonObject objCont;
+    objCont.insert("group",ControlCenterGroupName);
+    objCont.insert("items", items);
+
+    QJsonArray arrConts;
+    arrConts.insert(0, objCont);
+
+    QJsonObject jsonResults;
+    jsonResults.insert("ver", request.value("ver"));
+    jsonResults.insert("mID", request.value("mID"));
+    jsonResults.insert("cont", arrConts);
+
+    QJsonDocument document;
+    document.setObject(jsonResults);
+
+    qDebug() << "grand search" << request.value("mID").toString() << "result count:" << lstMsg.size();
+    QDBusConnection::sessionBus().send(message.createReply(QString(document.toJson(QJsonDocument::Compact))));
+}
+
+//调用方需要对message设置延迟应答，搜索结果在后台线程中得到后直接应答，不阻塞事件循环
+void MainWindow::GrandSearchSearch(const QString json, const QDBusMessage &message)
 {
     //解析输入的json值
     QJsonDocument jsonDocument = QJsonDocument::fromJson(json.toLocal8Bit().data());
-    if(!jsonDocument.isNull()) {
-        QJsonObject jsonObject = jsonDocument.object();
-        m_lstGrandSearchTasks.append(jsonObject);
+    if (jsonDocument.isNull()) {
+        QDBusConnection::sessionBus().send(message.createReply(QString()));
+        return;
+    }
 
-        //处理搜索任务, 返回搜索结果
-        QList<QString> lstMsg = m_searchWidget->searchResults(jsonObject.value("cont").toString());
+    GrandSearchTask task;
+    task.request = jsonDocument.object();
+    task.message = message;
+    task.replied.reset(new QAtomicInt(0));
 
-        for(auto msg : lstMsg) {
-            qDebug() << "name:" << msg;
-        }
+    const QString mID = task.request.value("mID").toString();
+    if (m_grandSearchTasks.contains(mID)) {
+        //相同mID的旧任务直接作废
+        const GrandSearchTask &oldTask = m_grandSearchTasks.value(mID);
+        replyGrandSearch(oldTask.request, oldTask.message, oldTask.replied, QList<QString>());
+        m_lstGrandSearchTasks.removeAll(mID);
+    }
+    m_grandSearchTasks.insert(mID, task);
+    m_lstGrandSearchTasks.append(mID);
 
-        QJsonObject jsonResults;
-        QJsonArray items;
-        for (int i = 0; i < lstMsg.size(); i++) {
-            QJsonObject jsonObj;
-            jsonObj.insert("item", lstMsg[i]);
-            jsonObj.insert("name", lstMsg[i]);
-            jsonObj.insert("icon", ControlCenterIconPath);
-            jsonObj.insert("type", "application/x-dde-control-center-xx");
+    if (m_searchWidget->searchIndex()) {
+        dispatchGrandSearchTasks();
+        return;
+    }
 
-            items.insert(i, jsonObj);
+    //搜索数据未加载完成，等待searchDataReady信号，超时后返回空结果
+    QTimer::singleShot(GrandSearchWaitTimeout, this, [this, mID, task] {
+        if (m_grandSearchTasks.value(mID).replied != task.replied) {
+            return;
         }
 
-        QJsonObject objCont;
-        objCont.insert("group",ControlCenterGroupName);
-        objCont.insert("items", items);
+        qWarning() << "grand search timeout while waiting for search data, mID:" << mID;
+        replyGrandSearch(task.request, task.message, task.replied, QList<QString>());
+        m_grandSearchTasks.remove(mID);
+        m_lstGrandSearchTasks.removeAll(mID);
+    });
+}
+
+void MainWindow::dispatchGrandSearchTasks()
+{
+    QSharedPointer<const SearchIndex> searchIndex = m_searchWidget->searchIndex();
+    if (!searchIndex) {
+        return;
+    }
 
-        QJsonArray arrConts;
-        arrConts.insert(0, objCont);
+    for (const QString &mID : m_lstGrandSearchTasks) {
+        const GrandSearchTask task = m_grandSearchTasks.value(mID);
+        if (!task.replied) {
+            continue;
+        }
 
-        jsonResults.insert("ver", jsonObject.value("ver"));
-        jsonResults.insert("mID", jsonObject.value("mID"));
-        jsonResults.insert("cont", arrConts);
+        QtConcurrent::run([this, mID, task, searchIndex] {
+            //任务在排队期间可能已经被GrandSearchStop取消
+            if (task.replied->loadAcquire()) {
+                return;
+            }
 
-        QJsonDocument document;
-        document.setObject(jsonResults);
-        m_lstGrandSearchTasks.removeOne(jsonObject);
+            const QList<QString> &lstMsg = searchIndex->search(task.request.value("cont").toString());
+            replyGrandSearch(task.request, task.message, task.replied, lstMsg);
 
-        return document.toJson(QJsonDocument::Compact);
-   }
+            QMetaObject::invokeMethod(this, [this, mID, task] {
+                if (m_grandSearchTasks.value(mID).replied == task.replied) {
+                    m_grandSearchTasks.remove(mID);
+                }
+            }, Qt::QueuedConnection);
+        });
+    }
 
-    return QString();
+    m_lstGrandSearchTasks.clear();
 }
 
 bool MainWindow::GrandSearchStop(const QString json)
 {
-    Q_UNUSED(json)
+    QJsonDocument jsonDocument = QJsonDocument::fromJson(json.toLocal8Bit().data());
+    if (jsonDocument.isNull()) {
+        return false;
+    }
+
+    const QString mID = jsonDocument.object().value("mID").toString();
+    auto it = m_grandSearchTasks.find(mID);
+    if (it == m_grandSearchTasks.end()) {
+        return true;
+    }
+
+    //取消尚未完成的搜索，以空结果应答等待中的调用
+    replyGrandSearch(it->request, it->message, it->replied, QList<QString>());
+    m_grandSearchTasks.erase(it);
+    m_lstGrandSearchTasks.removeAll(mID);
     return true;
 }
 
@@ -1499,6 +1663,14 @@ bool MainWindow::event(QEvent *event)
     if(event->type() == QEvent::Show || event->type() == QEvent::Hide ){
         Q_EMIT mainwindowStateChange(event->type());
     }
+
+    if (event->type() == QEvent::Paint && !m_firstPainted) {
+        m_firstPainted = true;
+        Tracer::instance()->addInstant("first paint");
+        QTimer::singleShot(0, this, [] {
+            Tracer::instance()->writeTraceFile();
+        });
+    }
     return DMainWindow::event(event);
 }
 
@@ -15,6 +15,10 @@
 #include <QStack>
 #include <QPair>
 #include <QDBusContext>
+#include <QDBusMessage>
+#include <QJsonObject>
+#include <QAtomicInt>
+#include <QSharedPointer>
 #include <QGSettings>
 #include <QPointer>
 
@@ -84,7 +88,7 @@ public:
     void addChildPageTrans(const QString &menu, const QString &tran) override;
     virtual QString moduleDisplayName(const QString &module) const override;
 
-    QString GrandSearchSearch(const QString json);
+    void GrandSearchSearch(const QString json, const QDBusMessage &message);
     bool GrandSearchStop(const QString json);
     bool GrandSearchAction(const QString json);
 
@@ -128,6 +132,9 @@ protected:
 private:
     void resetNavList(bool isIconMode);
     void modulePreInitialize(const QString &m = nullptr);
+    void preInitializeModule(const QPair<ModuleInterface *, QString> &module, bool sync);
+    void ensureModulePreInitialized(const QString &name);
+    void reportModuleInitCost();
     void popAllWidgets(int place = 0);//place is Remain count
     void onFirstItemClick(const QModelIndex &index);
     void pushNormalWidget(ModuleInterface *const inter, QWidget *const w);  //exchange third widget : push new widget
@@ -138,6 +145,7 @@ private:
     void updateViewBackground();
     void updateModuleVisible();
     bool showSyncModule();
+    void dispatchGrandSearchTasks();
 
 private:
     bool m_bInit{false};
@@ -173,13 +181,25 @@ private:
     QSize m_lastSize;
     bool m_needRememberLastSize = true;     //用于判断是否需要上次resize的窗口大小
 
+    //延迟初始化模式(环境变量DCC_LAZY_MODULE_INIT)下，尚未执行preInitialize的模块，第一次进入或搜索跳转时初始化
+    bool m_lazyModuleInit{false};
+    QList<QPair<ModuleInterface *, QString>> m_pendingPreInitModules;
+    QList<QPair<QString, qint64>> m_moduleInitCost;     //模块名称, preInitialize耗时(ms)
+
     //全局搜索
-    QList<QJsonObject> m_lstGrandSearchTasks;
+    struct GrandSearchTask {
+        QJsonObject request;
+        QDBusMessage message;
+        QSharedPointer<QAtomicInt> replied;    //任务是否已经应答(搜索完成或被取消)
+    };
+    QMap<QString, GrandSearchTask> m_grandSearchTasks;   //mID -> 尚未应答的搜索任务
+    QStringList m_lstGrandSearchTasks;                   //等待搜索数据加载完成的任务mID
     QPointer<QScreen> m_primaryScreen;
     int m_currentIndex = -1;
     bool m_bIsNeedChange = false;
 
     int m_fontSize;
+    bool m_firstPainted{false};
 };
 }
 
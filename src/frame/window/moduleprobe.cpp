@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "moduleprobe.h"
+#include "widgets/utils.h"
+#include "window/utils.h"
+
+#include <QDir>
+
+using namespace DCC_NAMESPACE;
+
+// 目录下存在设备节点时认为有对应设备，驱动目录中的设备以 "总线:厂商:产品" 等带冒号的名称出现
+static bool hasDevice(const QStringList &dirs, bool driverDir)
+{
+    for (const QString &path : dirs) {
+        const QStringList &entries = QDir(path).entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot);
+        for (const QString &entry : entries) {
+            if (!driverDir || entry.contains(':'))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+ModuleProbe::State ModuleProbe::probe(const QString &module)
+{
+    if (module == "update") {
+        if (!DSysInfo::isDeepin() || DSysInfo::uosEditionType() == DSysInfo::UosEuler)
+            return Unavailable;
+        return valueByQSettings<bool>(DCC_CONFIG_FILES, "", "showUpdate", true) ? Available : Unavailable;
+    }
+
+    if (module == "commoninfo") {
+#ifdef DCC_DISABLE_GRUB
+        if (IsServerSystem)
+            return Unavailable;
+#endif
+        return DSysInfo::uosEditionType() == DSysInfo::UosEuler ? Unavailable : Available;
+    }
+
+    if (module == "bluetooth")
+        return hasDevice({ "/sys/class/bluetooth" }, false) ? Available : Unavailable;
+
+    if (module == "wacom")
+        return hasDevice({ "/sys/bus/hid/drivers/wacom", "/sys/bus/usb/drivers/wacom" }, true) ? Available : Unavailable;
+
+    // 触摸屏需要和显示器对应，云同步、生物认证依赖后端服务的状态，无法静态判断
+    if (module == "touchscreen" || module == "cloudsync" || module == "authentication")
+        return Unknown;
+
+    // 其他内置模块总是可用，一级菜单插件的可用性由插件自己决定
+    static const QStringList builtinModules = { "accounts", "display", "defapp", "personalization", "notification",
+                                                "sound", "datetime", "power", "mouse", "keyboard", "systeminfo" };
+    return builtinModules.contains(module) ? Available : Unknown;
+}
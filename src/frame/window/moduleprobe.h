@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MODULEPROBE_H
+#define MODULEPROBE_H
+
+#include <QString>
+
+/**
+ * @brief 模块可用性的静态探测
+ * 只读取系统版本、配置文件和 sysfs，不创建模块的 worker/model，也不访问 DBus。
+ * 延迟初始化时用于决定导航栏中尚未 preInitialize 的模块是否显示。
+ */
+namespace ModuleProbe {
+
+enum State {
+    Available,
+    Unavailable,
+    Unknown     // 无法静态判断，需要 preInitialize 后由模块自己决定
+};
+
+State probe(const QString &module);
+
+}
+
+#endif // MODULEPROBE_H
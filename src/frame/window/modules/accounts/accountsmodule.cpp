@@ -96,6 +96,7 @@ void AccountsModule::active()
         m_frameProxy->popWidget(this);
     });
     connect(m_accountsWidget, &AccountsWidget::requestLoadUserList, m_accountsWorker, &AccountsWorker::loadUserList);
+    connect(m_accountsWidget, &AccountsWidget::requestUpdateVisibleUsers, m_accountsWorker, &AccountsWorker::setVisibleUsers);
     connect(m_accountsWidget, &AccountsWidget::requestUpdatGroupList, m_accountsWorker, &AccountsWorker::updateGroupinfo);
     connect(m_accountsWorker, &AccountsWorker::showSafeyPage, m_accountsWidget, &AccountsWidget::onShowSafetyPage);
     m_frameProxy->pushWidget(this, m_accountsWidget);
@@ -6,6 +6,7 @@
 #include "widgets/multiselectlistview.h"
 #include "modules/accounts/usermodel.h"
 #include "modules/accounts/user.h"
+#include "modules/accounts/avatarcache.h"
 #include "accountsdetailwidget.h"
 #include "window/utils.h"
 #include "onlineicon.h"
@@ -42,6 +43,7 @@ AccountsWidget::AccountsWidget(QWidget *parent)
     , m_userItemModel(new QStandardItemModel(this))
     , m_saveClickedRow(0)
     , m_showDefaultAccountInfo(true)
+    , m_visibleUsersTimer(new QTimer(this))
 {
     m_createBtn->setFixedSize(50, 50);
     //~ contents_path /accounts/New Account
@@ -77,6 +79,12 @@ AccountsWidget::AccountsWidget(QWidget *parent)
     setLayout(mainContentLayout);
 
     connect(m_userlistView, &QListView::clicked, this, &AccountsWidget::onItemClicked);
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, [this](const QString &path) {
+        for (User *user : m_userList) {
+            if (avatarPath(user->currentAvatar()) == path)
+                setItemAvatar(user);
+        }
+    });
     connect(m_userlistView, &DListView::activated, m_userlistView, &QListView::clicked);
     connect(m_userlistView->verticalScrollBar(), &QScrollBar::valueChanged, this, [ = ](int value) {
         static int valueTemp = 0;
@@ -84,7 +92,15 @@ AccountsWidget::AccountsWidget(QWidget *parent)
             requestLoadUserList();
         }
         valueTemp = value;
+        m_visibleUsersTimer->start();
     });
+
+    // 滚动停止后再通知可见的用户
+    m_visibleUsersTimer->setSingleShot(true);
+    m_visibleUsersTimer->setInterval(100);
+    connect(m_visibleUsersTimer, &QTimer::timeout, this, &AccountsWidget::updateVisibleUsers);
+    connect(m_userItemModel, &QStandardItemModel::rowsInserted, m_visibleUsersTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_userItemModel, &QStandardItemModel::rowsRemoved, m_visibleUsersTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
     connect(m_createBtn, &QPushButton::clicked, this, &AccountsWidget::requestCreateAccount);
 
     connect(m_accountSetting, &QGSettings::changed, this, &AccountsWidget::onFullNameEnableChanged);
@@ -252,11 +268,7 @@ void AccountsWidget::addUser(User *user, bool t1)
     if (t1)
         return;
 
-    auto path = user->currentAvatar();
-    path = path.startsWith("file://") ? QUrl(path).toLocalFile() : path;
-    QPixmap pixmap = pixmapToRound(path);
-
-    item->setIcon(QIcon(pixmap));
+    setItemAvatar(user);
 
     bool needFullName = m_accountSetting->get("accountFullnameEnable").toBool();
 
@@ -341,23 +353,57 @@ void AccountsWidget::connectUserWithItem(User *user)
             titem->setText(user->displayName());
         }
     });
-    connect(user, &User::currentAvatarChanged, this, [ = ](const QString & avatar) {
-        int tindex = m_userList.indexOf(user);
-        auto titem = m_userItemModel->item(tindex);
-        if (!titem) {
-            return;
-        }
-        auto ratio = this->devicePixelRatioF();
-        auto path = avatar;
-        if (ratio > 4.0) {
-            path.replace("icons/", "icons/bigger/");
-        }
+    connect(user, &User::currentAvatarChanged, this, [ = ](const QString &) {
+        setItemAvatar(user);
+    });
+}
 
-        path = path.startsWith("file://") ? QUrl(path).toLocalFile() : path;
-        QPixmap pixmap = pixmapToRound(path);
+void AccountsWidget::updateVisibleUsers()
+{
+    const QRect rect = m_userlistView->viewport()->rect();
+    const QModelIndex first = m_userlistView->indexAt(QPoint(rect.center().x(), rect.top()));
 
-        titem->setIcon(QIcon(pixmap));
-    });
+    QList<User *> users;
+    for (int row = first.isValid() ? first.row() : 0; row < m_userList.size(); ++row) {
+        const QRect itemRect = m_userlistView->visualRect(m_userItemModel->index(row, 0));
+        if (itemRect.bottom() < rect.top())
+            continue;
+        if (itemRect.top() > rect.bottom())
+            break;
+        users << m_userList.at(row);
+    }
+
+    Q_EMIT requestUpdateVisibleUsers(users);
+}
+
+QString AccountsWidget::avatarPath(const QString &avatar) const
+{
+    auto path = avatar;
+    if (devicePixelRatioF() > 4.0) {
+        path.replace("icons/", "icons/bigger/");
+    }
+
+    return AvatarCache::localPath(path);
+}
+
+void AccountsWidget::setItemAvatar(User *user)
+{
+    auto titem = m_userItemModel->item(m_userList.indexOf(user));
+    if (!titem) {
+        return;
+    }
+
+    // 缓存中没有时先不设置，解码完成后由 avatarReady 再次调用
+    const auto ratio = devicePixelRatioF();
+    QPixmap pixmap = AvatarCache::instance()->avatar(avatarPath(user->currentAvatar()), m_userlistView->iconSize(), ratio);
+    if (pixmap.isNull()) {
+        return;
+    }
+
+    pixmap.setDevicePixelRatio(1);
+    pixmap = pixmapToRound(pixmap);
+    pixmap.setDevicePixelRatio(ratio);
+    titem->setIcon(QIcon(pixmap));
 }
 
 QPixmap AccountsWidget::pixmapToRound(const QPixmap &src)
@@ -17,6 +17,7 @@ QT_BEGIN_NAMESPACE
 class QVBoxLayout;
 class QStandardItem;
 class QStandardItemModel;
+class QTimer;
 QT_END_NAMESPACE
 
 namespace dcc {
@@ -74,8 +75,14 @@ Q_SIGNALS:
     void requestShowLastClickedUserInfo(bool t = false);
     void requestBack();
     void requestLoadUserList();
+    void requestUpdateVisibleUsers(const QList<dcc::accounts::User *> &users);
     void requestUpdatGroupList();
 
+private:
+    QString avatarPath(const QString &avatar) const;
+    void setItemAvatar(dcc::accounts::User *user);
+    void updateVisibleUsers();
+
 private:
     DTK_WIDGET_NAMESPACE::DFloatingButton *m_createBtn;
     dcc::widgets::MultiSelectListView *m_userlistView;
@@ -87,6 +94,7 @@ private:
     QGSettings *m_accountSetting{nullptr};
     bool m_isCreateValid;
     bool m_showDefaultAccountInfo;
+    QTimer *m_visibleUsersTimer;
 };
 
 }   // namespace accounts
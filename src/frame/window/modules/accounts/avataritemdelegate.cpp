@@ -66,14 +66,16 @@ void AvatarItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &op
         painter->setBrush(dh.getColor(&opt, QPalette::Button));
         painter->drawEllipse(opt.rect.marginsRemoved(margins));
 
-        //画+号
-        qreal x1 = opt.rect.x() + tw ;
-        qreal y1 = opt.rect.y() + opt.rect.height() / 2.0 - 0.5;
-        qreal x2 = opt.rect.x() + opt.rect.width() / 2.0 - 0.5;
-        qreal y2 = opt.rect.y() + th;
-        painter->setBrush(dh.getColor(&opt, QPalette::Text));
-        painter->drawRect(QRectF(x1, y1, tw, 1.0));
-        painter->drawRect(QRectF(x2, y2, 1.0, th));
+        //画+号，头像还在解码时只画背景
+        if (index.data(AvatarListWidget::SaveAvatarRole).toString().isEmpty()) {
+            qreal x1 = opt.rect.x() + tw ;
+            qreal y1 = opt.rect.y() + opt.rect.height() / 2.0 - 0.5;
+            qreal x2 = opt.rect.x() + opt.rect.width() / 2.0 - 0.5;
+            qreal y2 = opt.rect.y() + th;
+            painter->setBrush(dh.getColor(&opt, QPalette::Text));
+            painter->drawRect(QRectF(x1, y1, tw, 1.0));
+            painter->drawRect(QRectF(x2, y2, 1.0, th));
+        }
     }
 
     if (index.data(Qt::CheckStateRole) == Qt::Checked) {
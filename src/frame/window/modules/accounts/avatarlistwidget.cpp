@@ -4,6 +4,7 @@
 
 #include "avatarlistwidget.h"
 #include "modules/accounts/user.h"
+#include "modules/accounts/avatarcache.h"
 #include "avataritemdelegate.h"
 
 #include <QWidget>
@@ -39,6 +40,7 @@ AvatarListWidget::AvatarListWidget(User *usr, QWidget *parent)
     initWidgets();
 
     connect(this, &DListView::clicked, this, &AvatarListWidget::onItemClicked);
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, &AvatarListWidget::onAvatarReady);
 }
 
 AvatarListWidget::~AvatarListWidget()
@@ -98,7 +100,7 @@ void AvatarListWidget::refreshCustomAvatar(const QString& str)
         item = m_avatarItemModel->item(MaxAvatarSize);
     }
 
-    item->setData(QVariant::fromValue(QPixmap(customPicPath)), Qt::DecorationRole);
+    setItemAvatar(item, customPicPath);
     item->setData(QVariant::fromValue(customPicPath), AvatarListWidget::SaveAvatarRole);
     item->setData(m_avatarSize, Qt::SizeHintRole);
 
@@ -207,17 +209,31 @@ void AvatarListWidget::addItemFromDefaultDir()
         if (ratio > 1.0) {
             pxPath.replace("icons/", "icons/bigger/");
         }
-        auto px = QPixmap(pxPath).scaled(QSize(74, 74) * ratio,
-                                           Qt::KeepAspectRatio, Qt::FastTransformation);
-        px.setDevicePixelRatio(ratio);
-
-        item->setData(QVariant::fromValue(px), Qt::DecorationRole);
+        setItemAvatar(item, pxPath);
         item->setData(QVariant::fromValue(iconpath), AvatarListWidget::SaveAvatarRole);
         item->setData(m_avatarSize, Qt::SizeHintRole);
         m_avatarItemModel->appendRow(item);
     }
 }
 
+void AvatarListWidget::setItemAvatar(QStandardItem *item, const QString &path)
+{
+    // 缓存中没有时先不显示，解码完成后在 onAvatarReady 中更新
+    item->setData(path, AvatarListWidget::PixmapPathRole);
+    const QPixmap &px = AvatarCache::instance()->avatar(path, QSize(74, 74), devicePixelRatioF());
+    if (!px.isNull())
+        item->setData(QVariant::fromValue(px), Qt::DecorationRole);
+}
+
+void AvatarListWidget::onAvatarReady(const QString &path)
+{
+    for (int i = 0; i < m_avatarItemModel->rowCount(); ++i) {
+        QStandardItem *item = m_avatarItemModel->item(i);
+        if (item && item->data(AvatarListWidget::PixmapPathRole).toString() == path)
+            setItemAvatar(item, path);
+    }
+}
+
 void AvatarListWidget::addLastItem()
 {
     DStandardItem *item = new DStandardItem();
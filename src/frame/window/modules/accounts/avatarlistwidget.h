@@ -18,6 +18,7 @@ QT_BEGIN_NAMESPACE
 class QVBoxLayout;
 class QLabel;
 class QListView;
+class QStandardItem;
 class QStandardItemModel;
 class QModelIndex;
 class QFileDialog;
@@ -33,6 +34,7 @@ public:
     enum ItemRole {
         AddAvatarRole = Dtk::UserRole + 1,
         SaveAvatarRole,
+        PixmapPathRole,
     };
 
 public:
@@ -56,10 +58,12 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void onItemClicked(const QModelIndex &index);
+    void onAvatarReady(const QString &path);
 
 private:
     void initWidgets();
     QString getUserAddedCustomPicPath(const QString &usrName);
+    void setItemAvatar(QStandardItem *item, const QString &path);
 
 private:
     dcc::accounts::User *m_curUser{nullptr};
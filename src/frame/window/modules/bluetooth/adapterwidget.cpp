@@ -52,8 +52,12 @@ AdapterWidget::AdapterWidget(const dcc::bluetooth::Adapter *adapter, dcc::blueto
     , m_discoverySwitch(nullptr)
     , m_settingsGrp(nullptr)
     , m_spinnerTimer(new QTimer(this))
+    , m_insertTimer(new QTimer(this))
 {
     setAccessibleName("AdapterWidget");
+    m_insertTimer->setSingleShot(true);
+    m_insertTimer->setInterval(0);
+    connect(m_insertTimer, &QTimer::timeout, this, &AdapterWidget::insertPendingDevices);
     m_showAnonymousCheckBox->setAccessibleName("AnonymousCheckBox");
 
     //~ contents_path /bluetooth/Show Bluetooth devices without names
@@ -307,36 +311,29 @@ void AdapterWidget::initConnect()
         if (state == Qt::CheckState::Unchecked) {
             Q_EMIT requestSetDisplaySwitch(false);
             // 将蓝牙名称为空的设备过滤掉
-            for (int i = 0; i < m_deviceLists.size(); i++) {
-                DeviceSettingsItem *pDeviceItem = m_deviceLists[i];
-
-                if (pDeviceItem && pDeviceItem->device() && pDeviceItem->device()->paired())
+            for (DeviceSettingsItem *pDeviceItem : m_anonymousDevices) {
+                if (!pDeviceItem || !pDeviceItem->device() || pDeviceItem->device()->paired())
                     continue;
 
-                if (pDeviceItem) {
-                    BtStandardItem *dListItem = pDeviceItem->getStandardItem();
-                    QModelIndex index = m_otherDeviceModel->indexFromItem(dListItem);
-                    if (index.isValid() && pDeviceItem->device() && pDeviceItem->device()->name().isEmpty()) {
-                        m_otherDeviceModel->takeRow(index.row());
-                    }
-                }
+                QModelIndex index = m_otherDeviceModel->indexFromItem(pDeviceItem->getStandardItem());
+                if (index.isValid())
+                    m_otherDeviceModel->takeRow(index.row());
             }
         } else {
             Q_EMIT requestSetDisplaySwitch(true);
-            // 显示所有蓝牙设备
-            for (int i = 0; i < m_deviceLists.size(); i++) {
-                DeviceSettingsItem *pDeviceItem = m_deviceLists[i];
-                if (pDeviceItem && pDeviceItem->device() && pDeviceItem->device()->paired())
+            // 显示所有蓝牙设备，一次插入所有被过滤的设备
+            QList<QStandardItem *> items;
+            for (DeviceSettingsItem *pDeviceItem : m_anonymousDevices) {
+                if (!pDeviceItem || !pDeviceItem->device() || pDeviceItem->device()->paired()
+                        || m_pendingDevices.contains(pDeviceItem))
                     continue;
 
-                if (pDeviceItem) {
-                    BtStandardItem *dListItem = pDeviceItem->getStandardItem();
-                    QModelIndex index = m_otherDeviceModel->indexFromItem(dListItem);
-                    if (!index.isValid() && pDeviceItem->device() && pDeviceItem->device()->name().isEmpty()) {
-                        m_otherDeviceModel->insertRow(0, dListItem);
-                    }
-                }
+                BtStandardItem *dListItem = pDeviceItem->getStandardItem();
+                if (!m_otherDeviceModel->indexFromItem(dListItem).isValid())
+                    items.prepend(dListItem);
             }
+            if (!items.isEmpty())
+                m_otherDeviceModel->invisibleRootItem()->insertRows(0, items);
         }
     });
 
@@ -394,12 +391,9 @@ void AdapterWidget::setAdapter(const Adapter *adapter)
     });
 
     m_titleEdit->setTitle(adapter->name());
-    for (QString id : adapter->devicesId()) {
-        if (adapter->devices().contains(id)) {
-            const Device *device = adapter->devices()[id];
-            addDevice(device);
-        }
-    }
+    for (const QString &id : adapter->devicesId())
+        addDevice(adapter->deviceById(id));
+    insertPendingDevices();
     connect(adapter, &Adapter::discoverableChanged, m_discoverySwitch, [ = ] {
         m_discoverySwitch->setChecked(adapter->discoverabled());
     });
@@ -461,24 +455,35 @@ void AdapterWidget::refreshAudioDeviceStatu(const Device::State &state, bool pai
     }
 }
 
-void AdapterWidget::categoryDevice(DeviceSettingsItem *deviceItem, const bool paired)
+void AdapterWidget::insertPendingDevices()
 {
-    if (deviceItem) {
-        if (paired) {
-            BtStandardItem *dListItem = deviceItem->getStandardItem(m_myDeviceListView);
+    m_insertTimer->stop();
+
+    // 与逐个 insertRow(0, ...) 的顺序一致，后加入的设备显示在前面
+    QList<QStandardItem *> myItems;
+    QList<QStandardItem *> otherItems;
+    const bool showAnonymous = m_showAnonymousCheckBox->checkState() != Qt::CheckState::Unchecked;
+    for (DeviceSettingsItem *deviceItem : m_pendingDevices) {
+        if (!deviceItem || !deviceItem->device())
+            continue;
+
+        if (deviceItem->device()->paired()) {
             m_myDevices << deviceItem;
-            m_myDeviceModel->insertRow(0, dListItem);
+            myItems.prepend(deviceItem->getStandardItem(m_myDeviceListView));
         } else {
             BtStandardItem *dListItem = deviceItem->getStandardItem(m_otherDeviceListView);
-            if (m_showAnonymousCheckBox->checkState() == Qt::CheckState::Unchecked) {
-                if (deviceItem->device() && false == deviceItem->device()->name().isEmpty()) { // 只关注有名称的蓝牙设备,没有名称的忽略
-                    m_otherDeviceModel->insertRow(0, dListItem);
-                }
-            } else {
-                m_otherDeviceModel->insertRow(0, dListItem);
-            }
+            // 只关注有名称的蓝牙设备,没有名称的忽略
+            if (showAnonymous || !deviceItem->device()->name().isEmpty())
+                otherItems.prepend(dListItem);
         }
     }
+    m_pendingDevices.clear();
+
+    if (!myItems.isEmpty())
+        m_myDeviceModel->invisibleRootItem()->insertRows(0, myItems);
+    if (!otherItems.isEmpty())
+        m_otherDeviceModel->invisibleRootItem()->insertRows(0, otherItems);
+
     bool isVisible = !m_myDevices.isEmpty() && m_powerSwitch->checked();
     setMyDevicesVisible(isVisible);
     m_myDeviceListView->setVisible(isVisible);
@@ -493,10 +498,16 @@ void AdapterWidget::addDevice(const Device *device)
         connect(device, &Device::stateChanged, this, &AdapterWidget::refreshAudioDeviceStatu, Qt::UniqueConnection);
 
     QPointer<DeviceSettingsItem> deviceItem = new DeviceSettingsItem(device, style());
-    categoryDevice(deviceItem, device->paired());
+    m_pendingDevices << deviceItem;
+    if (!m_insertTimer->isActive())
+        m_insertTimer->start();
 
     connect(deviceItem, &DeviceSettingsItem::requestConnectDevice, this, &AdapterWidget::requestConnectDevice);
     connect(device, &Device::pairedChanged, this, [this, deviceItem](const bool paired) {
+        // 还未插入列表的设备在插入时按配对状态分类
+        if (m_pendingDevices.contains(deviceItem))
+            return;
+
         if (deviceItem && deviceItem->device()) {
             if (paired) {
                 qDebug() << "paired :" << deviceItem->device()->name();
@@ -533,38 +544,29 @@ void AdapterWidget::addDevice(const Device *device)
     });
 
     m_deviceLists << deviceItem;
+    m_deviceItems[device->id()] = deviceItem;
+    if (device->name().isEmpty())
+        m_anonymousDevices << deviceItem;
 }
 
 void AdapterWidget::removeDevice(const QString &deviceId)
 {
-    bool isFind = false;
-    for (auto it : m_myDevices) {
-        if (it && it->device() && it->device()->id() == deviceId) {
-            BtStandardItem *item = it->getStandardItem();
+    QPointer<DeviceSettingsItem> it = m_deviceItems.take(deviceId);
+    if (it) {
+        BtStandardItem *item = it->getStandardItem();
+        if (m_myDevices.removeOne(it)) {
             QModelIndex myDeviceIndex = m_myDeviceModel->indexFromItem(item);
             m_myDeviceModel->removeRow(myDeviceIndex.row());
-            m_myDevices.removeOne(it);
-            m_deviceLists.removeOne(it);
-            delete it;
-            it = nullptr;
-            Q_EMIT notifyRemoveDevice();
-            isFind = true;
-            break;
-        }
-    }
-    if (!isFind) {
-        for (auto it : m_deviceLists) {
-            if (it && it->device() && it->device()->id() == deviceId) {
-                BtStandardItem *item = it->getStandardItem();
-                QModelIndex otherDeviceIndex = m_otherDeviceModel->indexFromItem(item);
+        } else {
+            QModelIndex otherDeviceIndex = m_otherDeviceModel->indexFromItem(item);
+            if (otherDeviceIndex.isValid())
                 m_otherDeviceModel->removeRow(otherDeviceIndex.row());
-                m_deviceLists.removeOne(it);
-                delete it;
-                it = nullptr;
-                Q_EMIT notifyRemoveDevice();
-                break;
-            }
         }
+        m_pendingDevices.removeOne(it);
+        m_anonymousDevices.removeOne(it);
+        m_deviceLists.removeOne(it);
+        delete it;
+        Q_EMIT notifyRemoveDevice();
     }
     if (m_myDevices.isEmpty()) {
         m_myDevicesGroup->hide();
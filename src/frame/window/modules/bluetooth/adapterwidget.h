@@ -14,6 +14,7 @@
 
 #include <QWidget>
 #include <QPointer>
+#include <QHash>
 #include <QTime>
 #include <QTimer>
 
@@ -67,7 +68,7 @@ public:
 private:
     void initUI();
     void initConnect();
-    void categoryDevice(DeviceSettingsItem *deviceItem, const bool paired);
+    void insertPendingDevices();
 
 public Q_SLOTS:
     void toggleSwitch(const bool checked);
@@ -100,6 +101,13 @@ private:
     DCheckBox *m_showAnonymousCheckBox;
     QList<QPointer<DeviceSettingsItem>> m_deviceLists;
     QList<QPointer<DeviceSettingsItem>> m_myDevices;
+    // 设备 id 到列表项的索引，删除设备时不需要遍历列表
+    QHash<QString, QPointer<DeviceSettingsItem>> m_deviceItems;
+    // 没有名称的设备，切换“显示没有名称的设备”时只处理这些设备
+    QList<QPointer<DeviceSettingsItem>> m_anonymousDevices;
+    // 等待插入列表的设备，扫描时短时间内新增的设备一次插入
+    QList<QPointer<DeviceSettingsItem>> m_pendingDevices;
+    QTimer *m_insertTimer;
     TitleLabel *m_myDevicesGroup;
     DTK_WIDGET_NAMESPACE::DListView *m_myDeviceListView;
     QStandardItemModel *m_myDeviceModel;
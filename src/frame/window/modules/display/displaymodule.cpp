@@ -298,6 +298,7 @@ void DisplayModule::showMultiScreenWidget()
     multiScreenWidget->setModel(m_displayModel);
     connect(multiScreenWidget, &MultiScreenWidget::requestSwitchMode, m_displayWorker, &DisplayWorker::switchMode);
     connect(multiScreenWidget, &MultiScreenWidget::requestSetMonitorPosition, m_displayWorker, &DisplayWorker::setMonitorPosition);
+    connect(m_displayWorker, &DisplayWorker::configurationFailed, multiScreenWidget, &MultiScreenWidget::onConfigurationFailed);
     connect(multiScreenWidget, &MultiScreenWidget::requestSetPrimary, m_displayWorker, &DisplayWorker::setPrimary);
     connect(multiScreenWidget, &MultiScreenWidget::requestSetColorTemperature, m_displayWorker, &DisplayWorker::setColorTemperature);
     connect(multiScreenWidget, &MultiScreenWidget::requestSetMonitorBrightness, m_displayWorker, &DisplayWorker::setMonitorBrightness);
@@ -370,6 +371,8 @@ void DisplayModule::onRequestSetResolution(Monitor *monitor, const int mode)
     }
 
     auto tfunc = [this](Monitor *tmon, Resolution tmode) {
+        // 复制模式下所有显示器的分辨率修改放在一个事务中同时发出
+        m_displayWorker->beginTransaction();
         if (m_displayModel->displayMode() == MERGE_MODE) {
             for (auto monitor : m_displayModel->monitorList()) {
                 bool bFind = false;
@@ -387,6 +390,7 @@ void DisplayModule::onRequestSetResolution(Monitor *monitor, const int mode)
         } else {
             m_displayWorker->setMonitorResolution(tmon, tmode.id());
         }
+        m_displayWorker->commitTransaction(false);
 
         // 扩展模式调整分辨率时会再次调整显示屏位置，此时会调用两次applyChanges接口，
         // 修改分辨率调用applyChanges后任务栏会响应分辨率改变信号，然后调整大小，造成部分界面显示到第二个屏幕
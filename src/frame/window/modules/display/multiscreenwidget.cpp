@@ -523,6 +523,12 @@ void MultiScreenWidget::onResetFullIndication(const QRect &geometry)
     m_fullIndication->move(geometry.topLeft());
 }
 
+void MultiScreenWidget::onConfigurationFailed()
+{
+    // 配置没有生效，拖动过的屏幕按 model 中的实际位置重新摆放
+    m_monitorControlWidget->setModel(m_model, m_model->displayMode() == SINGLE_MODE ? m_model->primaryMonitor() : nullptr);
+}
+
 void MultiScreenWidget::onResetSecondaryScreenDlg()
 {
     for (int i = 0; i < m_secondaryScreenDlgList.count(); ++i) {
@@ -79,6 +79,7 @@ private:
 
 public Q_SLOTS:
     void onMainwindowStateChanged(int type);
+    void onConfigurationFailed();
 
 private Q_SLOTS:
     void onGatherWindows(const QPoint cursor);
@@ -120,18 +120,8 @@ void RefreshRateWidget::initRefreshRate()
         if (!Monitor::isSameResolution(mode, m_monitor->currentMode()))
             continue;
 
-        if (m_model->displayMode() == MERGE_MODE) {
-            bool isComm = true;
-            for (auto monitor : m_model->monitorList()) {
-                if (!monitor->hasResolutionAndRate(mode)) {
-                    isComm = false;
-                    break;
-                }
-            }
-
-            if (!isComm) {
-                continue;
-            }
+        if (m_model->displayMode() == MERGE_MODE && !m_model->isCommonMode(mode)) {
+            continue;
         }
 
         auto rate = mode.rate();
@@ -418,18 +418,8 @@ void ResolutionWidget::initResolution()
             }
 
             preMode = mode;
-            if (m_model->displayMode() == MERGE_MODE) {
-                bool isComm = true;
-                for (auto monitor : m_model->monitorList()) {
-                    if (!monitor->hasResolution(mode)) {
-                        isComm = false;
-                        break;
-                    }
-                }
-
-                if (!isComm) {
-                    continue;
-                }
+            if (m_model->displayMode() == MERGE_MODE && !m_model->isCommonResolution(mode)) {
+                continue;
             }
 
             auto *item = new DStandardItem;
@@ -459,18 +449,8 @@ void ResolutionWidget::initResolution()
             }
 
             preMode = mode;
-            if (m_model->displayMode() == MERGE_MODE) {
-                bool isComm = true;
-                for (auto monitor : m_model->monitorList()) {
-                    if (!monitor->hasResolution(mode)) {
-                        isComm = false;
-                        break;
-                    }
-                }
-
-                if (!isComm) {
-                    continue;
-                }
+            if (m_model->displayMode() == MERGE_MODE && !m_model->isCommonResolution(mode)) {
+                continue;
             }
 
             auto *item = new DStandardItem;
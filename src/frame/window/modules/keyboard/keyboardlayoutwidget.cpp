@@ -30,9 +30,17 @@ KeyboardLayoutWidget::KeyboardLayoutWidget(QWidget *parent)
     hlayout->setMargin(0);
     hlayout->setSpacing(0);
 
-    m_searchModel = new IndexModel();
-
     m_model = new IndexModel();
+    m_searchModel = new SearchFilterModel();
+    m_searchModel->setSourceModel(m_model);
+    m_searchModel->setKeyFunction([](const QModelIndex &index) -> QString {
+        // 分组字母不参与搜索，名称和拼音都可以匹配
+        const MetaData &md = index.data(IndexModel::KBLayoutRole).value<MetaData>();
+        if (md.key().isEmpty())
+            return QString();
+
+        return md.text() + '\n' + md.pinyin();
+    });
     m_view = new IndexView();
     m_view->setAccessibleName("List_keyboardmenulist");
     m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -113,21 +121,9 @@ KeyboardLayoutWidget::~KeyboardLayoutWidget()
 
 void KeyboardLayoutWidget::onAddKBLayout()
 {
-    QVariant var;
-    MetaData md;
-
-    if (searchStatus) {
-        var = m_selectSearchIndex.data(IndexModel::KBLayoutRole);
-        md = var.value<MetaData>();
-        if (m_searchModel->letters().contains(md.text())) {
-            return;
-        }
-    } else {
-        var = m_selectIndex.data(IndexModel::KBLayoutRole);
-        md = var.value<MetaData>();
-        if (m_model->letters().contains(md.text())) {
-            return;
-        }
+    MetaData md = m_selectIndex.data(IndexModel::KBLayoutRole).value<MetaData>();
+    if (m_model->letters().contains(md.text())) {
+        return;
     }
 
     Q_EMIT layoutSelected(md.text());
@@ -136,30 +132,26 @@ void KeyboardLayoutWidget::onAddKBLayout()
 
 void KeyboardLayoutWidget::onKBLayoutSelect(const QModelIndex &index)
 {
-    if (searchStatus) {
-        setDataModel(m_searchModel, m_selectSearchIndex, index);
-    } else{
-        setDataModel(m_model, m_selectIndex, index);
-    }
+    setDataModel(searchStatus ? m_searchModel->mapToSource(index) : index);
 }
 
-void KeyboardLayoutWidget::setDataModel(IndexModel *model, QModelIndex &selectedIndex, const QModelIndex &index) {
+void KeyboardLayoutWidget::setDataModel(const QModelIndex &index) {
 
-    if (selectedIndex.isValid()) {
-        model->itemFromIndex(selectedIndex)->setCheckState(Qt::Unchecked);
+    if (m_selectIndex.isValid()) {
+        m_model->itemFromIndex(m_selectIndex)->setCheckState(Qt::Unchecked);
     }
 
-    QStandardItem *selectItem = model->itemFromIndex(index);
+    QStandardItem *selectItem = m_model->itemFromIndex(index);
 
     if (selectItem) {
         bool addBtnEnabled = true;
         QVariant var = index.data(IndexModel::KBLayoutRole);
         MetaData md = var.value<MetaData>();
-        if (md.text().isEmpty() || model->letters().contains(md.text())) {
+        if (md.text().isEmpty() || m_model->letters().contains(md.text())) {
             addBtnEnabled = false;
         } else {
             selectItem->setCheckState(Qt::Checked);
-            selectedIndex = index;
+            m_selectIndex = index;
         }
         m_buttonTuple->rightButton()->setEnabled(addBtnEnabled);
     }
@@ -183,7 +175,8 @@ void KeyboardLayoutWidget::setMetaData(const QList<MetaData> &datas)
     }
 
     m_model->setMetaData(m_data);
-    m_view->setModel(m_model);
+    if (!searchStatus)
+        m_view->setModel(m_model);
 }
 
 void KeyboardLayoutWidget::setLetters(QList<QString> letters)
@@ -211,6 +204,8 @@ void KeyboardLayoutWidget::setLetters(QList<QString> letters)
 
 void KeyboardLayoutWidget::onSearch(const QString &text)
 {
+    m_searchModel->setFilterText(text);
+
     if (text.length() == 0) {
         searchStatus = false;
         m_view->setModel(m_model);
@@ -218,23 +213,18 @@ void KeyboardLayoutWidget::onSearch(const QString &text)
             m_indexframe->show();
     } else {
         searchStatus = true;
-        QList<MetaData> datas = m_model->metaData();
-        QList<MetaData>::iterator it = datas.begin();
-        QList<MetaData> sdatas;
-        for (; it != datas.end(); ++it) {
-            if ((*it).text().contains(text, Qt::CaseInsensitive)) {
-                if (!(*it).key().isEmpty()) {
-                   sdatas.append(*it);
-                }
-            }
-        }
-        m_searchModel->clear();
-        m_searchModel->setMetaData(sdatas);
         m_view->setModel(m_searchModel);
         if (m_indexframe)
             m_indexframe->hide();
-        m_buttonTuple->rightButton()->setEnabled(false);
+
+        // 选中的布局不在搜索结果中时取消选中
+        if (m_selectIndex.isValid() && !m_searchModel->mapFromSource(m_selectIndex).isValid()) {
+            m_model->itemFromIndex(m_selectIndex)->setCheckState(Qt::Unchecked);
+            m_selectIndex = QModelIndex();
+        }
     }
+
+    m_buttonTuple->rightButton()->setEnabled(m_selectIndex.isValid());
 }
 
 void KeyboardLayoutWidget::onItemClicked(const QModelIndex &index)
@@ -11,6 +11,7 @@
 #include "modules/keyboard/indexview.h"
 #include "modules/keyboard/indexframe.h"
 #include "modules/keyboard/indexdelegate.h"
+#include "modules/keyboard/searchfiltermodel.h"
 #include "widgets/searchinput.h"
 #include "widgets/buttontuple.h"
 
@@ -33,7 +34,7 @@ public:
     explicit KeyboardLayoutWidget(QWidget *parent = 0);
     ~KeyboardLayoutWidget();
 
-    void setDataModel(IndexModel *model, QModelIndex &selectedIndex, const QModelIndex &index);
+    void setDataModel(const QModelIndex &index);
     void setMetaData(const QList<MetaData>& datas);
     void setLetters(QList<QString> letters);
 
@@ -55,13 +56,12 @@ private:
     ButtonTuple *m_buttonTuple;
     IndexView *m_view;
     IndexModel *m_model;
-    IndexModel *m_searchModel;
+    SearchFilterModel *m_searchModel;
     IndexFrame *m_indexframe;
     TranslucentFrame *m_mainWidget;
     DGraphicsClipEffect *m_clipEffectWidget;
     QList<MetaData> m_data;
-    QModelIndex m_selectIndex;
-    QModelIndex m_selectSearchIndex;
+    QPersistentModelIndex m_selectIndex;    // m_model 中选中的布局，搜索结果和完整列表共用
 };
 }
 }
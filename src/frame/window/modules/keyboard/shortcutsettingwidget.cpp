@@ -521,7 +521,7 @@ void ShortCutSettingWidget::onKeyEvent(bool press, const QString &shortcut)
                 current->item->setShortcut(current->accels);
             } else {
                 // save
-                current->accels = shortcut;
+                m_model->setAccels(current, shortcut);
                 Q_EMIT requestSaveShortcut(current);
             }
         }
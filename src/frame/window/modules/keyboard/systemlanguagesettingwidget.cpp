@@ -8,6 +8,7 @@
 #include "modules/keyboard/indexdelegate.h"
 #include "modules/keyboard/indexview.h"
 #include "modules/keyboard/indexmodel.h"
+#include "modules/keyboard/searchfiltermodel.h"
 #include "widgets/searchinput.h"
 #include "widgets/translucentframe.h"
 
@@ -33,6 +34,11 @@ SystemLanguageSettingWidget::SystemLanguageSettingWidget(KeyboardModel *model, Q
     layout->setSpacing(0);
 
     m_model = new QStandardItemModel(this);
+    m_searchModel = new SearchFilterModel(this);
+    m_searchModel->setSourceModel(m_model);
+    m_searchModel->setKeyFunction([](const QModelIndex &index) -> QString {
+        return index.data(Qt::DisplayRole).toString() + '\n' + index.data(PingYinRole).toString();
+    });
     m_view = new DListView();
     m_view->setAccessibleName("List_languagelist");
     m_view->setFrameShape(QFrame::NoFrame);
@@ -99,56 +105,46 @@ SystemLanguageSettingWidget::~SystemLanguageSettingWidget()
 
 void SystemLanguageSettingWidget::onSearch(const QString &text)
 {
+    m_searchModel->setFilterText(text);
+
     if (text.length() == 0) {
         m_searchStatus = false;
         m_view->setModel(m_model);
     } else {
         m_searchStatus = true;
-        m_searchModelIndex = QModelIndex();
-        m_searchModel = new QStandardItemModel(this);
-
-        for (auto md : m_datas) {
-            if (md.text().contains(text, Qt::CaseInsensitive)) {
-                auto item = new DStandardItem(md.text());
-                item->setText(md.text());
-                item->setData(md.key(),KeyRole);
-                item->setData(md.pinyin(),PingYinRole);
-                m_searchModel->appendRow(item);
-            }
-        }
         m_view->setModel(m_searchModel);
+
+        // 选中的语言不在搜索结果中时取消选中
+        if (m_modelIndex.isValid() && !m_searchModel->mapFromSource(m_modelIndex).isValid()) {
+            m_model->itemFromIndex(m_modelIndex)->setCheckState(Qt::Unchecked);
+            m_modelIndex = QModelIndex();
+        }
     }
+
+    m_buttonTuple->rightButton()->setEnabled(m_modelIndex.isValid());
 }
 
 void SystemLanguageSettingWidget::onAddLanguage()
 {
-    if(m_searchStatus) {
-        Q_EMIT click(m_searchModelIndex);
-    } else{
-        Q_EMIT click(m_modelIndex);
-    }
+    Q_EMIT click(m_modelIndex);
     Q_EMIT back();
 }
 
 void SystemLanguageSettingWidget::onLangSelect(const QModelIndex &index)
 {
-    if(m_searchStatus) {
-        updateDataModel(m_searchModel, m_searchModelIndex, index);
-    } else {
-        updateDataModel(m_model, m_modelIndex, index);
-    }
+    updateDataModel(m_searchStatus ? m_searchModel->mapToSource(index) : index);
 }
 
-void SystemLanguageSettingWidget::updateDataModel(QStandardItemModel *model, QModelIndex &selectedIndex, const QModelIndex &index) {
+void SystemLanguageSettingWidget::updateDataModel(const QModelIndex &index) {
 
-    if (selectedIndex.isValid()) {
-        model->itemFromIndex(selectedIndex)->setCheckState(Qt::Unchecked);
+    if (m_modelIndex.isValid()) {
+        m_model->itemFromIndex(m_modelIndex)->setCheckState(Qt::Unchecked);
     }
 
-    QStandardItem *selectedItem = model->itemFromIndex(index);
+    QStandardItem *selectedItem = m_model->itemFromIndex(index);
     if (selectedItem) {
         selectedItem->setCheckState(Qt::Checked);
-        selectedIndex = index;
+        m_modelIndex = index;
         m_buttonTuple->rightButton()->setEnabled(true);
     }
 }
@@ -172,7 +168,8 @@ void SystemLanguageSettingWidget::setModelData(const QList<MetaData> &datas)
         item->setData(md.pinyin(),PingYinRole);
         m_model->appendRow(item);
     }
-    m_view->setModel(m_model);
+    if (!m_searchStatus)
+        m_view->setModel(m_model);
 }
 
 bool SystemLanguageSettingWidget::eventFilter(QObject *watched, QEvent *event)
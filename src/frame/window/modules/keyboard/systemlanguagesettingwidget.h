@@ -22,6 +22,7 @@ class IndexDelegate;
 class MetaData;
 class IndexModel;
 class IndexView;
+class SearchFilterModel;
 }
 
 namespace widgets {
@@ -40,7 +41,7 @@ public:
     explicit SystemLanguageSettingWidget(dcc::keyboard::KeyboardModel *model, QWidget *parent = nullptr);
     ~SystemLanguageSettingWidget();
 
-    void updateDataModel(QStandardItemModel *model, QModelIndex &selectedIndex, const QModelIndex &index);
+    void updateDataModel(const QModelIndex &index);
 
     enum LanguageRole{
         TextRole = DTK_NAMESPACE::UserRole + 1,
@@ -67,12 +68,11 @@ private:
     dcc::widgets::ButtonTuple *m_buttonTuple;
     Dtk::Widget::DListView *m_view;
     QStandardItemModel *m_model;
-    QStandardItemModel *m_searchModel;
+    dcc::keyboard::SearchFilterModel *m_searchModel;
     DGraphicsClipEffect *m_clipEffectWidget;
     dcc::widgets::TranslucentFrame *m_contentWidget;
     QList<dcc::keyboard::MetaData> m_datas;  
-    QModelIndex m_modelIndex;
-    QModelIndex m_searchModelIndex;
+    QPersistentModelIndex m_modelIndex;     // m_model 中选中的语言，搜索结果和完整列表共用
 };
 }
 }
@@ -135,7 +135,8 @@ void PerssonalizationThemeList::onSetPic(const QString &id, const QString &picPa
             continue;
 
         DViewItemActionList list;
-        QPixmap pxmap = QPixmap(picPath);
+        const QImage &image = m_model->picImage(id);
+        QPixmap pxmap = image.isNull() ? QPixmap(picPath) : QPixmap::fromImage(image);
         DViewItemAction *iconAction = new DViewItemAction(Qt::AlignLeft, pxmap.size() / devicePixelRatioF());
         iconAction->setIcon(QIcon(pxmap));
         list << iconAction;
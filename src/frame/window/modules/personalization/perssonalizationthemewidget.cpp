@@ -114,7 +114,7 @@ void PerssonalizationThemeWidget::onSetPic(const QString &id, const QString &pic
     QMap<ThemeItem *, QJsonObject>::const_iterator it = m_valueMap.constBegin();
     while (it != m_valueMap.constEnd()) {
         if (it.key()->id() == id) {
-            it.key()->setPic(picPath);
+            it.key()->setPic(picPath, m_model->picImage(id));
             return;
         }
         ++it;
@@ -67,9 +67,9 @@ void ThemeItem::setSelected(bool selected)
     }
 }
 
-void ThemeItem::setPic(const QString &picPath)
+void ThemeItem::setPic(const QString &picPath, const QImage &image)
 {
-    m_itemPic->setPath(picPath);
+    m_itemPic->setPath(picPath, image);
     m_mainLayout->setAlignment(m_title, Qt::AlignCenter);
 }
 
@@ -10,6 +10,7 @@
 
 #include <QWidget>
 #include <QVariant>
+#include <QImage>
 
 class QVBoxLayout;
 class QLabel;
@@ -30,7 +31,7 @@ public:
 
     void setTitle(const QString &title);
     void setSelected(bool selected);
-    void setPic(const QString &picPath);
+    void setPic(const QString &picPath, const QImage &image = QImage());
     void setId(const QVariant &id);
     inline const QVariant id() const { return m_id; }
 
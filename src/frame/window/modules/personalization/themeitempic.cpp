@@ -38,10 +38,16 @@ void ThemeItemPic::setSelected(bool selected)
     update();
 }
 
-void ThemeItemPic::setPath(const QString &picPath)
+void ThemeItemPic::setPath(const QString &picPath, const QImage &image)
 {
-    render->load(picPath);
-    QSize defaultSize = render->defaultSize();
+    m_image = image;
+    QSize defaultSize;
+    if (m_image.isNull()) {
+        render->load(picPath);
+        defaultSize = render->defaultSize();
+    } else {
+        defaultSize = m_image.size() / m_image.devicePixelRatio();
+    }
 
     int margins = style()->pixelMetric(static_cast<QStyle::PixelMetric>(DStyle::PM_FrameMargins));
     int borderWidth = style()->pixelMetric(static_cast<QStyle::PixelMetric>(DStyle::PM_FocusBorderWidth), nullptr, nullptr);
@@ -77,9 +83,12 @@ void ThemeItemPic::paintEvent(QPaintEvent *event)
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
     //first draw image
-    const auto ratio = devicePixelRatioF();
-    QSize defaultSize = render->defaultSize() * ratio;
-    QImage img = render->toImage(defaultSize);
+    QImage img = m_image;
+    if (img.isNull()) {
+        const auto ratio = devicePixelRatioF();
+        QSize defaultSize = render->defaultSize() * ratio;
+        img = render->toImage(defaultSize);
+    }
     QRect picRect = rect().adjusted(totalSpace, totalSpace, -totalSpace, -totalSpace);
     painter.drawImage(picRect, img, img.rect());
 
@@ -8,6 +8,7 @@
 
 #include <DSvgRenderer>
 
+#include <QImage>
 #include <QWidget>
 
 class QSize;
@@ -21,7 +22,8 @@ public:
     explicit ThemeItemPic(QWidget *parent = nullptr);
     bool isSelected();
     void setSelected(bool selected);
-    void setPath(const QString &picPath);
+    // image 不为空时直接绘制已解码的缩略图
+    void setPath(const QString &picPath, const QImage &image = QImage());
     ~ThemeItemPic();
 
 Q_SIGNALS:
@@ -34,6 +36,7 @@ protected:
 private:
     bool m_isSelected = false;
     DTK_GUI_NAMESPACE::DSvgRenderer *render;
+    QImage m_image;
 };
 }
 }
@@ -156,6 +156,9 @@ void UpdateModule::active()
         connect(m_mirrorsWidget, &MirrorsWidget::notifyDestroy, this, [this]() {
             //notifyDestroy信号是此对象被销毁，析构时发出的，资源销毁了要将其对象赋值为空
             m_mirrorsWidget = nullptr;
+            // 页面关闭后停止还未完成的测速
+            if (m_work)
+                QMetaObject::invokeMethod(m_work.get(), &UpdateWorker::cancelTestMirrorSpeed, Qt::QueuedConnection);
         });
         connect(m_model, &UpdateModel::smartMirrorSwitchChanged, this, &UpdateModule::onNotifyDealMirrorWidget);
 
@@ -4,6 +4,7 @@
 
 #include "wacomworker.h"
 #include "wacommodel.h"
+#include "window/dbuscallcoalescer.h"
 
 namespace DCC_NAMESPACE {
 namespace wacom {
@@ -15,6 +16,7 @@ WacomWorker::WacomWorker(WacomModel *model, QObject *parent)
     : QObject(parent)
     , m_dbusWacom(new Wacom(Service, ServicePath, QDBusConnection::sessionBus(), this))
     , m_model(model)
+    , m_sliderCalls(new DBusCallCoalescer(this))
 {
     connect(m_dbusWacom, &Wacom::StylusPressureSensitiveChanged, this, &WacomWorker::setPressureSensitive);
     connect(m_dbusWacom, &Wacom::ExistChanged, m_model, &WacomModel::setExist);
@@ -54,8 +56,8 @@ void WacomWorker::setCursorMode(const bool value)
 
 void WacomWorker::onPressureSensitiveChanged(const uint value)
 {
-    m_dbusWacom->setStylusPressureSensitive(value);
-    m_dbusWacom->setEraserPressureSensitive(value);
+    m_sliderCalls->setDBusProperty("StylusPressureSensitive", m_dbusWacom, "StylusPressureSensitive", value);
+    m_sliderCalls->setDBusProperty("EraserPressureSensitive", m_dbusWacom, "EraserPressureSensitive", value);
 }
 
 void WacomWorker::onCursorModeChanged(const bool value)
@@ -10,6 +10,7 @@
 #include <QObject>
 
 using Wacom = com::deepin::daemon::inputdevice::Wacom;
+class DBusCallCoalescer;
 
 namespace DCC_NAMESPACE {
 namespace wacom {
@@ -38,6 +39,7 @@ private:
 private:
     Wacom *m_dbusWacom;
     WacomModel *m_model;
+    DBusCallCoalescer *m_sliderCalls;   // 压感滑动条拖动时只发送最新的值
 };
 }
 }
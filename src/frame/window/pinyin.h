@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PINYIN_H
+#define PINYIN_H
+
+#include <DPinyin>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+
+/**
+ * @brief 线程安全的汉字转拼音
+ * DTK 的拼音表在第一次转换时加载且没有加锁，搜索索引和键盘布局列表会在不同的线程池线程中同时转换，
+ * 所有调用都需要经过这里，结果带有声调数字，如 "han4yu3"
+ */
+inline QString chinese2Pinyin(const QString &text)
+{
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+    return DTK_CORE_NAMESPACE::Chinese2Pinyin(text);
+}
+
+#endif // PINYIN_H
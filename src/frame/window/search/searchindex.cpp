@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchindex.h"
+
+#include <algorithm>
+
+// 倒排表中子串的最大长度，更长的查询由多个 trigram 求交集得到
+const int GramSize = 3;
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::search;
+
+SearchIndex::SearchIndex()
+{
+}
+
+void SearchIndex::addEntry(const QString &text, const QString &result)
+{
+    const int id = m_texts.size();
+    const QString folded = text.toCaseFolded();
+    m_texts.append(folded);
+    m_results.append(result);
+
+    for (int n = 1; n <= GramSize; ++n) {
+        for (int i = 0; i + n <= folded.size(); ++i) {
+            QVector<int> &posting = m_postings[folded.mid(i, n)];
+            // 同一条数据中重复出现的子串只记录一次
+            if (posting.isEmpty() || posting.last() != id) {
+                posting.append(id);
+            }
+        }
+    }
+}
+
+QStringList SearchIndex::search(const QString &text) const
+{
+    QStringList lstResults;
+    const QString folded = text.toCaseFolded();
+
+    // 与 QString::contains 保持一致，空字符串匹配所有数据
+    if (folded.isEmpty()) {
+        for (const QString &result : m_results) {
+            lstResults << result;
+        }
+        return lstResults;
+    }
+
+    for (int id : candidates(folded)) {
+        // 超过 GramSize 的查询只能保证包含所有 trigram，需要再确认一次
+        if (folded.size() <= GramSize || m_texts[id].contains(folded)) {
+            lstResults << m_results[id];
+        }
+    }
+
+    return lstResults;
+}
+
+QVector<int> SearchIndex::candidates(const QString &text) const
+{
+    if (text.size() <= GramSize) {
+        return m_postings.value(text);
+    }
+
+    QList<const QVector<int> *> postings;
+    for (int i = 0; i + GramSize <= text.size(); ++i) {
+        auto it = m_postings.constFind(text.mid(i, GramSize));
+        if (it == m_postings.constEnd()) {
+            return QVector<int>();
+        }
+        postings << &it.value();
+    }
+
+    // 从最短的倒排表开始求交集
+    std::sort(postings.begin(), postings.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<int> result = *postings.first();
+    for (int i = 1; i < postings.size() && !result.isEmpty(); ++i) {
+        QVector<int> intersection;
+        std::set_intersection(result.cbegin(), result.cend(),
+                              postings[i]->cbegin(), postings[i]->cend(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+
+    return result;
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+/**
+ * @brief 搜索数据的 n-gram 倒排索引
+ * 对每条搜索数据(汉字/拼音/英文)建立长度 1~3 的子串到数据编号的倒排表，
+ * 查询时只需要对查询串的 trigram 倒排表求交集再做一次确认，耗时与数据总量无关。
+ * 索引建立后只读，可以在多个线程中同时查询。
+ */
+class SearchIndex
+{
+public:
+    SearchIndex();
+
+    void addEntry(const QString &text, const QString &result);
+    QStringList search(const QString &text) const;
+    int count() const { return m_texts.size(); }
+
+private:
+    QVector<int> candidates(const QString &text) const;
+
+private:
+    QVector<QString> m_texts;                    // 用于匹配的数据(已转换为小写)
+    QVector<QString> m_results;                  // 匹配后返回的数据(拼音已转换为汉字)
+    QHash<QString, QVector<int>> m_postings;     // n-gram -> 数据编号(升序)
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchindexcache.h"
+#include "window/pinyin.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+
+const QString XML_Source = "source";
+const QString XML_Title = "translation";
+const QString XML_Numerusform = "numerusform";
+const QString XML_Explain_Path = "extra-contents_path";
+const QString XML_Child_Path = "extra-child_page";
+const QString XML_ChildHide_Path = "extra-child_page_hide";
+
+// 缓存文件格式变化时需要修改版本号，旧的缓存会被直接丢弃
+const quint32 IndexMagic = 0x44434353; // "DCCS"
+const quint32 IndexVersion = 1;
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::search;
+
+static QDataStream &operator<<(QDataStream &out, const SearchIndexEntry &entry)
+{
+    return out << entry.source << entry.translateContent << entry.childPage << entry.fullPagePath;
+}
+
+static QDataStream &operator>>(QDataStream &in, SearchIndexEntry &entry)
+{
+    return in >> entry.source >> entry.translateContent >> entry.childPage >> entry.fullPagePath;
+}
+
+static QDataStream &operator<<(QDataStream &out, const SearchIndexFile &file)
+{
+    return out << file.path << file.mtime << file.size << file.entries << file.childPages << file.hideChildPages;
+}
+
+static QDataStream &operator>>(QDataStream &in, SearchIndexFile &file)
+{
+    return in >> file.path >> file.mtime >> file.size >> file.entries >> file.childPages >> file.hideChildPages;
+}
+
+SearchIndexCache::SearchIndexCache(const QString &lang)
+    : m_lang(lang)
+    , m_dirty(false)
+{
+    m_cacheFile = QString("%1/search/index_%2.cache")
+                  .arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                  .arg(lang);
+}
+
+bool SearchIndexCache::load()
+{
+    QFile file(m_cacheFile);
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= 0) {
+        return false;
+    }
+
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        qWarning() << " [SearchIndexCache] map cache file failed:" << m_cacheFile << file.errorString();
+        return false;
+    }
+
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<int>(file.size()));
+    QDataStream in(raw);
+    in.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString lang;
+    in >> magic >> version >> lang;
+
+    bool ret = false;
+    if (magic == IndexMagic && version == IndexVersion && lang == m_lang) {
+        QList<SearchIndexFile> files;
+        in >> files >> m_pinyin;
+
+        if (in.status() == QDataStream::Ok) {
+            for (const SearchIndexFile &indexFile : files) {
+                m_files.insert(indexFile.path, indexFile);
+            }
+            ret = true;
+        } else {
+            qWarning() << " [SearchIndexCache] cache file is broken:" << m_cacheFile;
+            m_pinyin.clear();
+        }
+    }
+
+    file.unmap(data);
+    file.close();
+    return ret;
+}
+
+bool SearchIndexCache::save()
+{
+    // 文件列表或拼音有变化时才需要重写缓存
+    if (!m_dirty && m_usedFiles.size() == m_files.size() && m_usedPinyin.size() == m_pinyin.size()) {
+        return true;
+    }
+
+    QDir().mkpath(QFileInfo(m_cacheFile).absolutePath());
+
+    QSaveFile file(m_cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << " [SearchIndexCache] open cache file failed:" << m_cacheFile << file.errorString();
+        return false;
+    }
+
+    QList<SearchIndexFile> files;
+    for (const QString &path : m_usedFiles) {
+        files << m_files.value(path);
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << IndexMagic << IndexVersion << m_lang << files << usedPinyin();
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << " [SearchIndexCache] write cache file failed:" << m_cacheFile;
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+bool SearchIndexCache::find(const QFileInfo &info, SearchIndexFile &file)
+{
+    const QString &path = info.absoluteFilePath();
+    auto it = m_files.constFind(path);
+    if (it == m_files.constEnd()
+            || it->mtime != info.lastModified().toMSecsSinceEpoch()
+            || it->size != info.size()) {
+        return false;
+    }
+
+    m_usedFiles.insert(path);
+    file = it.value();
+    return true;
+}
+
+void SearchIndexCache::insert(const SearchIndexFile &file)
+{
+    m_files.insert(file.path, file);
+    m_usedFiles.insert(file.path);
+    m_dirty = true;
+}
+
+QString SearchIndexCache::pinyin(const QString &text)
+{
+    auto it = m_pinyin.constFind(text);
+    if (it == m_pinyin.constEnd()) {
+        it = m_pinyin.insert(text, toPinyin(text));
+        m_dirty = true;
+    }
+
+    m_usedPinyin.insert(text);
+    return it.value();
+}
+
+QHash<QString, QString> SearchIndexCache::usedPinyin() const
+{
+    QHash<QString, QString> result;
+    result.reserve(m_usedPinyin.size());
+    for (const QString &text : m_usedPinyin) {
+        result.insert(text, m_pinyin.value(text));
+    }
+
+    return result;
+}
+
+bool SearchIndexCache::parseTranslationFile(const QFileInfo &info, SearchIndexFile &file)
+{
+    QFile xmlFile(info.absoluteFilePath());
+    if (!xmlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << " [SearchIndexCache] File open failed:" << info.absoluteFilePath();
+        return false;
+    }
+
+    file = SearchIndexFile();
+    file.path = info.absoluteFilePath();
+    file.mtime = info.lastModified().toMSecsSinceEpoch();
+    file.size = info.size();
+
+    QXmlStreamReader xmlRead(&xmlFile);
+    SearchIndexEntry entry;
+    QString xmlExplain;
+
+    //遍历XML文件,读取每一行的xml数据都会
+    //先进入StartElement读取出<>中的内容;
+    //再进入Characters读取出中间数据部分;
+    //最后进入时进入EndElement读取出</>中的内容
+    while (!xmlRead.atEnd()) {
+        switch (xmlRead.readNext()) {
+        case QXmlStreamReader::StartElement:
+            xmlExplain = xmlRead.name().toString();
+            break;
+        case QXmlStreamReader::Characters: {
+            if (xmlRead.isWhitespace()) {
+                break;
+            }
+
+            const QString &text = xmlRead.text().toString();
+            if (xmlExplain == XML_Source) {
+                entry.translateContent = QString(text).remove('/').trimmed();
+                entry.source = text;
+            } else if (xmlExplain == XML_Title || xmlExplain == XML_Numerusform) {
+                if (text != "")  // translation not nullptr can set it
+                    entry.translateContent = QString(text).remove('/').trimmed();
+            } else if (xmlExplain == XML_Child_Path) {
+                entry.childPage = text;
+                file.childPages << text;
+            } else if (xmlExplain == XML_ChildHide_Path) {
+                file.hideChildPages << text;
+            } else if (xmlExplain == XML_Explain_Path) {
+                entry.fullPagePath = text;
+                file.entries << entry;
+                entry = SearchIndexEntry();
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    xmlFile.close();
+    return true;
+}
+
+QString SearchIndexCache::toPinyin(const QString &text)
+{
+    QString input = text;
+    input.remove(QRegularExpression(R"([a-zA-Z]+)"));
+    if (input == "")
+        return "";
+
+    //去掉拼音中的声调数字
+    QString value = "";
+    QByteArray ba = chinese2Pinyin(input).toLocal8Bit();
+    const char *data = ba.constData();
+    while (*data) {
+        if (!(*data >= '0' && *data <= '9')) {
+            value += *data;
+        }
+        data++;
+    }
+
+    return value;
+}
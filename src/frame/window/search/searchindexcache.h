@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+// 翻译文件(.ts)中一条搜索数据的原始内容，未经过模块名称/子页面名称的运行时转换
+struct SearchIndexEntry {
+    QString source;
+    QString translateContent;
+    QString childPage;
+    QString fullPagePath;
+};
+
+// 单个翻译文件解析后的结果，通过 mtime + size 判断是否过期
+struct SearchIndexFile {
+    QString path;
+    qint64 mtime = 0;
+    qint64 size = 0;
+    QList<SearchIndexEntry> entries;
+    QStringList childPages;         // 文件中出现过的全部 extra-child_page
+    QStringList hideChildPages;     // 文件中出现过的全部 extra-child_page_hide
+};
+
+/**
+ * @brief 搜索数据的二进制索引缓存
+ * 每种语言一个缓存文件，保存各翻译文件的解析结果和已计算的拼音，
+ * 启动时通过内存映射读取，只有翻译文件变化时才重新解析 XML。
+ * 该类不是线程安全的，应在同一个线程中完成 load/find/insert/save。
+ */
+class SearchIndexCache
+{
+public:
+    explicit SearchIndexCache(const QString &lang);
+
+    bool load();
+    bool save();
+
+    bool find(const QFileInfo &info, SearchIndexFile &file);
+    void insert(const SearchIndexFile &file);
+    QString pinyin(const QString &text);
+    QHash<QString, QString> usedPinyin() const;
+
+    static bool parseTranslationFile(const QFileInfo &info, SearchIndexFile &file);
+    static QString toPinyin(const QString &text);
+
+private:
+    QString m_lang;
+    QString m_cacheFile;
+    bool m_dirty;
+    QHash<QString, SearchIndexFile> m_files;
+    QHash<QString, QString> m_pinyin;
+    QSet<QString> m_usedFiles;
+    QSet<QString> m_usedPinyin;
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "searchmodel.h"
+#include "searchindexcache.h"
 #include "window/utils.h"
+#include "window/tracer.h"
+#include "window/pinyin.h"
 
-#include <DPinyin>
 #include <QDebug>
 #include <QRegularExpression>
 #include <QFutureWatcher>
@@ -13,12 +15,6 @@
 
 #define DEBUG_XML_SWITCH 0
 
-const QString XML_Source = "source";
-const QString XML_Title = "translation";
-const QString XML_Numerusform = "numerusform";
-const QString XML_Explain_Path = "extra-contents_path";
-const QString XML_Child_Path = "extra-child_page";
-const QString XML_ChildHide_Path = "extra-child_page_hide";
 const int TxtWidth = 310;
 
 using namespace DCC_NAMESPACE;
@@ -180,10 +176,12 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
 void SearchModel::loadxml(const QString module)
 {
     Q_UNUSED(module)
+    TraceScope trace("SearchModel::loadxml");
 
     clear(); // It doesn't seem to leak memory
     m_EnterNewPagelist.clear();
     m_inputList.clear();
+    m_pinyinToChinese.clear();
     m_TxtListAll.clear();
     m_scaleTxtMap.clear();
 
@@ -294,6 +292,8 @@ void SearchModel::loadxml(const QString module)
 
         m_TxtListAll.append(searchBoxStrcut->translateContent.remove('/').trimmed());
     }
+
+    buildSearchIndex();
 }
 
 //Follow display content to Analysis SearchBoxStruct data
@@ -343,39 +343,21 @@ QString SearchModel::getModulesName(const QString &name, bool state)
     return strResult;
 }
 
-QString SearchModel::removeDigital(QString input)
+//优先使用索引缓存中预先计算好的拼音
+QString SearchModel::getPinyin(const QString &text) const
 {
-    if ("" == input)
-        return "";
-
-    QString value = "";
-    QByteArray ba = input.toLocal8Bit();
-    char *data = nullptr;
-    data = ba.data();
-    while (*data) {
-        if (!(*data >= '0' && *data <= '9')) {
-            value += *data;
-        }
-        data++;
+    auto it = m_pinyinMap.constFind(text);
+    if (it != m_pinyinMap.constEnd()) {
+        return it.value();
     }
 
-    return value;
+    return SearchIndexCache::toPinyin(text);
 }
 
 QString SearchModel::transPinyinToChinese(const QString &pinyin)
 {
-    QString value = pinyin;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    auto res = std::find_if(m_inputList.begin(), m_inputList.end(), [=] (const SearchDataStruct data)->bool{
-            return value == data.pinyin;
-        });
-
-        if (res != m_inputList.end()) {
-            value =(*res).chiese;
-        }
-
-    return value;
+    //将存在的"拼音"转换为"汉字"
+    return m_pinyinToChinese.value(pinyin, pinyin);
 }
 
 QString SearchModel::containTxtData(QString txt)
@@ -424,12 +406,13 @@ void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
         QString hanziTxt = QString("%1 --> %2").arg(dataBackup->actualModuleName).arg(dataBackup->translateContent);
 
         QString pinyinTxt = QString("%1 --> %2")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
+                            .arg(getPinyin(dataBackup->actualModuleName))
+                            .arg(getPinyin(dataBackup->translateContent));
+        dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)"));
 
         // 如果模块名称中英文相同则不继续添加拼音搜索显示,否则会重复索引
         // guoyao：针对Union ID（中文环境使用英文模块名），dataBackup->actualModuleName将被过滤为空，所以会return掉；但是data数据并不会更改，所以用data数据进行判断即可
-        if (data->actualModuleName == DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName)) return;
+        if (data->actualModuleName == chinese2Pinyin(dataBackup->actualModuleName)) return;
 
         //添加显示的汉字(用于拼音搜索显示)
         appendRow(new QStandardItem(icon.value(), getNormalText(hanziTxt)));
@@ -442,6 +425,9 @@ void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
         //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
         //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
         m_inputList.append(transdata);
+        if (!m_pinyinToChinese.contains(pinyinTxt)) {
+            m_pinyinToChinese.insert(pinyinTxt, hanziTxt);
+        }
     } else {
         //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
         //Qt::EditRole数据用于显示搜索到的结果(汉字)
@@ -464,9 +450,9 @@ void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
 
         QString hanziTxt = QString("%1 --> %2 / %3").arg(dataBackup->actualModuleName).arg(dataBackup->childPageName).arg(dataBackup->translateContent);
         QString pinyinTxt = QString("%1 --> %2 / %3")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->childPageName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
+                            .arg(getPinyin(dataBackup->actualModuleName))
+                            .arg(getPinyin(dataBackup->childPageName))
+                            .arg(getPinyin(dataBackup->translateContent));
         //添加显示的汉字(用于拼音搜索显示)
         auto icons = m_iconMap.find(dataBackup->fullPagePath.section('/', 1, 1));
         if (icons == m_iconMap.end()) {
@@ -482,6 +468,9 @@ void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
         //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
         //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
         m_inputList.append(transdata);
+        if (!m_pinyinToChinese.contains(pinyinTxt)) {
+            m_pinyinToChinese.insert(pinyinTxt, hanziTxt);
+        }
     }
 }
 
@@ -495,6 +484,21 @@ bool SearchModel::specialProcessData(SearchBoxStruct::Ptr data)
     return ret;
 }
 
+//根据当前数据重新生成搜索索引，查询时不再遍历model
+void SearchModel::buildSearchIndex()
+{
+    TraceScope trace("SearchModel::buildSearchIndex");
+    QSharedPointer<SearchIndex> searchIndex(new SearchIndex);
+    const int role = m_bIsChinese ? Qt::UserRole : Qt::DisplayRole;
+
+    for (int row = 0; row < rowCount(); row++) {
+        const QString &msg = data(index(row, 0), role).toString();
+        searchIndex->addEntry(msg, transPinyinToChinese(msg));
+    }
+
+    m_searchIndex = searchIndex;
+}
+
 QString SearchModel::getNormalText(QString value)
 {
     if (m_fontSize == 0) {
@@ -529,19 +533,24 @@ void SearchModel::setLanguage(const QString &type)
         m_bIsChinese = true;
     }
 
-    QFutureWatcher<QList<SearchBoxStruct::Ptr>>* watcher = new QFutureWatcher<QList<SearchBoxStruct::Ptr>>();
-    connect(watcher, &QFutureWatcher<QList<SearchBoxStruct::Ptr>>::finished, this, [=] {
-        m_originList = watcher->result();
+    QFutureWatcher<SearchLoadResult>* watcher = new QFutureWatcher<SearchLoadResult>();
+    connect(watcher, &QFutureWatcher<SearchLoadResult>::finished, this, [=] {
+        const SearchLoadResult &result = watcher->result();
+        m_originList = result.list;
+        m_pinyinMap = result.pinyin;
         watcher->deleteLater();
         loadxml();
         m_dataUpdateCompleted = true;
+        Q_EMIT dataUpdateCompleted();
 
     });
 
     m_childeHideWidgetList.clear();
 
     watcher->setFuture(QtConcurrent::run([=] {
-        QList<SearchBoxStruct::Ptr> list;
+        TraceScope trace("SearchModel::loadSearchIndex");
+        SearchLoadResult result;
+        QList<SearchBoxStruct::Ptr> &list = result.list;
 
         //解决历史遗留问题，适配已经存在的插件搜索数据(不需要翻译,只要第二个字符串不为空即可)
         m_transPlusData = {
@@ -552,119 +561,87 @@ void SearchModel::setLanguage(const QString &type)
 #if DEBUG_XML_SWITCH
         qDebug() << " [SearchWidget] " << Q_FUNC_INFO;
 #endif
+        //翻译文件未变化时直接使用缓存中的解析结果，避免每次启动都解析XML
+        SearchIndexCache cache(m_lang);
+        cache.load();
+
         for (const QString &i : m_xmlFilePath) {
             QString xmlPath = i.arg(m_lang);
-            QFile   file(xmlPath);
+            QFileInfo fileInfo(xmlPath);
 
-            if (!file.exists()) {
+            if (!fileInfo.exists()) {
                 qDebug() << " [SearchWidget] File not exist:" << xmlPath;
                 continue;
             }
 
-            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                qDebug() << " [SearchWidget] File open failed:" << xmlPath;
-                continue;
+            SearchIndexFile indexFile;
+            if (!cache.find(fileInfo, indexFile)) {
+                if (!SearchIndexCache::parseTranslationFile(fileInfo, indexFile)) {
+                    continue;
+                }
+                cache.insert(indexFile);
             }
 
-            QXmlStreamReader            xmlRead(&file);
-            QStringRef                  dataName;
-            SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-            QString xmlExplain;
-
-            //遍历XML文件,读取每一行的xml数据都会
-            //先进入StartElement读取出<>中的内容;
-            //再进入Characters读取出中间数据部分;
-            //最后进入时进入EndElement读取出</>中的内容
-            QString strSource = "";
-            while (!xmlRead.atEnd()) {
-                switch (xmlRead.readNext()) {
-                    case QXmlStreamReader::StartElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] +::StartElement: " << xmlRead.name() << xmlRead.text();
-#endif
-                        xmlExplain = xmlRead.name().toString();
-                        break;
-                    case QXmlStreamReader::Characters:
-                        if (!xmlRead.isWhitespace()) {
-#if DEBUG_XML_SWITCH
-                            qDebug() << " [SearchWidget]  xmlRead.text : " << xmlRead.text().toString();
-#endif
-                            if (xmlExplain == XML_Source) {  // get xml source date
-                                searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-                                searchBoxStrcut->source = xmlRead.text().toString();
-                                strSource = xmlRead.text().toString();
-                            }
-                            else if (xmlExplain == XML_Title) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-#if DEBUG_XML_SWITCH
-                                qDebug() << " [SearchWidget] searchBoxStrcut->translateContent : " << searchBoxStrcut->translateContent;
-#endif
-                            }
-                            else if (xmlExplain == XML_Numerusform) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-                            }
-                            else if (XML_Child_Path == xmlExplain) {
-                                QString childPage = m_transChildPageName.value(xmlRead.text().toString());
-                                if (childPage == "") {
-                                    childPage = xmlRead.text().toString();
-                                    qWarning() << " [SearchWidget]  child page can't translate. childPage : " << childPage;
-                                }
-                                searchBoxStrcut->childPageName = childPage;
-                                if (!m_childWidgetList.contains(childPage))
-                                    m_childWidgetList.append(childPage);
-                            }
-                            else if (XML_ChildHide_Path == xmlExplain) {
-                                //添加二级页面和三级页面都要进入的搜索数据，类似 ： "默认程序 -> 网页 / 添加默认程序" 和 "默认程序 -> 网页"
-                                //以上两种数据都需要搜索，因此需要保存一个特殊的子页面list
-                                QString hideChildPage = m_transChildPageName.value(xmlRead.text().toString());
-                                if (!m_childeHideWidgetList.contains(hideChildPage)) {
-                                    m_childeHideWidgetList.append(hideChildPage);
-                                }
-                            }
-                            else if (xmlExplain == XML_Explain_Path) {
-                                searchBoxStrcut->fullPagePath = xmlRead.text().toString();
-                                // follow path module name to get actual module name  ->  Left module dispaly can support
-                                // mulLanguages
-                                searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
-
-                                if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //判断是否非社区版，如果是非社区版本，屏蔽镜像源列表
-                                if (!IsCommunitySystem) {
-                                    if("Smart Mirror Switch" == strSource
-                                            || "Switch it on to connect to the quickest mirror site automatically" == strSource
-                                            || "System Repository Detection" == strSource
-                                            || "Mirror List" == strSource) {
-                                        searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                        continue;
-                                    }
-                                }
-
-                                list << searchBoxStrcut;
-                                searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                            }
-                        }
-                        break;
-                    case QXmlStreamReader::EndElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] -::EndElement: " << xmlRead.name();
-#endif
-                        break;
-                    default: break;
+            for (const QString &childPageTxt : indexFile.childPages) {
+                QString childPage = m_transChildPageName.value(childPageTxt);
+                if (childPage == "") {
+                    childPage = childPageTxt;
+                    qWarning() << " [SearchWidget]  child page can't translate. childPage : " << childPage;
                 }
+                if (!m_childWidgetList.contains(childPage))
+                    m_childWidgetList.append(childPage);
             }
 
-            qDebug() << " [SearchWidget] m_EnterNewPagelist.count : " << m_EnterNewPagelist.count();
+            //添加二级页面和三级页面都要进入的搜索数据，类似 ： "默认程序 -> 网页 / 添加默认程序" 和 "默认程序 -> 网页"
+            //以上两种数据都需要搜索，因此需要保存一个特殊的子页面list
+            for (const QString &hideChildPageTxt : indexFile.hideChildPages) {
+                QString hideChildPage = m_transChildPageName.value(hideChildPageTxt);
+                if (!m_childeHideWidgetList.contains(hideChildPage)) {
+                    m_childeHideWidgetList.append(hideChildPage);
+                }
+            }
 
-            file.close();
+            for (const SearchIndexEntry &entry : indexFile.entries) {
+                SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
+                searchBoxStrcut->source = entry.source;
+                searchBoxStrcut->translateContent = entry.translateContent;
+                searchBoxStrcut->fullPagePath = entry.fullPagePath;
+                if (!entry.childPage.isEmpty()) {
+                    QString childPage = m_transChildPageName.value(entry.childPage);
+                    searchBoxStrcut->childPageName = childPage == "" ? entry.childPage : childPage;
+                }
+                // follow path module name to get actual module name  ->  Left module dispaly can support
+                // mulLanguages
+                searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
+
+                if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
+                    continue;
+                }
+
+                //判断是否非社区版，如果是非社区版本，屏蔽镜像源列表
+                if (!IsCommunitySystem) {
+                    if("Smart Mirror Switch" == entry.source
+                            || "Switch it on to connect to the quickest mirror site automatically" == entry.source
+                            || "System Repository Detection" == entry.source
+                            || "Mirror List" == entry.source) {
+                        continue;
+                    }
+                }
+
+                if (m_bIsChinese) {
+                    cache.pinyin(searchBoxStrcut->actualModuleName);
+                    cache.pinyin(searchBoxStrcut->childPageName);
+                    cache.pinyin(searchBoxStrcut->translateContent);
+                }
+
+                list << searchBoxStrcut;
+            }
         }
 
-        return list;
+        cache.save();
+        result.pinyin = cache.usedPinyin();
+
+        return result;
     }));
 }
 
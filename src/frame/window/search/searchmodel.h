@@ -5,10 +5,13 @@
 #pragma once
 
 #include "interface/namespace.h"
+#include "searchindex.h"
 
 #include <QStandardItemModel>
 #include <QSet>
+#include <QHash>
 #include <QLabel>
+#include <QSharedPointer>
 
 #include <memory>
 
@@ -24,6 +27,12 @@ struct SearchBoxStruct {
     QString fullPagePath;
 };
 
+// 后台线程加载的搜索数据，拼音已预先计算
+struct SearchLoadResult {
+    QList<SearchBoxStruct::Ptr> list;
+    QHash<QString, QString> pinyin;
+};
+
 struct SearchDataStruct {
     QString chiese;
     QString pinyin;
@@ -64,20 +73,23 @@ public:
     inline bool getDataUpdateCompleted() { return m_dataUpdateCompleted; }
     void addChildPageTrans(const QString &menu, const QString &tran);
     QString getRealTxt(const QString &key) const;
+    inline QSharedPointer<const SearchIndex> searchIndex() const { return m_searchIndex; }
 
 Q_SIGNALS:
     void notifyModuleSearch(QString, QString);
+    void dataUpdateCompleted();
 
 private:
     void loadxml(const QString module = "");
     QString getModulesName(const QString &name, bool state = true);
-    QString removeDigital(QString input);
+    QString getPinyin(const QString &text) const;
     QString transPinyinToChinese(const QString &pinyin);
     QString containTxtData(QString txt);
     void appendChineseData(SearchBoxStruct::Ptr data);
     SearchBoxStruct::Ptr getModuleBtnString(QString value);
     bool specialProcessData(SearchBoxStruct::Ptr data);
     QString getNormalText(QString value);
+    void buildSearchIndex();
 
 private:
     QList<SearchBoxStruct::Ptr> m_originList;
@@ -88,6 +100,9 @@ private:
     QMap<QString, QIcon> m_iconMap;
     QList<QPair<QString, QString>> m_moduleNameList;//用于存储如 "update"和"Update"
     QList<SearchDataStruct> m_inputList;
+    QHash<QString, QString> m_pinyinToChinese; //拼音 -> 汉字，与m_inputList内容一致，用于快速查找
+    QSharedPointer<const SearchIndex> m_searchIndex;
+    QHash<QString, QString> m_pinyinMap; //汉字 -> 拼音，由搜索索引缓存预先计算
     QList<QString> m_childWidgetList; //二级页面list
     QList<QString> m_childeHideWidgetList; //不需要显示的二级页面list，比如 “默认程序 --> 终端 / 添加默认程序” 和 “默认程序 --> 终端”
     QList<QString> m_TxtListAll; //三级页面list
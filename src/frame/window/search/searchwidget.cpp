@@ -85,6 +85,7 @@ SearchWidget::SearchWidget(QWidget *parent)
     m_forbidTextList << "--" << "-" << "-->" << "->" << ">" << "/";
 
     connect(m_model, &SearchModel::notifyModuleSearch, this, &SearchWidget::notifyModuleSearch);
+    connect(m_model, &SearchModel::dataUpdateCompleted, this, &SearchWidget::searchDataReady);
 
     connect(this, &DTK_WIDGET_NAMESPACE::DSearchEdit::textEdited, this, [ = ] {
         //m_bIstextEdited，　true : 用户输入　，　false : 直接调用setText
@@ -310,26 +311,27 @@ void SearchWidget::updateSearchdata(const QString &module, int fontSize)
     m_model->updateSearchData(module, fontSize);
 }
 
-//返回搜索结果
+//返回搜索结果，搜索数据尚未加载完成时返回空列表，不会阻塞等待
 QList<QString> SearchWidget::searchResults(const QString text)
 {
-    QElapsedTimer et;
-    et.start();
-    while (!m_model->getDataUpdateCompleted() && et.elapsed() < 5000) {
-        QThread::msleep(50);
-        QCoreApplication::processEvents();
+    QSharedPointer<const SearchIndex> index = searchIndex();
+    if (!index) {
+        return QList<QString>();
     }
-    QList<QString> lstSearchMsgs;
-    for (int row = 0; row < m_model->rowCount(); row++) {
-        QString msg = m_model->data(m_model->index(row, 0), m_model->m_bIsChinese? Qt::UserRole: Qt::DisplayRole).toString();
-        if(msg.contains(text,Qt::CaseInsensitive))
-            lstSearchMsgs.append(msg);
-    }
-    for (int i = 0; i < lstSearchMsgs.size(); i++) {
-        lstSearchMsgs[i] = m_model->transPinyinToChinese(lstSearchMsgs[i]);
+
+    return index->search(text);
+}
+
+//搜索数据加载完成前返回空指针，加载完成后会发送searchDataReady信号
+QSharedPointer<const SearchIndex> SearchWidget::searchIndex() const
+{
+    if (!m_model->getDataUpdateCompleted()) {
+        return QSharedPointer<const SearchIndex>();
     }
-    return lstSearchMsgs;
+
+    return m_model->searchIndex();
 }
+
 void SearchWidget::addChildPageTrans(const QString &menu, const QString &tran)
 {
     if (!m_model) {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "interface/namespace.h"
+#include "searchindex.h"
 
 #include "dsearchedit.h"
 
@@ -12,6 +13,7 @@
 #include <QLocale>
 #include <QListView>
 #include <QStyledItemDelegate>
+#include <QSharedPointer>
 QT_BEGIN_NAMESPACE
 class QListWidget;
 class QListWidgetItem;
@@ -43,6 +45,7 @@ public:
     void addModulesName(QString moduleName, const QString &searchName, QIcon icon, QString translation = "");
 
     QList<QString> searchResults(const QString text);
+    QSharedPointer<const SearchIndex> searchIndex() const;
     void getJumpPath(QString &moduleName, QString &pageName, const QString &searchName);
     void setModuleVisible(const QString &module, bool visible);
     void setWidgetVisible(const QString &module, const QString &widget, bool visible);
@@ -58,6 +61,7 @@ private Q_SLOTS:
 
 Q_SIGNALS:
     void notifyModuleSearch(QString, QString);
+    void searchDataReady();
 
 private:
     SearchModel *m_model;
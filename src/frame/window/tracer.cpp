@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "tracer.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// 防止长时间运行时事件无限增长
+const int MaxTraceEvents = 20000;
+
+Tracer *Tracer::instance()
+{
+    static Tracer tracer;
+    return &tracer;
+}
+
+Tracer::Tracer()
+{
+    m_events.reserve(512);
+}
+
+// CLOCK_MONOTONIC，单位微秒，便于和其它进程的 trace 对齐
+qint64 Tracer::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void Tracer::addSpan(const QString &name, const QString &module, qint64 beginUs, qint64 endUs)
+{
+    addEvent({name, module, beginUs, endUs - beginUs, static_cast<qint64>(syscall(SYS_gettid))});
+}
+
+void Tracer::addInstant(const QString &name, const QString &module)
+{
+    addEvent({name, module, now(), -1, static_cast<qint64>(syscall(SYS_gettid))});
+}
+
+void Tracer::addEvent(const Event &event)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_events.size() >= MaxTraceEvents)
+        return;
+
+    m_events.append(event);
+}
+
+QByteArray Tracer::toChromeTrace() const
+{
+    const qint64 pid = getpid();
+    QJsonArray traceEvents;
+
+    QMutexLocker locker(&m_mutex);
+    for (const Event &event : m_events) {
+        QJsonObject obj;
+        obj.insert("name", event.name);
+        obj.insert("cat", "dcc");
+        obj.insert("pid", pid);
+        obj.insert("tid", event.threadId);
+        obj.insert("ts", event.beginUs);
+        if (event.durationUs < 0) {
+            obj.insert("ph", "i");
+            obj.insert("s", "t");
+        } else {
+            obj.insert("ph", "X");
+            obj.insert("dur", event.durationUs);
+        }
+        if (!event.module.isEmpty()) {
+            QJsonObject args;
+            args.insert("module", event.module);
+            obj.insert("args", args);
+        }
+        traceEvents.append(obj);
+    }
+    locker.unlock();
+
+    QJsonObject root;
+    root.insert("traceEvents", traceEvents);
+    root.insert("displayTimeUnit", "ms");
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool Tracer::writeTraceFile() const
+{
+    const QString &path = qEnvironmentVariable("DCC_TRACE_FILE");
+    if (path.isEmpty())
+        return false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "open trace file failed:" << path << file.errorString();
+        return false;
+    }
+
+    file.write(toChromeTrace());
+    qInfo() << "startup trace written to" << path;
+    return true;
+}
+
+TraceScope::TraceScope(const QString &name, const QString &module)
+    : m_name(name)
+    , m_module(module)
+    , m_beginUs(Tracer::now())
+{
+}
+
+TraceScope::~TraceScope()
+{
+    Tracer::instance()->addSpan(m_name, m_module, m_beginUs, Tracer::now());
+}
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 启动耗时追踪
+ * 记录带单调时间戳、线程号和模块名称的耗时区间，可导出为 Chrome trace JSON
+ * (chrome://tracing 或 Perfetto 打开)。
+ * 设置环境变量 DCC_TRACE_FILE 后会在首次绘制完成和程序退出时写入该文件，
+ * 也可以通过 DBus 方法 com.deepin.dde.ControlCenter.ExportTrace 获取。
+ */
+class Tracer
+{
+public:
+    static Tracer *instance();
+
+    static qint64 now();
+    void addSpan(const QString &name, const QString &module, qint64 beginUs, qint64 endUs);
+    void addInstant(const QString &name, const QString &module = QString());
+
+    QByteArray toChromeTrace() const;
+    bool writeTraceFile() const;
+
+private:
+    Tracer();
+
+    struct Event {
+        QString name;
+        QString module;
+        qint64 beginUs;
+        qint64 durationUs;      // 小于0表示瞬时事件
+        qint64 threadId;
+    };
+
+    void addEvent(const Event &event);
+
+private:
+    mutable QMutex m_mutex;
+    QVector<Event> m_events;
+};
+
+// 作用域内的耗时区间，析构时记录
+class TraceScope
+{
+public:
+    explicit TraceScope(const QString &name, const QString &module = QString());
+    ~TraceScope();
+
+private:
+    QString m_name;
+    QString m_module;
+    qint64 m_beginUs;
+};
+
+#endif // TRACER_H
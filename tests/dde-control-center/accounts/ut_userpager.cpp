@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/accounts/userpager.h"
+
+#include <gtest/gtest.h>
+
+using namespace dcc::accounts;
+
+class Test_UserPager: public testing::Test
+{
+public:
+    static QStringList userPaths(int count)
+    {
+        QStringList paths;
+        for (int i = 0; i < count; ++i)
+            paths << QString("/com/deepin/daemon/Accounts/User%1").arg(1000 + i);
+
+        return paths;
+    }
+};
+
+TEST_F(Test_UserPager, takePage)
+{
+    UserPager pager(8);
+    const QStringList paths = userPaths(60);
+    pager.setPendingPaths(paths);
+
+    // 第一页之后每次取一页，取完后返回空
+    EXPECT_EQ(pager.takePage(51), paths.mid(0, 51));
+    EXPECT_EQ(pager.pendingCount(), 9);
+    EXPECT_EQ(pager.takePage(20), paths.mid(51));
+    EXPECT_EQ(pager.pendingCount(), 0);
+    EXPECT_TRUE(pager.takePage(20).isEmpty());
+    EXPECT_TRUE(pager.takePage(0).isEmpty());
+}
+
+TEST_F(Test_UserPager, takePath)
+{
+    UserPager pager(8);
+    const QStringList paths = userPaths(5);
+    pager.setPendingPaths(paths);
+
+    // 单独添加的用户不会再出现在之后的页中
+    EXPECT_TRUE(pager.takePath(paths.at(2)));
+    EXPECT_FALSE(pager.takePath(paths.at(2)));
+    EXPECT_EQ(pager.takePage(10), QStringList({ paths.at(0), paths.at(1), paths.at(3), paths.at(4) }));
+}
+
+TEST_F(Test_UserPager, evictLeastRecentlyUsed)
+{
+    UserPager pager(3);
+    const QStringList paths = userPaths(5);
+
+    EXPECT_TRUE(pager.touch(paths.at(0)).isEmpty());
+    EXPECT_TRUE(pager.touch(paths.at(1)).isEmpty());
+    EXPECT_TRUE(pager.touch(paths.at(2)).isEmpty());
+
+    // 再次使用的用户移到最后，淘汰最久未使用的
+    EXPECT_TRUE(pager.touch(paths.at(0)).isEmpty());
+    EXPECT_EQ(pager.touch(paths.at(3)), QStringList({ paths.at(1) }));
+    EXPECT_EQ(pager.touch(paths.at(4)), QStringList({ paths.at(2) }));
+    EXPECT_EQ(pager.recentPaths(), QStringList({ paths.at(0), paths.at(3), paths.at(4) }));
+}
+
+TEST_F(Test_UserPager, activePaths)
+{
+    UserPager pager(2);
+    const QStringList paths = userPaths(1000);
+
+    // 已加载很多用户时，只有可见和最近操作的用户需要刷新
+    pager.setVisiblePaths(paths.mid(100, 10));
+    pager.touch(paths.at(105));
+    pager.touch(paths.at(500));
+
+    QStringList expected = paths.mid(100, 10);
+    expected << paths.at(500);
+    EXPECT_EQ(pager.activePaths(), expected);
+
+    pager.setVisiblePaths(paths.mid(0, 10));
+    EXPECT_EQ(pager.activePaths(), paths.mid(0, 10) + QStringList({ paths.at(105), paths.at(500) }));
+}
+
+TEST_F(Test_UserPager, removePath)
+{
+    UserPager pager(4);
+    const QStringList paths = userPaths(4);
+    pager.setPendingPaths(paths.mid(2));
+    pager.setVisiblePaths(paths.mid(0, 2));
+    pager.touch(paths.at(1));
+
+    pager.removePath(paths.at(1));
+    pager.removePath(paths.at(3));
+
+    EXPECT_EQ(pager.activePaths(), QStringList({ paths.at(0) }));
+    EXPECT_EQ(pager.takePage(10), QStringList({ paths.at(2) }));
+}
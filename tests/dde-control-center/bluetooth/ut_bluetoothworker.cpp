@@ -5,7 +5,9 @@
 #include <gtest/gtest.h>
 #include "../src/frame/modules/bluetooth/bluetoothworker.h"
 
+#include <QElapsedTimer>
 #include <QSignalSpy>
+#include <QTest>
 
 using namespace dcc::bluetooth;
 
@@ -50,6 +52,8 @@ TEST_F(Tst_BluetoothWorker, emitSignal)
 
     device = R"({"Path":"/org/bluez/hci0/dev_A4_50_46_BC_4A_5B","AdapterPath":"/org/bluez/hci0","Alias":"UnitTest","Trusted":false,"Paired":true,"State":0,"ServicesResolved":false,"ConnectState":true,"UUIDs":[],"Name":"UnitTest","Icon":"phone","RSSI":-73,"Address":"A4:50:46:BC:4A:5B"})";
     bluetooth->DevicePropertiesChanged(device);
+    // 属性变化合并到下一帧处理
+    QTest::qWait(50);
     EXPECT_EQ(dev->paired(), true);
 
     QSignalSpy spy1(worker, SIGNAL(pinCodeCancel(const QDBusObjectPath &)));
@@ -103,3 +107,46 @@ TEST_F(Tst_BluetoothWorker, emitSignal)
     bluetooth->AdapterRemoved(adapter);
     EXPECT_LT(model->adapters().count(), old);
 }
+
+// 模拟扫描时大量的属性变化信号，同一设备在一帧内的变化只处理一次
+TEST_F(Tst_BluetoothWorker, devicePropertiesStorm)
+{
+    const QString adapterId = "/org/bluez/hci1";
+    bluetooth->AdapterAdded(QString(R"({"Path":"%1","Name":"Storm","Alias":"Storm","Powered":true,"Discovering":true,"Discoverable":true,"DiscoverableTimeout":0})").arg(adapterId));
+    const Adapter *ada = model->adapterById(adapterId);
+    ASSERT_NE(ada, nullptr);
+
+    const int deviceCount = 200;
+    const int rounds = 20;
+    auto deviceJson = [&](int i, int rssi, bool paired) {
+        return QString(R"({"Path":"%1/dev_%2","AdapterPath":"%1","Alias":"Dev%2","Trusted":false,"Paired":%3,"State":0,"ServicesResolved":false,"ConnectState":false,"UUIDs":[],"Name":"Dev%2","Icon":"phone","RSSI":%4,"Address":"00:00:00:00:00:00"})")
+                .arg(adapterId).arg(i).arg(paired ? "true" : "false").arg(rssi);
+    };
+
+    for (int i = 0; i < deviceCount; ++i)
+        bluetooth->DeviceAdded(deviceJson(i, -70, false));
+    ASSERT_EQ(ada->devices().count(), deviceCount);
+    EXPECT_EQ(model->adapterByDeviceId(adapterId + "/dev_0"), ada);
+
+    int pairedChanges = 0;
+    for (const Device *dev : ada->devices())
+        connect(dev, &Device::pairedChanged, [&pairedChanges] { ++pairedChanges; });
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (int i = 0; i < deviceCount; ++i)
+            bluetooth->DevicePropertiesChanged(deviceJson(i, -70 + round, round % 2 == 0));
+    }
+    const qint64 queueTime = timer.elapsed();
+    QTest::qWait(50);
+    qInfo() << deviceCount * rounds << "DevicePropertiesChanged signals queued in" << queueTime
+            << "ms, applied in" << timer.elapsed() - queueTime << "ms (including wait)";
+
+    // 最后一轮的配对状态为 false，与初始状态相同，合并后不会产生变化
+    EXPECT_EQ(pairedChanges, 0);
+    EXPECT_EQ(model->deviceById(adapterId + "/dev_0")->paired(), false);
+
+    bluetooth->AdapterRemoved(QString(R"({"Path":"%1"})").arg(adapterId));
+    EXPECT_EQ(model->deviceById(adapterId + "/dev_0"), nullptr);
+}
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/window/dbuscallcoalescer.h"
+
+#include <QCoreApplication>
+#include <QDBusMessage>
+#include <QElapsedTimer>
+#include <QList>
+#include <QStringList>
+#include <gtest/gtest.h>
+
+#include <functional>
+
+class Test_DBusCallCoalescer: public testing::Test
+{
+public:
+    // 已完成的调用在回到事件循环后才按返回处理，可以模拟一个还未返回的调用
+    DBusCallCoalescer::Call record(const QString &key, int value)
+    {
+        return [ = ] {
+            m_sent.append(qMakePair(key, value));
+            return QDBusPendingCall::fromCompletedCall(QDBusMessage::createMethodCall("a", "/b", "c", "d").createReply());
+        };
+    }
+
+    void watch(DBusCallCoalescer *coalescer)
+    {
+        QObject::connect(coalescer, &DBusCallCoalescer::finished, [this](const QString &key, const QDBusError &error) {
+            m_finished.append(key);
+            m_errors.append(error.isValid());
+        });
+    }
+
+    static bool waitFor(const std::function<bool()> &condition, int timeout = 1000)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition() && timer.elapsed() < timeout)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+        return condition();
+    }
+
+protected:
+    QList<QPair<QString, int>> m_sent;
+    QStringList m_finished;
+    QList<bool> m_errors;
+};
+
+TEST_F(Test_DBusCallCoalescer, lastValueWins)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+
+    // 模拟拖动滑动条，第一个值立即发出，之后只保留最后一个值
+    for (int i = 0; i <= 100; ++i)
+        coalescer.post("volume", record("volume", i));
+
+    ASSERT_EQ(m_sent.size(), 1);
+    EXPECT_EQ(m_sent.first().second, 0);
+    EXPECT_TRUE(coalescer.isBusy("volume"));
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("volume"); }));
+    ASSERT_EQ(m_sent.size(), 2);
+    EXPECT_EQ(m_sent.last().second, 100);
+    EXPECT_EQ(m_finished, QStringList({ "volume", "volume" }));
+    EXPECT_FALSE(m_errors.contains(true));
+}
+
+TEST_F(Test_DBusCallCoalescer, keysAreIndependent)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+
+    for (int i = 0; i < 10; ++i) {
+        coalescer.post("sink", record("sink", i));
+        coalescer.post("source", record("source", -i));
+    }
+
+    // 每个 key 各自有一个调用在进行
+    ASSERT_EQ(m_sent.size(), 2);
+    EXPECT_EQ(m_sent.at(0), qMakePair(QString("sink"), 0));
+    EXPECT_EQ(m_sent.at(1), qMakePair(QString("source"), 0));
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("sink") && !coalescer.isBusy("source"); }));
+    ASSERT_EQ(m_sent.size(), 4);
+    EXPECT_TRUE(m_sent.contains(qMakePair(QString("sink"), 9)));
+    EXPECT_TRUE(m_sent.contains(qMakePair(QString("source"), -9)));
+    EXPECT_EQ(m_finished.count("sink"), 2);
+    EXPECT_EQ(m_finished.count("source"), 2);
+}
+
+TEST_F(Test_DBusCallCoalescer, cancelDropsWaitingCall)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+
+    coalescer.post("brightness", record("brightness", 1));
+    coalescer.post("brightness", record("brightness", 2));
+    coalescer.cancel("brightness");
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("brightness"); }));
+    ASSERT_EQ(m_sent.size(), 1);
+    EXPECT_EQ(m_sent.first().second, 1);
+    EXPECT_EQ(m_finished, QStringList({ "brightness" }));
+}
+
+TEST_F(Test_DBusCallCoalescer, minimumInterval)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+    coalescer.setMinimumInterval(100);
+
+    QElapsedTimer timer;
+    timer.start();
+    coalescer.post("speed", record("speed", 1));
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("speed"); }));
+
+    // 上一次调用已经返回，但还没到最小间隔，等间隔到了再发出
+    coalescer.post("speed", record("speed", 2));
+    coalescer.post("speed", record("speed", 3));
+    EXPECT_EQ(m_sent.size(), 1);
+
+    ASSERT_TRUE(waitFor([&] { return m_sent.size() == 2; }));
+    EXPECT_GE(timer.elapsed(), 100);
+    EXPECT_EQ(m_sent.last().second, 3);
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("speed"); }));
+    EXPECT_EQ(m_sent.size(), 2);
+    EXPECT_EQ(m_finished.count("speed"), 2);
+}
+
+// 空调用不会有返回，不能一直占用该 key
+TEST_F(Test_DBusCallCoalescer, nullCallDoesNotBlockKey)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+
+    coalescer.post("volume", [] { return QDBusPendingCall::fromCompletedCall(QDBusMessage()); });
+    coalescer.post("volume", record("volume", 1));
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("volume"); }));
+    ASSERT_EQ(m_sent.size(), 1);
+    EXPECT_EQ(m_sent.first().second, 1);
+    ASSERT_EQ(m_errors.size(), 2);
+    EXPECT_TRUE(m_errors.first());
+    EXPECT_FALSE(m_errors.last());
+}
+
+// 设备移除后等待中的请求被丢弃，之后同一个 key 的请求正常发出
+TEST_F(Test_DBusCallCoalescer, destroyedContextSkipsCall)
+{
+    DBusCallCoalescer coalescer;
+    watch(&coalescer);
+    QObject *sink = new QObject;
+
+    coalescer.post("volume", record("volume", 1), sink);
+    coalescer.post("volume", record("volume", 2), sink);
+    delete sink;
+
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("volume"); }));
+    ASSERT_EQ(m_sent.size(), 1);
+    EXPECT_EQ(m_finished, QStringList({ "volume" }));
+
+    coalescer.post("volume", record("volume", 3));
+    ASSERT_TRUE(waitFor([&] { return !coalescer.isBusy("volume"); }));
+    ASSERT_EQ(m_sent.size(), 2);
+    EXPECT_EQ(m_sent.last().second, 3);
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/display/displaymodel.h"
+
+#include <gtest/gtest.h>
+
+using namespace dcc::display;
+
+typedef QMap<QString, double> ScaleMap;
+
+class Test_DisplayModel: public testing::Test
+{
+public:
+    virtual void SetUp() override;
+
+    virtual void TearDown() override;
+
+    // 模拟 DisplayWorker 的调用，这些接口都是 model 的私有槽
+    Monitor *createMonitor(const QString &name);
+    void setScreenScales(const ScaleMap &scales);
+    void monitorsAdded(const QList<Monitor *> &monitors);
+
+public:
+    DisplayModel *m_model = nullptr;
+};
+
+void Test_DisplayModel::SetUp()
+{
+    m_model = new DisplayModel();
+}
+
+void Test_DisplayModel::TearDown()
+{
+    delete m_model;
+    m_model = nullptr;
+}
+
+Monitor *Test_DisplayModel::createMonitor(const QString &name)
+{
+    Monitor *mon = new Monitor(m_model);
+    QMetaObject::invokeMethod(mon, "setName", Qt::DirectConnection, Q_ARG(QString, name));
+    return mon;
+}
+
+void Test_DisplayModel::setScreenScales(const ScaleMap &scales)
+{
+    QMetaObject::invokeMethod(m_model, "setScreenScales", Qt::DirectConnection, QArgument<ScaleMap>("QMap<QString,double>", scales));
+}
+
+void Test_DisplayModel::monitorsAdded(const QList<Monitor *> &monitors)
+{
+    QMetaObject::invokeMethod(m_model, "monitorsAdded", Qt::DirectConnection, Q_ARG(QList<Monitor *>, monitors));
+}
+
+TEST_F(Test_DisplayModel, screenScalesBeforeMonitors)
+{
+    // 异步加载显示器时，GetScreenScaleFactors 的返回先于显示器到达
+    setScreenScales({ { "HDMI-1", 1.5 }, { "eDP-1", 2.0 } });
+
+    Monitor *hdmi = createMonitor("HDMI-1");
+    Monitor *edp = createMonitor("eDP-1");
+    Monitor *vga = createMonitor("VGA-1");
+    monitorsAdded({ hdmi, edp, vga });
+
+    EXPECT_DOUBLE_EQ(hdmi->scale(), 1.5);
+    EXPECT_DOUBLE_EQ(edp->scale(), 2.0);
+    // 没有单独设置的显示器使用全局缩放
+    EXPECT_DOUBLE_EQ(m_model->monitorScale(vga), m_model->uiScale());
+}
+
+TEST_F(Test_DisplayModel, screenScalesAfterMonitors)
+{
+    Monitor *hdmi = createMonitor("HDMI-1");
+    monitorsAdded({ hdmi });
+
+    setScreenScales({ { "HDMI-1", 1.25 } });
+    EXPECT_DOUBLE_EQ(hdmi->scale(), 1.25);
+
+    // 小于 1 的值表示跟随全局缩放
+    setScreenScales({ { "HDMI-1", 0.0 } });
+    EXPECT_DOUBLE_EQ(hdmi->scale(), m_model->uiScale());
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/display/monitor.h"
+
+#include <gtest/gtest.h>
+
+using namespace dcc::display;
+
+// 界面上以 4 位有效数字显示刷新率，显示相同的刷新率必须得到同一个键
+TEST(Test_Monitor, rateKeyMatchesDisplayedRate)
+{
+    EXPECT_EQ(Monitor::rateKey(59.950), Monitor::rateKey(59.951));
+    EXPECT_EQ(Monitor::rateKey(59.9502), Monitor::rateKey(59.9499));
+    EXPECT_EQ(Monitor::rateKey(143.856), Monitor::rateKey(143.9));
+    EXPECT_EQ(Monitor::rateKey(60.0), 60000);
+
+    EXPECT_NE(Monitor::rateKey(59.94), Monitor::rateKey(59.95));
+    EXPECT_NE(Monitor::rateKey(60.0), Monitor::rateKey(59.95));
+    EXPECT_NE(Monitor::rateKey(74.97), Monitor::rateKey(75.0));
+}
+
+TEST(Test_Monitor, rateKeyAgreesWithText)
+{
+    const QList<double> rates { 23.976, 29.97, 50.0, 59.934, 59.95, 59.951, 60.0, 74.973, 119.88, 143.856, 144.0, 164.999, 240.0 };
+    for (double a : rates) {
+        for (double b : rates) {
+            const bool sameText = QString::number(a, 'g', 4) == QString::number(b, 'g', 4);
+            EXPECT_EQ(sameText, Monitor::rateKey(a) == Monitor::rateKey(b)) << a << " " << b;
+        }
+    }
+}
@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/display/monitorlayoutsolver.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace dcc::display;
+
+// 最多 16 个屏幕的拼接墙
+const int MaxOutputs = 16;
+
+class Test_MonitorLayoutSolver: public testing::Test
+{
+public:
+    // rows * cols 的拼接墙，按行排列
+    static QVector<QRectF> tiledWall(int rows, int cols, qreal w = 1920, qreal h = 1080);
+    // 每个块随机贴到已有块的一条边上，块之间可能重叠
+    static QVector<QRectF> randomLayout(QRandomGenerator &random, int count);
+    // 逐个比较的连通状态，作为区间索引结果的参照
+    static QVector<QVector<int>> bruteForceConnected(const QVector<QRectF> &rects);
+    static QVector<QVector<int>> sortedConnected(const MonitorLayoutSolver &solver);
+};
+
+QVector<QRectF> Test_MonitorLayoutSolver::tiledWall(int rows, int cols, qreal w, qreal h)
+{
+    QVector<QRectF> rects;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c)
+            rects.append(QRectF(c * w, r * h, w, h));
+    }
+
+    return rects;
+}
+
+QVector<QRectF> Test_MonitorLayoutSolver::randomLayout(QRandomGenerator &random, int count)
+{
+    const QVector<QPointF> sizes { QPointF(1920, 1080), QPointF(1280, 1024), QPointF(1080, 1920), QPointF(2560, 1440) };
+
+    QVector<QRectF> rects;
+    for (int i = 0; i < count; ++i) {
+        const QPointF &size = sizes.at(random.bounded(sizes.size()));
+        if (rects.isEmpty()) {
+            rects.append(QRectF(0, 0, size.x(), size.y()));
+            continue;
+        }
+
+        const QRectF &base = rects.at(random.bounded(rects.size()));
+        const qreal offset = random.bounded(-10, 11) * 100;
+        switch (random.bounded(4)) {
+        case 0:
+            rects.append(QRectF(base.right(), base.top() + offset, size.x(), size.y()));
+            break;
+        case 1:
+            rects.append(QRectF(base.left() - size.x(), base.top() + offset, size.x(), size.y()));
+            break;
+        case 2:
+            rects.append(QRectF(base.left() + offset, base.bottom(), size.x(), size.y()));
+            break;
+        default:
+            rects.append(QRectF(base.left() + offset, base.top() - size.y(), size.x(), size.y()));
+            break;
+        }
+    }
+
+    return rects;
+}
+
+QVector<QVector<int>> Test_MonitorLayoutSolver::bruteForceConnected(const QVector<QRectF> &rects)
+{
+    QVector<QVector<int>> connected(rects.size());
+    for (int i = 0; i < rects.size(); ++i) {
+        const QRectF &rectEx = rects.at(i).adjusted(-0.05, -0.05, 0.05, 0.05);
+        const QRectF &rectIntersect = rects.at(i).adjusted(1, 1, -1, -1);
+        for (int j = 0; j < rects.size(); ++j) {
+            if (j != i && rectEx.intersects(rects.at(j)) && !rectIntersect.intersects(rects.at(j)))
+                connected[i].append(j);
+        }
+    }
+
+    return connected;
+}
+
+QVector<QVector<int>> Test_MonitorLayoutSolver::sortedConnected(const MonitorLayoutSolver &solver)
+{
+    QVector<QVector<int>> connected = solver.connectedState();
+    for (auto &list : connected)
+        std::sort(list.begin(), list.end());
+
+    return connected;
+}
+
+TEST_F(Test_MonitorLayoutSolver, tiledWall)
+{
+    for (int rows = 1; rows <= 4; ++rows) {
+        for (int cols = 1; cols <= 4; ++cols) {
+            MonitorLayoutSolver solver;
+            solver.setRects(tiledWall(rows, cols));
+
+            EXPECT_FALSE(solver.updateConnectedState());
+            EXPECT_TRUE(solver.isFullyConnected());
+            EXPECT_EQ(solver.boundingRect(), QRectF(0, 0, cols * 1920, rows * 1080));
+        }
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, connectedStateMatchesBruteForce)
+{
+    QRandomGenerator random(20220801);
+    for (int round = 0; round < 200; ++round) {
+        const QVector<QRectF> &rects = randomLayout(random, random.bounded(1, MaxOutputs + 1));
+
+        MonitorLayoutSolver solver;
+        solver.setRects(rects);
+        solver.updateConnectedState();
+
+        const QVector<QVector<int>> &connected = sortedConnected(solver);
+        ASSERT_EQ(connected, bruteForceConnected(rects));
+
+        // 相接关系是对称的
+        for (int i = 0; i < connected.size(); ++i) {
+            for (int j : connected.at(i))
+                EXPECT_TRUE(connected.at(j).contains(i));
+        }
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, incrementalIndex)
+{
+    QRandomGenerator random(1050);
+    MonitorLayoutSolver solver;
+    solver.setRects(randomLayout(random, MaxOutputs));
+    solver.updateConnectedState();
+
+    // 拖动时只更新移动块，结果需要和重新建立索引一致
+    for (int step = 0; step < 500; ++step) {
+        const int index = random.bounded(MaxOutputs);
+        solver.moveBy(index, QPointF(random.bounded(-20, 21) * 50, random.bounded(-20, 21) * 50));
+        solver.updateConnectedState();
+
+        MonitorLayoutSolver fresh;
+        fresh.setRects(solver.rects());
+        fresh.updateConnectedState();
+
+        ASSERT_EQ(sortedConnected(solver), bruteForceConnected(solver.rects()));
+        ASSERT_EQ(solver.adsorption(index), fresh.adsorption(index));
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, adsorptionSnapsDetachedTile)
+{
+    QRandomGenerator random(5401);
+    for (int rows = 1; rows <= 4; ++rows) {
+        for (int cols = 2; cols <= 4; ++cols) {
+            const QVector<QRectF> &wall = tiledWall(rows, cols);
+            const qreal d = random.bounded(1, 150);
+
+            // 最右一列的块向右拖开，吸附回原来的位置
+            for (int r = 0; r < rows; ++r) {
+                const int index = r * cols + cols - 1;
+                MonitorLayoutSolver solver;
+                solver.setRects(wall);
+                solver.moveBy(index, QPointF(d, 0));
+                EXPECT_EQ(solver.adsorption(index), QPointF(-d, 0)) << rows << cols << r;
+            }
+
+            // 最下一行的块向下拖开
+            for (int c = 0; c < cols && rows > 1; ++c) {
+                const int index = (rows - 1) * cols + c;
+                MonitorLayoutSolver solver;
+                solver.setRects(wall);
+                solver.moveBy(index, QPointF(0, d));
+                EXPECT_EQ(solver.adsorption(index), QPointF(0, -d)) << rows << cols << c;
+            }
+        }
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, adsorptionIgnoresOverlapAndFarTiles)
+{
+    MonitorLayoutSolver solver;
+    solver.setRects(tiledWall(2, 2));
+
+    // 与其他块重叠时不吸附
+    solver.moveBy(1, QPointF(-300, 0));
+    EXPECT_EQ(solver.adsorption(1), QPointF(0, 0));
+
+    // 超出吸附区域的块不吸附
+    solver.moveBy(1, QPointF(800, 0));
+    EXPECT_EQ(solver.adsorption(1), QPointF(0, 0));
+}
+
+TEST_F(Test_MonitorLayoutSolver, adsorptionAlignsTileSharingEdge)
+{
+    MonitorLayoutSolver solver;
+    solver.setRects(tiledWall(1, 2));
+
+    // 沿右边相接的边拖动，只有边相接不算重叠，上下边对齐
+    solver.moveBy(1, QPointF(0, 50));
+    EXPECT_EQ(solver.adsorption(1), QPointF(0, -50));
+
+    solver.moveBy(1, QPointF(0, -120));
+    EXPECT_EQ(solver.adsorption(1), QPointF(0, 70));
+
+    // 只有角相接时不在任何吸附区域内
+    solver.setRect(1, QRectF(1920, 1080, 1920, 1080));
+    EXPECT_EQ(solver.adsorption(1), QPointF(0, 0));
+}
+
+TEST_F(Test_MonitorLayoutSolver, translationInvariance)
+{
+    QRandomGenerator random(20221017);
+    for (int round = 0; round < 200; ++round) {
+        const QVector<QRectF> &rects = randomLayout(random, random.bounded(2, MaxOutputs + 1));
+        const QPointF shift(random.bounded(-50, 51) * 100, random.bounded(-50, 51) * 100);
+        const int moving = random.bounded(rects.size());
+
+        QVector<QRectF> shifted;
+        for (const QRectF &rect : rects)
+            shifted.append(rect.translated(shift));
+
+        MonitorLayoutSolver solver, shiftedSolver;
+        solver.setRects(rects);
+        shiftedSolver.setRects(shifted);
+
+        EXPECT_EQ(solver.adsorption(moving), shiftedSolver.adsorption(moving));
+
+        const MonitorLayoutSolver::SortResult &result = solver.sortAlgo(moving);
+        const MonitorLayoutSolver::SortResult &shiftedResult = shiftedSolver.sortAlgo(moving);
+        EXPECT_EQ(result.shelter, shiftedResult.shelter);
+        EXPECT_EQ(result.offset, shiftedResult.offset);
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, sortAlgoShelter)
+{
+    MonitorLayoutSolver solver;
+    solver.setRects({ QRectF(0, 0, 1920, 1080), QRectF(100, 100, 1280, 720) });
+
+    // 完全覆盖其他块时需要回弹
+    EXPECT_TRUE(solver.sortAlgo(0).shelter);
+    EXPECT_TRUE(solver.sortAlgo(1).shelter);
+}
+
+TEST_F(Test_MonitorLayoutSolver, autoAdjustReattachesDetachedTile)
+{
+    QRandomGenerator random(1920);
+    for (int rows = 1; rows <= 4; ++rows) {
+        for (int cols = 2; cols <= 4; ++cols) {
+            const QVector<QRectF> &wall = tiledWall(rows, cols);
+            const int index = random.bounded(rows) * cols + cols - 1;
+            // 拖开的距离大于屏幕宽度，与同一列的块也不再相接
+            const qreal d = random.bounded(2000, 4000);
+
+            MonitorLayoutSolver solver;
+            solver.setRects(wall);
+            solver.moveBy(index, QPointF(d, 0));
+            solver.updateConnectedState();
+            ASSERT_FALSE(solver.isFullyConnected());
+
+            EXPECT_TRUE(solver.autoAdjust(0));
+            EXPECT_TRUE(solver.isFullyConnected());
+            EXPECT_FALSE(solver.hasOverlap());
+            EXPECT_EQ(solver.rects().at(index), wall.at(index));
+        }
+    }
+}
+
+TEST_F(Test_MonitorLayoutSolver, benchmark)
+{
+    MonitorLayoutSolver solver;
+    solver.setRects(tiledWall(4, 4));
+    solver.updateConnectedState();
+
+    // 模拟在 4x4 拼接墙边缘拖动一个块，每一步都做自动吸附
+    const int steps = 20000;
+    const int moving = MaxOutputs - 1;
+    solver.moveBy(moving, QPointF(100, 0));
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < steps; ++i) {
+        solver.moveBy(moving, QPointF(0, (i / 100) % 2 ? -10 : 10));
+        solver.adsorption(moving);
+    }
+    const qint64 dragNsecs = timer.nsecsElapsed();
+
+    // 松开后的拼接和连通状态计算
+    timer.start();
+    for (int i = 0; i < steps; ++i) {
+        solver.sortAlgo(moving);
+        solver.updateConnectedState();
+    }
+    const qint64 releaseNsecs = timer.nsecsElapsed();
+
+    qInfo() << "monitor layout solver," << MaxOutputs << "outputs:"
+            << "adsorption" << dragNsecs / steps << "ns,"
+            << "sort and connected state" << releaseNsecs / steps << "ns";
+
+    // 每次鼠标移动的计算量需要远小于一帧
+    EXPECT_LT(dragNsecs / steps, 1000000);
+    EXPECT_LT(releaseNsecs / steps, 1000000);
+}
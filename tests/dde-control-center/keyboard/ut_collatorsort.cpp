@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "window/collatorsort.h"
+#include "indexmodel.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include "gtest/gtest.h"
+
+using namespace dcc::keyboard;
+
+class Tst_CollatorSort : public testing::Test
+{
+public:
+    // 模拟安装了大量字体时的字体名称
+    static QList<MetaData> fontNames(int count)
+    {
+        static const QStringList families = { "Noto Sans", "noto serif", "Source Han Sans", "文泉驿微米黑", "Unifont",
+                                              "DejaVu Sans Mono", "Ubuntu", "思源黑体", "Liberation Serif", "Z003" };
+        QList<MetaData> list;
+        list.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            MetaData md;
+            md.setText(QString("%1 %2").arg(families.at((i * 7) % families.size())).arg((i * 7919) % count));
+            list.append(md);
+        }
+
+        return list;
+    }
+};
+
+TEST_F(Tst_CollatorSort, sameOrderAsCompare)
+{
+    QList<MetaData> list = fontNames(500);
+    QList<MetaData> expected = list;
+
+    QCollator collator;
+    std::stable_sort(expected.begin(), expected.end(), [&collator](const MetaData &md1, const MetaData &md2) {
+        return collator.compare(md1.text(), md2.text()) < 0;
+    });
+
+    collatorSort(list, [](const MetaData &md) { return md.text(); });
+
+    ASSERT_EQ(list.size(), expected.size());
+    for (int i = 0; i < list.size(); ++i)
+        EXPECT_EQ(list.at(i).text(), expected.at(i).text());
+}
+
+TEST_F(Tst_CollatorSort, stable)
+{
+    QList<MetaData> list;
+    for (const QString &key : { "b", "a", "c" }) {
+        MetaData md("same");
+        md.setKey(key);
+        list.append(md);
+    }
+
+    collatorSort(list, [](const MetaData &md) { return md.text(); });
+    EXPECT_EQ(list.at(0).key(), QString("b"));
+    EXPECT_EQ(list.at(1).key(), QString("a"));
+    EXPECT_EQ(list.at(2).key(), QString("c"));
+}
+
+// 与每次比较都创建 QCollator 的写法对比耗时，只输出结果，不作为失败条件
+TEST_F(Tst_CollatorSort, benchmark)
+{
+    const QList<MetaData> source = fontNames(5000);
+    QElapsedTimer timer;
+
+    QList<MetaData> perCompare = source;
+    timer.start();
+    std::sort(perCompare.begin(), perCompare.end(), [](const MetaData &md1, const MetaData &md2) {
+        QCollator qc;
+        return qc.compare(md1.text(), md2.text()) < 0;
+    });
+    const qint64 perCompareTime = timer.elapsed();
+
+    QList<MetaData> sortKeys = source;
+    timer.restart();
+    collatorSort(sortKeys, [](const MetaData &md) { return md.text(); });
+    const qint64 sortKeyTime = timer.elapsed();
+
+    qInfo() << "sort" << source.size() << "items, QCollator per compare:" << perCompareTime
+            << "ms, QCollatorSortKey:" << sortKeyTime << "ms";
+
+    ASSERT_EQ(sortKeys.size(), perCompare.size());
+    for (int i = 0; i < sortKeys.size(); ++i)
+        EXPECT_EQ(QCollator().compare(sortKeys.at(i).text(), perCompare.at(i).text()), 0);
+}
@@ -73,3 +73,34 @@ TEST_F(Tst_IndexModel, metaData)
     EXPECT_EQ(3, model->getModelCount());
     EXPECT_EQ(1, model->indexOf(lmd[1]));
 }
+
+TEST_F(Tst_IndexModel, buildLayoutIndex)
+{
+    const QMap<QString, QString> layouts {
+        { "cn", "汉语" },
+        { "de", "德语" },
+        { "fr", "French" },
+        { "us", "英语(美国)" },
+        { "ru", "俄语" },
+    };
+
+    EXPECT_EQ(IndexModel::layoutPinyin("汉语"), "hanyu");
+    EXPECT_EQ(IndexModel::layoutPinyin("French"), "French");
+
+    // 按拼音排序并插入首字母分组
+    const MetaDataIndex &index = IndexModel::buildLayoutIndex(layouts, true);
+    EXPECT_EQ(index.letters, QList<QString>({ "D", "E", "F", "H", "Y" }));
+
+    QStringList texts;
+    for (const MetaData &md : index.datas)
+        texts << (md.section() ? "[" + md.text() + "]" : md.key());
+    EXPECT_EQ(texts, QStringList({ "[D]", "de", "[E]", "ru", "[F]", "fr", "[H]", "cn", "[Y]", "us" }));
+
+    // 不分组时按名称排序
+    const MetaDataIndex &plain = IndexModel::buildLayoutIndex({ { "de", "German" }, { "us", "English (US)" }, { "ar", "Arabic" } }, false);
+    EXPECT_TRUE(plain.letters.isEmpty());
+    ASSERT_EQ(plain.datas.size(), 3);
+    EXPECT_EQ(plain.datas.at(0).key(), "ar");
+    EXPECT_EQ(plain.datas.at(1).key(), "us");
+    EXPECT_EQ(plain.datas.at(2).key(), "de");
+}
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchfiltermodel.h"
+
+#include <QSignalSpy>
+#include <QStandardItemModel>
+
+#include "gtest/gtest.h"
+
+using namespace dcc::keyboard;
+
+class Tst_SearchFilterModel : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    QStringList rows() const;
+
+    QStandardItemModel *source = nullptr;
+    SearchFilterModel *model = nullptr;
+};
+
+void Tst_SearchFilterModel::SetUp()
+{
+    source = new QStandardItemModel();
+    for (const QString &text : { "English (US)", "English (UK)", "German", "Greek", "Chinese" })
+        source->appendRow(new QStandardItem(text));
+
+    model = new SearchFilterModel();
+    model->setSourceModel(source);
+}
+
+void Tst_SearchFilterModel::TearDown()
+{
+    delete model;
+    model = nullptr;
+    delete source;
+    source = nullptr;
+}
+
+QStringList Tst_SearchFilterModel::rows() const
+{
+    QStringList list;
+    for (int i = 0; i < model->rowCount(); ++i)
+        list << model->index(i, 0).data().toString();
+
+    return list;
+}
+
+TEST_F(Tst_SearchFilterModel, filter)
+{
+    EXPECT_EQ(model->rowCount(), 5);
+
+    model->setFilterText("E");
+    EXPECT_EQ(rows(), QStringList({ "English (US)", "English (UK)", "German", "Greek", "Chinese" }));
+
+    // 继续输入时在上一次的结果中查找
+    model->setFilterText("En");
+    EXPECT_EQ(rows(), QStringList({ "English (US)", "English (UK)" }));
+    model->setFilterText("Eng");
+    EXPECT_EQ(rows(), QStringList({ "English (US)", "English (UK)" }));
+    model->setFilterText("engl (");
+    EXPECT_TRUE(rows().isEmpty());
+
+    // 删除字符后重新查找
+    model->setFilterText("g");
+    EXPECT_EQ(rows(), QStringList({ "English (US)", "English (UK)", "German", "Greek" }));
+
+    model->setFilterText(QString());
+    EXPECT_EQ(model->rowCount(), 5);
+}
+
+TEST_F(Tst_SearchFilterModel, mapping)
+{
+    model->setFilterText("gre");
+    ASSERT_EQ(model->rowCount(), 1);
+
+    const QModelIndex &sourceIndex = model->mapToSource(model->index(0, 0));
+    EXPECT_EQ(sourceIndex, source->index(3, 0));
+    EXPECT_EQ(model->mapFromSource(sourceIndex), model->index(0, 0));
+    EXPECT_FALSE(model->mapFromSource(source->index(0, 0)).isValid());
+}
+
+TEST_F(Tst_SearchFilterModel, keyFunction)
+{
+    // 分组标题不参与搜索，拼音可以匹配
+    source->clear();
+    source->appendRow(new QStandardItem("Z"));
+    QStandardItem *item = new QStandardItem("中文");
+    item->setData("zhongwen", Qt::UserRole);
+    source->appendRow(item);
+
+    model->setKeyFunction([](const QModelIndex &index) -> QString {
+        if (index.data(Qt::UserRole).toString().isEmpty())
+            return QString();
+
+        return index.data().toString() + '\n' + index.data(Qt::UserRole).toString();
+    });
+
+    model->setFilterText("Z");
+    EXPECT_EQ(rows(), QStringList({ "中文" }));
+    model->setFilterText("中");
+    EXPECT_EQ(rows(), QStringList({ "中文" }));
+}
+
+TEST_F(Tst_SearchFilterModel, sourceChanged)
+{
+    model->setFilterText("ch");
+    ASSERT_EQ(rows(), QStringList({ "Chinese" }));
+
+    QSignalSpy resetSpy(model, &SearchFilterModel::modelReset);
+    source->appendRow(new QStandardItem("Czech"));
+    EXPECT_EQ(resetSpy.count(), 1);
+    EXPECT_EQ(rows(), QStringList({ "Chinese", "Czech" }));
+
+    // 不影响匹配结果的修改只转发 dataChanged
+    QSignalSpy dataSpy(model, &SearchFilterModel::dataChanged);
+    source->item(4)->setCheckState(Qt::Checked);
+    EXPECT_EQ(resetSpy.count(), 1);
+    EXPECT_EQ(dataSpy.count(), 1);
+
+    // 修改后不再匹配时重新过滤
+    source->item(4)->setText("French");
+    EXPECT_EQ(rows(), QStringList({ "Czech" }));
+}
@@ -44,3 +44,33 @@ TEST_F(Tst_ShortcutModel, KeyLabel)
     EXPECT_NO_THROW(model->delInfo((model->customInfo()).first()));
     EXPECT_NO_THROW(model->delInfo((model->infos()).first()));
 }
+
+TEST_F(Tst_ShortcutModel, ConflictIndex)
+{
+    model->onParseInfo("[{\"Id\":\"terminal\",\"Type\":0,\"Accels\":[\"<Control><Alt>T\"],\"Name\":\"terminal\"},"
+                       "{\"Id\":\"close\",\"Type\":2,\"Accels\":[\"XF86Close\"],\"Name\":\"Close\"},"
+                       "{\"Id\":\"close\",\"Type\":3,\"Accels\":[\"<Alt>F4\"],\"Name\":\"close\"},"
+                       "{\"Id\":\"away\",\"Type\":2,\"Accels\":[],\"Name\":\"Away\"}]");
+
+    ShortcutInfo *terminal = model->getInfo("<control><alt>t");
+    ASSERT_TRUE(terminal);
+    EXPECT_EQ(terminal->id, QString("terminal"));
+    EXPECT_FALSE(model->getInfo(""));
+
+    // 按 id 和类型更新，不会改到同名的媒体键
+    model->onKeyBindingChanged("{\"Id\":\"close\",\"Type\":3,\"Accels\":[\"<Super>Q\"],\"Name\":\"close\"}");
+    EXPECT_FALSE(model->getInfo("<Alt>F4"));
+    ASSERT_TRUE(model->getInfo("<Super>Q"));
+    EXPECT_EQ(model->getInfo("<Super>Q")->type, 3);
+    EXPECT_EQ(model->getInfo("XF86Close")->type, 2);
+
+    model->setAccels(terminal, "<Control><Alt>X");
+    EXPECT_FALSE(model->getInfo("<Control><Alt>T"));
+    EXPECT_EQ(model->getInfo("<Control><Alt>X"), terminal);
+
+    model->onCustomInfo("{\"Id\":\"printer\",\"Type\":1,\"Accels\":[\"<Control>P\"],\"Name\":\"printer\",\"Exec\":\"dde-printer\"}");
+    ShortcutInfo *printer = model->getInfo("<Control>P");
+    ASSERT_TRUE(printer);
+    model->delInfo(printer);
+    EXPECT_FALSE(model->getInfo("<Control>P"));
+}
@@ -3,6 +3,11 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "../src/frame/modules/notification/notificationworker.h"
+#include "../src/frame/modules/notification/model/appitemmodel.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSignalSpy>
 
 #include <gtest/gtest.h>
 
@@ -61,3 +66,35 @@ TEST_F(Tst_NotificationWorker, FullTest)
     worker.setSystemSetting(0, false);
     worker.deactive();
 }
+
+TEST_F(Tst_NotificationWorker, LoadApps)
+{
+    NotificationModel model;
+    NotificationWorker worker(&model);
+    QSignalSpy spy(&model, &NotificationModel::appListChanged);
+    worker.initAppSetting();
+
+    QElapsedTimer timer;
+    timer.start();
+    while (model.getAppSize() == 0 && timer.elapsed() < 3000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+    // 所有应用一次性添加，列表只刷新一次
+    const QStringList &apps = worker.getDbusObject()->GetAppList();
+    ASSERT_EQ(model.getAppSize(), apps.size());
+    EXPECT_EQ(spy.count(), 1);
+
+    AppItemModel *code = model.getAppModel(QString("code"));
+    ASSERT_TRUE(code);
+    EXPECT_EQ(code->getAppName(), QString("控制中心"));
+    EXPECT_TRUE(code->isAllowNotify());
+
+    // AppInfoChanged 只转发给对应的应用
+    worker.getDbusObject()->AppInfoChanged("code", AppItemModel::ENABELNOTIFICATION, QDBusVariant(false));
+    EXPECT_FALSE(code->isAllowNotify());
+    EXPECT_TRUE(model.getAppModel(QString("vim"))->isAllowNotify());
+
+    model.appRemoved("code");
+    EXPECT_FALSE(model.getAppModel(QString("code")));
+    EXPECT_EQ(model.getAppSize(), apps.size() - 1);
+}
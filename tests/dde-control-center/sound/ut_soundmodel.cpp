@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/sound/soundmodel.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <gtest/gtest.h>
+
+using namespace dcc::sound;
+
+class Test_SoundModel: public testing::Test
+{
+public:
+    virtual void SetUp() override;
+
+    virtual void TearDown() override;
+
+    static QJsonObject port(const QString &name, int direction, const QString &description = QString(), double available = 2.0);
+    static QJsonObject card(uint id, const QJsonArray &ports);
+    static QString cards(const QJsonArray &cards);
+
+    // 按声卡 id 和端口 id 判断当前端口
+    void update(const QString &cards);
+
+public:
+    SoundModel *m_model = nullptr;
+    QPair<uint, QString> m_activePort;
+    int m_added = 0;
+    int m_removed = 0;
+};
+
+void Test_SoundModel::SetUp()
+{
+    m_model = new SoundModel();
+    QObject::connect(m_model, &SoundModel::portAdded, m_model, [this] { ++m_added; });
+    QObject::connect(m_model, &SoundModel::portRemoved, m_model, [this] { ++m_removed; });
+}
+
+void Test_SoundModel::TearDown()
+{
+    delete m_model;
+    m_model = nullptr;
+}
+
+QJsonObject Test_SoundModel::port(const QString &name, int direction, const QString &description, double available)
+{
+    return QJsonObject {
+        { "Name", name },
+        { "Description", description.isEmpty() ? name : description },
+        { "Direction", direction },
+        { "Available", available },
+        { "Enabled", true },
+        { "Bluetooth", false },
+    };
+}
+
+QJsonObject Test_SoundModel::card(uint id, const QJsonArray &ports)
+{
+    return QJsonObject {
+        { "Id", int(id) },
+        { "Name", QString("card%1").arg(id) },
+        { "Ports", ports },
+    };
+}
+
+QString Test_SoundModel::cards(const QJsonArray &cards)
+{
+    return QString::fromUtf8(QJsonDocument(cards).toJson(QJsonDocument::Compact));
+}
+
+void Test_SoundModel::update(const QString &cards)
+{
+    m_model->updatePorts(cards, [this](uint cardId, const QString &portId) {
+        return m_activePort == qMakePair(cardId, portId);
+    });
+}
+
+TEST_F(Test_SoundModel, addPorts)
+{
+    // 不可用的端口不添加，不同声卡上的同名端口是两个端口
+    update(cards({ card(1, { port("speaker", Port::Out), port("mic", Port::In), port("hdmi", Port::Out, QString(), 1.0) }),
+                   card(2, { port("speaker", Port::Out) }) }));
+
+    EXPECT_EQ(m_added, 3);
+    ASSERT_EQ(m_model->ports().size(), 3);
+    ASSERT_NE(m_model->findPort("speaker", 1), nullptr);
+    ASSERT_NE(m_model->findPort("speaker", 2), nullptr);
+    EXPECT_EQ(m_model->findPort("hdmi", 1), nullptr);
+    EXPECT_EQ(m_model->findPort("mic", 1)->direction(), Port::In);
+    EXPECT_EQ(m_model->findPort("speaker", 2)->cardName(), QString("card2"));
+}
+
+TEST_F(Test_SoundModel, onlyChangedPortsEmit)
+{
+    update(cards({ card(1, { port("speaker", Port::Out), port("headphone", Port::Out) }) }));
+    Port *speaker = m_model->findPort("speaker", 1);
+    Port *headphone = m_model->findPort("headphone", 1);
+    ASSERT_NE(speaker, nullptr);
+    ASSERT_NE(headphone, nullptr);
+
+    m_added = 0;
+    QSignalSpy speakerSpy(speaker, &Port::nameChanged);
+    QSignalSpy headphoneSpy(headphone, &Port::nameChanged);
+
+    // 只修改了一个端口的描述，已有端口对象保留，其他端口不发信号
+    update(cards({ card(1, { port("speaker", Port::Out, "Speaker"), port("headphone", Port::Out) }) }));
+
+    EXPECT_EQ(m_added, 0);
+    EXPECT_EQ(m_removed, 0);
+    EXPECT_EQ(speakerSpy.count(), 1);
+    EXPECT_EQ(headphoneSpy.count(), 0);
+    EXPECT_EQ(m_model->findPort("speaker", 1), speaker);
+    EXPECT_EQ(speaker->name(), QString("Speaker"));
+}
+
+TEST_F(Test_SoundModel, removePorts)
+{
+    update(cards({ card(1, { port("speaker", Port::Out), port("headphone", Port::Out) }),
+                   card(2, { port("mic", Port::In) }) }));
+
+    m_added = 0;
+
+    // 拔掉耳机且第二个声卡消失
+    update(cards({ card(1, { port("speaker", Port::Out), port("headphone", Port::Out, QString(), 1.0) }) }));
+
+    EXPECT_EQ(m_added, 0);
+    ASSERT_EQ(m_removed, 2);
+    EXPECT_EQ(m_model->ports().size(), 1);
+    EXPECT_EQ(m_model->findPort("headphone", 1), nullptr);
+    EXPECT_EQ(m_model->findPort("mic", 2), nullptr);
+}
+
+TEST_F(Test_SoundModel, directionChangeReaddsPort)
+{
+    update(cards({ card(1, { port("jack", Port::Out) }) }));
+
+    m_added = 0;
+
+    // 端口换到另一个方向的列表中
+    update(cards({ card(1, { port("jack", Port::In) }) }));
+
+    EXPECT_EQ(m_removed, 1);
+    EXPECT_EQ(m_added, 1);
+    ASSERT_NE(m_model->findPort("jack", 1), nullptr);
+    EXPECT_EQ(m_model->findPort("jack", 1)->direction(), Port::In);
+}
+
+TEST_F(Test_SoundModel, activePort)
+{
+    m_activePort = qMakePair(1u, QString("headphone"));
+    update(cards({ card(1, { port("speaker", Port::Out), port("headphone", Port::Out) }) }));
+
+    EXPECT_FALSE(m_model->findPort("speaker", 1)->isActive());
+    EXPECT_TRUE(m_model->findPort("headphone", 1)->isActive());
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/update/mirrorspeedprober.h"
+
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTest>
+#include <gtest/gtest.h>
+
+using namespace dcc::update;
+
+class Test_MirrorSpeedProber: public testing::Test
+{
+public:
+    virtual void SetUp() override;
+
+    virtual void TearDown() override;
+
+    QUrl serverUrl() const;
+
+public:
+    MirrorSpeedProber *m_prober = nullptr;
+    QTcpServer *m_server = nullptr;
+};
+
+void Test_MirrorSpeedProber::SetUp()
+{
+    m_prober = new MirrorSpeedProber();
+    m_server = new QTcpServer();
+    ASSERT_TRUE(m_server->listen(QHostAddress::LocalHost));
+}
+
+void Test_MirrorSpeedProber::TearDown()
+{
+    delete m_prober;
+    m_prober = nullptr;
+    delete m_server;
+    m_server = nullptr;
+}
+
+QUrl Test_MirrorSpeedProber::serverUrl() const
+{
+    return QUrl(QString("http://127.0.0.1:%1/deepin/").arg(m_server->serverPort()));
+}
+
+TEST_F(Test_MirrorSpeedProber, reachable)
+{
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+    QSignalSpy finishedSpy(m_prober, &MirrorSpeedProber::finished);
+
+    m_prober->start({ qMakePair(QString("local"), serverUrl()) });
+    EXPECT_TRUE(finishedSpy.wait(3000));
+
+    ASSERT_EQ(resultSpy.count(), 1);
+    EXPECT_EQ(resultSpy.at(0).at(0).toString(), "local");
+    EXPECT_GT(resultSpy.at(0).at(1).toInt(), 0);
+    EXPECT_LT(resultSpy.at(0).at(1).toInt(), MirrorSpeedProber::TimeoutValue);
+}
+
+TEST_F(Test_MirrorSpeedProber, refused)
+{
+    const QUrl url = serverUrl();
+    m_server->close();
+
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+    QSignalSpy finishedSpy(m_prober, &MirrorSpeedProber::finished);
+
+    m_prober->start({ qMakePair(QString("closed"), url) });
+    EXPECT_TRUE(finishedSpy.wait(3000));
+
+    ASSERT_EQ(resultSpy.count(), 1);
+    EXPECT_EQ(resultSpy.at(0).at(1).toInt(), MirrorSpeedProber::TimeoutValue);
+}
+
+TEST_F(Test_MirrorSpeedProber, failureNotCached)
+{
+    const QUrl url = serverUrl();
+    const quint16 port = m_server->serverPort();
+    m_server->close();
+
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+    QSignalSpy finishedSpy(m_prober, &MirrorSpeedProber::finished);
+
+    m_prober->start({ qMakePair(QString("local"), url) });
+    EXPECT_TRUE(finishedSpy.wait(3000));
+    ASSERT_EQ(resultSpy.count(), 1);
+    EXPECT_EQ(resultSpy.at(0).at(1).toInt(), MirrorSpeedProber::TimeoutValue);
+
+    // 镜像恢复后重试，需要重新测速而不是返回缓存的失败结果
+    ASSERT_TRUE(m_server->listen(QHostAddress::LocalHost, port));
+    m_prober->start({ qMakePair(QString("local"), url) });
+    EXPECT_TRUE(m_prober->isRunning());
+    EXPECT_TRUE(finishedSpy.wait(3000));
+
+    ASSERT_EQ(resultSpy.count(), 2);
+    EXPECT_LT(resultSpy.at(1).at(1).toInt(), MirrorSpeedProber::TimeoutValue);
+}
+
+TEST_F(Test_MirrorSpeedProber, parallel)
+{
+    QList<QPair<QString, QUrl>> mirrors;
+    for (int i = 0; i < 10; ++i)
+        mirrors << qMakePair(QString::number(i), serverUrl());
+
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+    QSignalSpy finishedSpy(m_prober, &MirrorSpeedProber::finished);
+
+    m_prober->setMaxParallel(2);
+    m_prober->clearCache();
+    m_prober->start(mirrors);
+    EXPECT_TRUE(finishedSpy.wait(5000));
+
+    EXPECT_EQ(resultSpy.count(), mirrors.size());
+    EXPECT_FALSE(m_prober->isRunning());
+}
+
+TEST_F(Test_MirrorSpeedProber, cache)
+{
+    QSignalSpy finishedSpy(m_prober, &MirrorSpeedProber::finished);
+    m_prober->start({ qMakePair(QString("local"), serverUrl()) });
+    EXPECT_TRUE(finishedSpy.wait(3000));
+
+    // 缓存有效期内同一地址直接返回结果，不需要等待事件循环
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+    m_prober->start({ qMakePair(QString("cached"), serverUrl()) });
+    ASSERT_EQ(resultSpy.count(), 1);
+    EXPECT_EQ(resultSpy.at(0).at(0).toString(), "cached");
+    EXPECT_FALSE(m_prober->isRunning());
+}
+
+TEST_F(Test_MirrorSpeedProber, cancel)
+{
+    QSignalSpy resultSpy(m_prober, &MirrorSpeedProber::resultReady);
+
+    m_prober->start({ qMakePair(QString("local"), serverUrl()) });
+    EXPECT_TRUE(m_prober->isRunning());
+    m_prober->cancel();
+    EXPECT_FALSE(m_prober->isRunning());
+
+    QTest::qWait(200);
+    EXPECT_EQ(resultSpy.count(), 0);
+}
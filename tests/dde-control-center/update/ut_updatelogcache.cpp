@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/update/updatelogcache.h"
+
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSharedPointer>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <gtest/gtest.h>
+
+using namespace dcc::update;
+
+const QString RequestKey = "http://127.0.0.1/api/v1/systemupdatelogs{\"platformType\":1}";
+
+class Test_UpdateLogCache: public testing::Test
+{
+public:
+    virtual void SetUp() override;
+
+    virtual void TearDown() override;
+
+    // 按 UpdateWorker 的流程发送一次请求并处理返回，返回服务器的状态码
+    int request(UpdateLogCache &cache, const QString &requestKey = RequestKey);
+
+    static QByteArray header(const QByteArray &request, const QByteArray &name);
+    static QByteArray logsBody(int count);
+    static QByteArray okResponse(const QByteArray &etag, const QByteArray &body);
+
+public:
+    QTcpServer *m_server = nullptr;
+    QNetworkAccessManager *m_http = nullptr;
+    QByteArray m_request;       // 服务器收到的最后一次请求
+    QByteArray m_response;      // 服务器下一次返回的内容
+};
+
+void Test_UpdateLogCache::SetUp()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/update/update-log.cache");
+
+    m_http = new QNetworkAccessManager();
+    m_server = new QTcpServer();
+    ASSERT_TRUE(m_server->listen(QHostAddress::LocalHost));
+
+    QObject::connect(m_server, &QTcpServer::newConnection, m_server, [this] {
+        QTcpSocket *socket = m_server->nextPendingConnection();
+        QSharedPointer<QByteArray> data(new QByteArray);
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, data] {
+            data->append(socket->readAll());
+            const int headerEnd = data->indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+                return;
+
+            // 读完请求体后再返回
+            const int length = header(*data, "Content-Length").toInt();
+            if (data->size() < headerEnd + 4 + length)
+                return;
+
+            m_request = *data;
+            socket->write(m_response);
+            socket->disconnectFromHost();
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+    });
+}
+
+void Test_UpdateLogCache::TearDown()
+{
+    delete m_server;
+    m_server = nullptr;
+    delete m_http;
+    m_http = nullptr;
+}
+
+int Test_UpdateLogCache::request(UpdateLogCache &cache, const QString &requestKey)
+{
+    QNetworkRequest request(QUrl(QString("http://127.0.0.1:%1/api/v1/systemupdatelogs").arg(m_server->serverPort())));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    cache.load();
+    cache.prepareRequest(request, requestKey);
+
+    QNetworkReply *reply = m_http->post(request, QByteArray("{\"platformType\":1}"));
+    QSignalSpy finishedSpy(reply, &QNetworkReply::finished);
+    EXPECT_TRUE(finishedSpy.wait(3000));
+    reply->deleteLater();
+
+    EXPECT_EQ(reply->error(), QNetworkReply::NoError);
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (UpdateLogCache::isNotModified(reply))
+        return status;
+
+    QList<UpdateLogItem> logs;
+    EXPECT_TRUE(UpdateLogCache::parseLogs(reply->readAll(), logs));
+    cache.setLogs(requestKey, reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"), logs);
+    EXPECT_TRUE(cache.save());
+
+    return status;
+}
+
+QByteArray Test_UpdateLogCache::header(const QByteArray &request, const QByteArray &name)
+{
+    for (const QByteArray &line : request.left(request.indexOf("\r\n\r\n")).split('\n')) {
+        const int colon = line.indexOf(':');
+        if (colon > 0 && line.left(colon).trimmed().toLower() == name.toLower())
+            return line.mid(colon + 1).trimmed();
+    }
+
+    return QByteArray();
+}
+
+QByteArray Test_UpdateLogCache::logsBody(int count)
+{
+    QByteArray data;
+    for (int i = 1; i <= count; ++i) {
+        if (!data.isEmpty())
+            data += ',';
+        data += QString("{\"id\":%1,\"platformType\":1,\"serverType\":0,\"logType\":1,\"systemVersion\":\"10%2\","
+                        "\"cnLog\":\"cn\",\"enLog\":\"en\",\"publishTime\":\"2022-08-06T00:00:00+08:00\"}")
+                .arg(i).arg(60 + i * 10).toUtf8();
+    }
+
+    return "{\"code\":0,\"data\":[" + data + "]}";
+}
+
+QByteArray Test_UpdateLogCache::okResponse(const QByteArray &etag, const QByteArray &body)
+{
+    return "HTTP/1.1 200 OK\r\n"
+           "Content-Type: application/json\r\n"
+           "ETag: " + etag + "\r\n"
+           "Last-Modified: Sat, 06 Aug 2022 00:00:00 GMT\r\n"
+           "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+           "Connection: close\r\n\r\n" + body;
+}
+
+TEST_F(Test_UpdateLogCache, firstRequestIsUnconditional)
+{
+    UpdateLogCache cache;
+    m_response = okResponse("\"v1\"", logsBody(2));
+
+    EXPECT_EQ(request(cache), 200);
+    EXPECT_TRUE(header(m_request, "If-None-Match").isEmpty());
+    EXPECT_TRUE(header(m_request, "If-Modified-Since").isEmpty());
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.logs(1).size(), 2);
+}
+
+TEST_F(Test_UpdateLogCache, notModifiedServedFromCache)
+{
+    {
+        UpdateLogCache cache;
+        m_response = okResponse("\"v1\"", logsBody(2));
+        ASSERT_EQ(request(cache), 200);
+    }
+
+    // 新的实例从缓存文件中读取日志和 ETag
+    UpdateLogCache cache;
+    m_response = "HTTP/1.1 304 Not Modified\r\nETag: \"v1\"\r\nConnection: close\r\n\r\n";
+
+    EXPECT_EQ(request(cache), 304);
+    EXPECT_EQ(header(m_request, "If-None-Match"), QByteArray("\"v1\""));
+    EXPECT_EQ(header(m_request, "If-Modified-Since"), QByteArray("Sat, 06 Aug 2022 00:00:00 GMT"));
+    ASSERT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.logs(1, "1072").size(), 1);
+}
+
+TEST_F(Test_UpdateLogCache, modifiedRewritesETag)
+{
+    UpdateLogCache cache;
+    m_response = okResponse("\"v1\"", logsBody(1));
+    ASSERT_EQ(request(cache), 200);
+
+    // 日志有变化，服务器返回新的 ETag，缓存和下一次请求都使用新的值
+    m_response = okResponse("\"v2\"", logsBody(3));
+    EXPECT_EQ(request(cache), 200);
+    EXPECT_EQ(header(m_request, "If-None-Match"), QByteArray("\"v1\""));
+    EXPECT_EQ(cache.size(), 3);
+
+    UpdateLogCache reloaded;
+    m_response = "HTTP/1.1 304 Not Modified\r\nConnection: close\r\n\r\n";
+    EXPECT_EQ(request(reloaded), 304);
+    EXPECT_EQ(header(m_request, "If-None-Match"), QByteArray("\"v2\""));
+    EXPECT_EQ(reloaded.size(), 3);
+}
+
+TEST_F(Test_UpdateLogCache, requestKeyChangeIsUnconditional)
+{
+    UpdateLogCache cache;
+    m_response = okResponse("\"v1\"", logsBody(1));
+    ASSERT_EQ(request(cache), 200);
+
+    // 请求参数变化后缓存的日志不可用，不能带条件请求
+    m_response = okResponse("\"v2\"", logsBody(2));
+    EXPECT_EQ(request(cache, RequestKey + "unstable"), 200);
+    EXPECT_TRUE(header(m_request, "If-None-Match").isEmpty());
+    EXPECT_EQ(cache.size(), 2);
+}
@@ -26,6 +26,10 @@ lcov --directory ./CMakeFiles/datetime-unittest.dir --zerocounters
 #lcov --directory ./CMakeFiles/defapp-unittest.dir --zerocounters
 lcov --directory ./CMakeFiles/systeminfo-unittest.dir --zerocounters
 lcov --directory ./CMakeFiles/keyboard-unittest.dir --zerocounters
+lcov --directory ./CMakeFiles/update-unittest.dir --zerocounters
+lcov --directory ./CMakeFiles/display-unittest.dir --zerocounters
+lcov --directory ./CMakeFiles/accounts-unittest.dir --zerocounters
+lcov --directory ./CMakeFiles/sound-unittest.dir --zerocounters
 lcov --directory ../dccwidgets/CMakeFiles/dccwidgets-unittest.dir --zerocounters
 echo " =================== Start Unit  ==================== "
 #./bluetooth-unittest --gtest_output=xml:dde_test.xml
@@ -35,6 +39,10 @@ echo " =================== Start Unit  ==================== "
 #./defapp-unittest --gtest_output=xml:dde_test_report_defapp.xml
 #./notification-unittest --gtest_output=xml:dde_test_report_notification.xml
 ./keyboard-unittest --gtest_output=xml:../../report/ut-report_keyboard.xml
+./update-unittest --gtest_output=xml:../../report/ut-report_update.xml
+./display-unittest --gtest_output=xml:../../report/ut-report_display.xml
+./accounts-unittest --gtest_output=xml:../../report/ut-report_accounts.xml
+./sound-unittest --gtest_output=xml:../../report/ut-report_sound.xml
 echo " =================== do filter begin ==================== "
 lcov --directory . --capture --output-file ./coverage.info
 echo " =================== get info end ==================== "
@@ -54,6 +62,10 @@ mv asan_systeminfo.log* ../../asan_systeminfo.log
 mv asan_datetime.log* ../../asan_datetime.log
 #mv asan_notification.log* asan_notification.log
 mv asan_keyboard.log* ../../asan_keyboard.log
+mv asan_update.log* ../../asan_update.log
+mv asan_display.log* ../../asan_display.log
+mv asan_accounts.log* ../../asan_accounts.log
+mv asan_sound.log* ../../asan_sound.log
 
 
 mv ../../html/index.html ../../html/cov_dde-control-center.html
\ No newline at end of file